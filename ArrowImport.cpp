@@ -0,0 +1,329 @@
+#include "ArrowImport.h"
+#include "Logger.h"
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+namespace {
+    // 支持的 Arrow 物理类型
+    enum class ArrowType {
+        Unsupported,
+        Bool,
+        Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64,
+        Float32, Float64
+    };
+
+    ArrowType parseFormat(const char* format) {
+        if (!format || !format[0]) return ArrowType::Unsupported;
+        if (format[1] == '\0') {
+            switch (format[0]) {
+            case 'b': return ArrowType::Bool;
+            case 'c': return ArrowType::Int8;
+            case 'C': return ArrowType::UInt8;
+            case 's': return ArrowType::Int16;
+            case 'S': return ArrowType::UInt16;
+            case 'i': return ArrowType::Int32;
+            case 'I': return ArrowType::UInt32;
+            case 'l': return ArrowType::Int64;
+            case 'L': return ArrowType::UInt64;
+            case 'f': return ArrowType::Float32;
+            case 'g': return ArrowType::Float64;
+            default: return ArrowType::Unsupported;
+            }
+        }
+        // 时间类型按其存储的整数处理：date32/time32 为 int32，其余为 int64
+        if (std::strcmp(format, "tdD") == 0 || std::strcmp(format, "tts") == 0 || std::strcmp(format, "ttm") == 0) {
+            return ArrowType::Int32;
+        }
+        if (std::strcmp(format, "tdm") == 0 || std::strcmp(format, "ttu") == 0 || std::strcmp(format, "ttn") == 0) {
+            return ArrowType::Int64;
+        }
+        const bool unit = format[2] != '\0' && std::strchr("smun", format[2]) != nullptr;
+        if (format[0] == 't' && format[1] == 'D' && unit && format[3] == '\0') return ArrowType::Int64;  // duration
+        if (format[0] == 't' && format[1] == 's' && unit && format[3] == ':') return ArrowType::Int64;   // timestamp
+        return ArrowType::Unsupported;
+    }
+
+    template<typename T> ArrowType nativeType();
+    template<> ArrowType nativeType<int>() { return sizeof(int) == 4 ? ArrowType::Int32 : ArrowType::Unsupported; }
+    template<> ArrowType nativeType<long long>() { return sizeof(long long) == 8 ? ArrowType::Int64 : ArrowType::Unsupported; }
+    template<> ArrowType nativeType<double>() { return ArrowType::Float64; }
+    template<> ArrowType nativeType<bool>() { return ArrowType::Unsupported; }  // 布尔列是位图，总要展开
+
+    bool bitSet(const std::uint8_t* bitmap, std::int64_t i) {
+        return (bitmap[i >> 3] >> (i & 7)) & 1;
+    }
+
+    // 结构体数组中的一列；index 为批次内的行号，已叠加父数组与子数组的偏移
+    struct Column {
+        const ArrowArray* array = nullptr;
+        ArrowType type = ArrowType::Unsupported;
+        std::int64_t offset = 0;
+
+        const std::uint8_t* validity() const {
+            return array->null_count != 0 ? static_cast<const std::uint8_t*>(array->buffers[0]) : nullptr;
+        }
+        bool hasNulls() const { return validity() != nullptr; }
+        bool isValid(std::int64_t i) const {
+            const std::uint8_t* bitmap = validity();
+            return !bitmap || bitSet(bitmap, offset + i);
+        }
+        const void* values() const { return array->buffers[1]; }
+
+        template<typename S>
+        S raw(std::int64_t i) const { return static_cast<const S*>(values())[offset + i]; }
+
+        bool isFloat() const { return type == ArrowType::Float32 || type == ArrowType::Float64; }
+
+        long long asInteger(std::int64_t i) const {
+            switch (type) {
+            case ArrowType::Bool: return bitSet(static_cast<const std::uint8_t*>(values()), offset + i) ? 1 : 0;
+            case ArrowType::Int8: return raw<std::int8_t>(i);
+            case ArrowType::UInt8: return raw<std::uint8_t>(i);
+            case ArrowType::Int16: return raw<std::int16_t>(i);
+            case ArrowType::UInt16: return raw<std::uint16_t>(i);
+            case ArrowType::Int32: return raw<std::int32_t>(i);
+            case ArrowType::UInt32: return raw<std::uint32_t>(i);
+            case ArrowType::Int64: return raw<std::int64_t>(i);
+            case ArrowType::UInt64: {
+                std::uint64_t value = raw<std::uint64_t>(i);
+                return value > static_cast<std::uint64_t>(LLONG_MAX) ? LLONG_MAX : static_cast<long long>(value);
+            }
+            default: return 0;
+            }
+        }
+
+        double asDouble(std::int64_t i) const {
+            if (type == ArrowType::Float32) return raw<float>(i);
+            if (type == ArrowType::Float64) return raw<double>(i);
+            return static_cast<double>(asInteger(i));
+        }
+    };
+
+    // 转换为目标类型，超出范围的值截断并计数
+    template<typename T>
+    T convertValue(const Column& column, std::int64_t i, size_t& clamped) {
+        if (std::is_same<T, double>::value) {
+            return static_cast<T>(column.asDouble(i));
+        }
+        if (std::is_same<T, bool>::value) {
+            return static_cast<T>(column.isFloat() ? column.asDouble(i) != 0.0 : column.asInteger(i) != 0);
+        }
+
+        const long long lo = std::is_same<T, int>::value ? INT_MIN : LLONG_MIN;
+        const long long hi = std::is_same<T, int>::value ? INT_MAX : LLONG_MAX;
+        if (column.isFloat()) {
+            double value = column.asDouble(i);
+            if (!std::isfinite(value) || value < static_cast<double>(lo) || value >= static_cast<double>(hi)) {
+                ++clamped;
+                return static_cast<T>(std::isnan(value) ? 0 : (value < 0 ? lo : hi));
+            }
+            return static_cast<T>(value);
+        }
+        long long value = column.asInteger(i);
+        if (value < lo || value > hi) {
+            ++clamped;
+            return static_cast<T>(value < lo ? lo : hi);
+        }
+        return static_cast<T>(value);
+    }
+
+    // 类型一致、无需筛选且无空值的列可以直接引用 Arrow 缓冲区
+    template<typename T>
+    bool canBorrow(const Column& column, const std::vector<std::int64_t>* selection) {
+        return column.array && !selection && !column.hasNulls() && column.type == nativeType<T>();
+    }
+
+    // 取得一列的连续数据：可借用时返回 Arrow 缓冲区，否则转换到 storage（空值读作0）
+    template<typename T>
+    const T* columnData(const Column& column, size_t count, const std::vector<std::int64_t>* selection,
+        T* storage, bool& zeroCopy, size_t& clamped) {
+        if (!column.array) return nullptr;
+
+        zeroCopy = canBorrow<T>(column, selection);
+        if (zeroCopy) {
+            return static_cast<const T*>(column.values()) + column.offset;
+        }
+
+        for (size_t k = 0; k < count; ++k) {
+            const std::int64_t row = selection ? (*selection)[k] : static_cast<std::int64_t>(k);
+            storage[k] = column.isValid(row) ? convertValue<T>(column, row, clamped) : T();
+        }
+        return storage;
+    }
+
+    void releaseArray(ArrowArray& array) {
+        if (array.release) {
+            array.release(&array);
+            array.release = nullptr;
+        }
+    }
+
+    void releaseSchema(ArrowSchema& schema) {
+        if (schema.release) {
+            schema.release(&schema);
+            schema.release = nullptr;
+        }
+    }
+}
+
+template<typename TimeT>
+BasicArrowOperationSource<TimeT>::~BasicArrowOperationSource() {
+    reset();
+}
+
+template<typename TimeT>
+void BasicArrowOperationSource<TimeT>::reset() {
+    operationView.clear();
+    releaseArray(batch);
+    zeroCopyColumns = 0;
+    std::vector<int>().swap(jobIds);
+    std::vector<int>().swap(stages);
+    std::vector<int>().swap(machineIds);
+    std::vector<TimeT>().swap(startTimes);
+    std::vector<TimeT>().swap(endTimes);
+    criticalFlags.reset();
+}
+
+template<typename TimeT>
+bool BasicArrowOperationSource<TimeT>::import(ArrowArray* array, ArrowSchema* schema, const ArrowColumnNames& names) {
+    reset();
+
+    // 按 C 数据接口约定"移动"结构体：复制后将来源标记为已释放
+    ArrowArray input{};
+    ArrowSchema inputSchema{};
+    if (array) {
+        input = *array;
+        array->release = nullptr;
+    }
+    if (schema) {
+        inputSchema = *schema;
+        schema->release = nullptr;
+    }
+
+    auto fail = [&](const std::string& message) {
+        GANTT_LOG(LogLevel::Error, "Arrow import failed: " << message);
+        releaseArray(input);
+        releaseSchema(inputSchema);
+        return false;
+    };
+
+    if (!input.release || !inputSchema.release) {
+        return fail("array or schema is null or already released");
+    }
+    if (!inputSchema.format || std::strcmp(inputSchema.format, "+s") != 0) {
+        return fail("expected a struct array (record batch), got format '"
+            + std::string(inputSchema.format ? inputSchema.format : "") + "'");
+    }
+    if (inputSchema.n_children != input.n_children) {
+        return fail("schema and array have different numbers of children");
+    }
+    if (input.length < 0) {
+        return fail("negative length");
+    }
+
+    // === 按名称查找列 ===
+    const std::string* wanted[6] = {
+        &names.jobId, &names.stage, &names.machineId, &names.startTime, &names.endTime, &names.isCritical };
+    const bool required[6] = { true, false, true, true, true, false };
+    Column columns[6];
+
+    for (int c = 0; c < 6; ++c) {
+        for (std::int64_t i = 0; i < inputSchema.n_children; ++i) {
+            const ArrowSchema* field = inputSchema.children[i];
+            if (!field->name || *wanted[c] != field->name) continue;
+
+            const ArrowArray* child = input.children[i];
+            const ArrowType type = parseFormat(field->format);
+            if (type == ArrowType::Unsupported || field->dictionary || child->n_buffers < 2) {
+                return fail("column '" + *wanted[c] + "' has unsupported type '"
+                    + std::string(field->format ? field->format : "") + "'");
+            }
+            if (child->length < input.offset + input.length) {
+                return fail("column '" + *wanted[c] + "' is shorter than the batch");
+            }
+            columns[c].array = child;
+            columns[c].type = type;
+            columns[c].offset = child->offset + input.offset;
+            break;
+        }
+        if (required[c] && !columns[c].array) {
+            return fail("missing required column '" + *wanted[c] + "'");
+        }
+    }
+
+    // === 空值：结构体本身或必需列为空的行被跳过 ===
+    const std::uint8_t* rowValidity = input.null_count != 0 && input.n_buffers > 0
+        ? static_cast<const std::uint8_t*>(input.buffers[0]) : nullptr;
+    bool needsSelection = rowValidity != nullptr;
+    for (int c = 0; c < 6; ++c) {
+        needsSelection = needsSelection || (required[c] && columns[c].hasNulls());
+    }
+
+    std::vector<std::int64_t> selection;
+    if (needsSelection) {
+        selection.reserve(static_cast<size_t>(input.length));
+        for (std::int64_t row = 0; row < input.length; ++row) {
+            bool valid = !rowValidity || bitSet(rowValidity, input.offset + row);
+            for (int c = 0; c < 6 && valid; ++c) {
+                valid = !required[c] || columns[c].isValid(row);
+            }
+            if (valid) {
+                selection.push_back(row);
+            }
+        }
+    }
+    const std::vector<std::int64_t>* rows = needsSelection ? &selection : nullptr;
+    const std::int64_t totalRows = input.length;
+    const size_t count = needsSelection ? selection.size() : static_cast<size_t>(totalRows);
+
+    // === 逐列取得数据：零拷贝或转换一次 ===
+    if (columns[0].array && !canBorrow<int>(columns[0], rows)) jobIds.resize(count);
+    if (columns[1].array && !canBorrow<int>(columns[1], rows)) stages.resize(count);
+    if (columns[2].array && !canBorrow<int>(columns[2], rows)) machineIds.resize(count);
+    if (columns[3].array && !canBorrow<TimeT>(columns[3], rows)) startTimes.resize(count);
+    if (columns[4].array && !canBorrow<TimeT>(columns[4], rows)) endTimes.resize(count);
+    if (columns[5].array) {
+        criticalFlags.reset(new bool[count > 0 ? count : 1]);
+    }
+
+    size_t clamped = 0;
+    bool zeroCopy[6] = {};
+    const int* jobData = columnData(columns[0], count, rows, jobIds.data(), zeroCopy[0], clamped);
+    const int* stageData = columnData(columns[1], count, rows, stages.data(), zeroCopy[1], clamped);
+    const int* machineData = columnData(columns[2], count, rows, machineIds.data(), zeroCopy[2], clamped);
+    const TimeT* startData = columnData(columns[3], count, rows, startTimes.data(), zeroCopy[3], clamped);
+    const TimeT* endData = columnData(columns[4], count, rows, endTimes.data(), zeroCopy[4], clamped);
+    const bool* criticalData = columnData(columns[5], count, rows, criticalFlags.get(), zeroCopy[5], clamped);
+
+    releaseSchema(inputSchema);
+
+    zeroCopyColumns = 0;
+    for (bool z : zeroCopy) {
+        zeroCopyColumns += z ? 1 : 0;
+    }
+    if (zeroCopyColumns > 0) {
+        batch = input;  // 持有缓冲区直到 reset
+    }
+    else {
+        releaseArray(input);
+    }
+
+    operationView = View::fromArrays(count, jobData, stageData, machineData, startData, endData, criticalData);
+
+    if (clamped > 0) {
+        GANTT_LOG(LogLevel::Warning, "Arrow import: " << clamped << " values out of range were clamped");
+    }
+    if (count != static_cast<size_t>(totalRows)) {
+        GANTT_LOG(LogLevel::Warning, "Arrow import: skipped " << (totalRows - static_cast<std::int64_t>(count))
+            << " rows with null required fields");
+    }
+    GANTT_LOG(LogLevel::Info, "Arrow import: " << count << " rows, "
+        << zeroCopyColumns << "/6 columns zero-copy");
+    return true;
+}
+
+template class BasicArrowOperationSource<int>;
+template class BasicArrowOperationSource<long long>;
+template class BasicArrowOperationSource<double>;
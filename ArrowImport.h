@@ -0,0 +1,111 @@
+//
+// 通过 Arrow C 数据接口导入调度数据（不依赖 Arrow 库）
+// 类型一致的列直接引用 Arrow 缓冲区，其余列（布尔位图、宽度不同的整数、含空值的列）转换一次
+//
+#ifndef ARROW_IMPORT_H
+#define ARROW_IMPORT_H
+
+#include "OperationView.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Arrow C 数据接口的 ABI 定义，与 arrow/c/abi.h 相同，已包含该头文件时跳过
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+    void (*release)(struct ArrowSchema*);
+    void* private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+    void (*release)(struct ArrowArray*);
+    void* private_data;
+};
+
+#endif // ARROW_C_DATA_INTERFACE
+
+// 列名映射，默认与 qm::Operation 的字段名一致；stage 与 is_critical 列可以缺失
+struct ArrowColumnNames {
+    std::string jobId = "job_id";
+    std::string stage = "stage";
+    std::string machineId = "machine_id";
+    std::string startTime = "start_time";
+    std::string endTime = "end_time";
+    std::string isCritical = "is_critical";
+};
+
+/**
+ * @brief 一个已导入的 Arrow 记录批次（struct 数组），持有 Arrow 内存直到析构或 reset
+ *
+ * 支持的列类型：整数（int8~int64 及无符号）、float/double、timestamp/date/time/duration、bool。
+ * 与目标类型完全一致的列（ID 为 int32、时间为 TimeT 对应的 int32/int64/double）零拷贝；
+ * 必需列中出现空值的行被跳过，此时所有列转换为内部存储。
+ */
+template<typename TimeT>
+class BasicArrowOperationSource {
+public:
+    using View = qm::OperationView<TimeT>;
+
+    BasicArrowOperationSource() = default;
+    ~BasicArrowOperationSource();
+    BasicArrowOperationSource(const BasicArrowOperationSource&) = delete;
+    BasicArrowOperationSource& operator=(const BasicArrowOperationSource&) = delete;
+
+    /**
+     * @brief 导入记录批次
+     * @param array, schema 调用后两者的所有权均转移给本对象（无论成功与否），其 release 被置空
+     * @return 成功返回true；失败时记录错误并保持为空
+     */
+    bool import(ArrowArray* array, ArrowSchema* schema, const ArrowColumnNames& names = ArrowColumnNames());
+
+    // 释放 Arrow 内存与转换缓冲区
+    void reset();
+
+    const View& view() const { return operationView; }
+    size_t size() const { return operationView.size(); }
+
+    // 零拷贝引用的列数（0~6），用于诊断
+    int getZeroCopyColumnCount() const { return zeroCopyColumns; }
+
+private:
+    ArrowArray batch{};
+    View operationView;
+    int zeroCopyColumns = 0;
+
+    // 转换后的列
+    std::vector<int> jobIds, stages, machineIds;
+    std::vector<TimeT> startTimes, endTimes;
+    std::unique_ptr<bool[]> criticalFlags;
+};
+
+using ArrowOperationSource = BasicArrowOperationSource<int>;
+using ArrowOperationSource64 = BasicArrowOperationSource<long long>;
+using ArrowOperationSourceF = BasicArrowOperationSource<double>;
+
+extern template class BasicArrowOperationSource<int>;
+extern template class BasicArrowOperationSource<long long>;
+extern template class BasicArrowOperationSource<double>;
+
+#endif // ARROW_IMPORT_H
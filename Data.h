@@ -7,40 +7,55 @@
 #include <vector>
 
 namespace qm {
-    struct Operation {
+    // 操作记录，按时间类型模板化
+    // int 为默认的紧凑32位布局，适合内存受限的大规模调度；
+    // long long 用于毫秒时间戳等长时间跨度，double 用于浮点时间的求解器
+    template<typename TimeT>
+    struct BasicOperation {
+        using TimeType = TimeT;
+
         int job_id;
         int stage;
         int machine_id;
-        int start_time;
-        int end_time;
+        TimeT start_time;
+        TimeT end_time;
         bool is_critical;
 
-        Operation() = default;
+        BasicOperation() = default;
 
-        // 򵥵ģ幹캯ʱ
+        // 简单的模板构造函数，运行时检查
         template<typename T>
-        explicit Operation(const T& t)
+        explicit BasicOperation(const T& t)
             : job_id(static_cast<int>(t.job_id)),
             stage(static_cast<int>(t.stage)),
             machine_id(static_cast<int>(t.machine_id)),
-            start_time(static_cast<int>(t.start_time)),
-            end_time(static_cast<int>(t.end_time)),
+            start_time(static_cast<TimeT>(t.start_time)),
+            end_time(static_cast<TimeT>(t.end_time)),
             is_critical(static_cast<bool>(t.is_critical)) {
         }
     };
 
-    struct Data {
-        std::vector<Operation> data;
+    template<typename TimeT>
+    struct BasicData {
+        std::vector<BasicOperation<TimeT>> data;
 
-        // 򵥵ģ幹캯
+        // 简单的模板构造函数
         template<typename Container>
-        explicit Data(const Container& c) {
+        explicit BasicData(const Container& c) {
             data.reserve(c.size());
             for (const auto& item : c) {
-                data.emplace_back(Operation(item));
+                data.emplace_back(BasicOperation<TimeT>(item));
             }
         }
     };
+
+    using Operation = BasicOperation<int>;
+    using Operation64 = BasicOperation<long long>;
+    using OperationF = BasicOperation<double>;
+
+    using Data = BasicData<int>;
+    using Data64 = BasicData<long long>;
+    using DataF = BasicData<double>;
 }
 
 #endif //FJSP_GANTT_DATA_H
\ No newline at end of file
@@ -0,0 +1,287 @@
+#include "FrameProfiler.h"
+#include "Logger.h"
+#include <algorithm>
+#include <atomic>
+
+namespace {
+    // 为每个线程分配一个稳定的小整数ID，作为 trace 中的 tid
+    unsigned currentThreadId() {
+        static std::atomic<unsigned> nextId{ 1 };
+        thread_local unsigned id = nextId.fetch_add(1);
+        return id;
+    }
+
+    double percentileOf(std::vector<float>& values, size_t count, double p) {
+        size_t rank = static_cast<size_t>(p * (count - 1) + 0.5);
+        std::nth_element(values.begin(), values.begin() + rank, values.begin() + count);
+        return values[rank];
+    }
+}
+
+// === Scope ===
+
+FrameProfiler::Scope::Scope(FrameProfiler& p, FramePhase ph)
+    : profiler(p), phase(ph), active(p.isEnabled()) {
+    if (active) {
+        start = Clock::now();
+    }
+}
+
+FrameProfiler::Scope::~Scope() {
+    if (active) {
+        profiler.record(phase, start, Clock::now());
+    }
+}
+
+// === FrameProfiler ===
+
+FrameProfiler::FrameProfiler()
+    : enabled(GanttConfig::DebugConfig::ENABLE_FPS_COUNTER || GanttConfig::DebugConfig::ENABLE_FRAME_TIME_LOG),
+    epoch(Clock::now()), frameStart(epoch) {
+    const size_t window = GanttConfig::DebugConfig::PROFILER_WINDOW_FRAMES;
+    for (auto& ring : rings) {
+        ring.values.assign(window, 0.0f);
+    }
+    frameStarts.values.assign(window, 0.0);
+    scratch.resize(window);
+    std::fill(std::begin(frameAccum), std::end(frameAccum), 0.0);
+    pendingEvents.reserve(static_cast<size_t>(GanttConfig::DebugConfig::PERFORMANCE_LOG_INTERVAL_FRAMES) * PHASE_COUNT * 2);
+    hudLineCount = 0;
+}
+
+FrameProfiler::~FrameProfiler() {
+    stopTrace();
+}
+
+void FrameProfiler::setEnabled(bool value) {
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+const char* FrameProfiler::phaseName(FramePhase phase) {
+    switch (phase) {
+    case FramePhase::Clear: return "clear";
+    case FramePhase::Axes: return "axes";
+    case FramePhase::Operations: return "operations";
+    case FramePhase::Labels: return "labels";
+    case FramePhase::Display: return "display";
+    case FramePhase::Update: return "update";
+    case FramePhase::Frame: return "frame";
+    default: return "unknown";
+    }
+}
+
+double FrameProfiler::toMicroseconds(Clock::time_point t) const {
+    return std::chrono::duration<double, std::micro>(t - epoch).count();
+}
+
+template<typename T>
+void FrameProfiler::pushSample(Ring<T>& ring, T value) {
+    ring.values[ring.next] = value;
+    ring.next = (ring.next + 1) % ring.values.size();
+    ring.count = std::min(ring.count + 1, ring.values.size());
+}
+
+void FrameProfiler::beginFrame() {
+    if (!isEnabled()) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    frameStart = Clock::now();
+    std::fill(std::begin(frameAccum), std::end(frameAccum), 0.0);
+}
+
+void FrameProfiler::record(FramePhase phase, Clock::time_point start, Clock::time_point end) {
+    const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (phase == FramePhase::Update) {
+        // update 不与帧对齐，每次调用作为一个样本
+        pushSample(rings[static_cast<int>(phase)], static_cast<float>(ms));
+    }
+    else {
+        frameAccum[static_cast<int>(phase)] += ms;
+    }
+
+    if (traceFile) {
+        if (pendingEvents.size() < pendingEvents.capacity()) {
+            pendingEvents.push_back(TraceEvent{ phase, currentThreadId(), toMicroseconds(start), ms * 1000.0 });
+        }
+        else {
+            ++droppedEvents;
+        }
+    }
+}
+
+void FrameProfiler::endFrame() {
+    if (!isEnabled()) return;
+    const Clock::time_point end = Clock::now();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const double frameMs = std::chrono::duration<double, std::milli>(end - frameStart).count();
+    frameAccum[static_cast<int>(FramePhase::Frame)] = frameMs;
+
+    for (int i = 0; i < PHASE_COUNT; ++i) {
+        if (i == static_cast<int>(FramePhase::Update)) continue;
+        pushSample(rings[i], static_cast<float>(frameAccum[i]));
+    }
+    pushSample(frameStarts, toMicroseconds(frameStart) / 1e6);
+
+    if (traceFile) {
+        if (pendingEvents.size() < pendingEvents.capacity()) {
+            pendingEvents.push_back(TraceEvent{ FramePhase::Frame, currentThreadId(), toMicroseconds(frameStart), frameMs * 1000.0 });
+        }
+        else {
+            ++droppedEvents;
+        }
+    }
+
+    ++frameCounter;
+    if (frameCounter % GanttConfig::DebugConfig::HUD_REFRESH_FRAMES == 0) {
+        refreshHudLocked();
+    }
+    if (frameCounter % GanttConfig::DebugConfig::PERFORMANCE_LOG_INTERVAL_FRAMES == 0) {
+        if (GanttConfig::DebugConfig::ENABLE_FRAME_TIME_LOG) {
+            logSummaryLocked();
+        }
+        flushTraceLocked();
+    }
+}
+
+PhaseSummary FrameProfiler::summarize(const SampleRing& ring) const {
+    PhaseSummary summary;
+    summary.samples = ring.count;
+    if (ring.count == 0) return summary;
+
+    double sum = 0.0;
+    float maxValue = 0.0f;
+    for (size_t i = 0; i < ring.count; ++i) {
+        scratch[i] = ring.values[i];
+        sum += ring.values[i];
+        maxValue = std::max(maxValue, ring.values[i]);
+    }
+
+    summary.mean = sum / ring.count;
+    summary.max = maxValue;
+    summary.p50 = percentileOf(scratch, ring.count, 0.50);
+    summary.p95 = percentileOf(scratch, ring.count, 0.95);
+    summary.p99 = percentileOf(scratch, ring.count, 0.99);
+    return summary;
+}
+
+PhaseSummary FrameProfiler::getSummary(FramePhase phase) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return summarize(rings[static_cast<int>(phase)]);
+}
+
+double FrameProfiler::getFps() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return computeFpsLocked();
+}
+
+double FrameProfiler::computeFpsLocked() const {
+    if (frameStarts.count < 2) return 0.0;
+
+    size_t size = frameStarts.values.size();
+    size_t newest = (frameStarts.next + size - 1) % size;
+    size_t oldest = (frameStarts.next + size - frameStarts.count) % size;
+    double elapsed = frameStarts.values[newest] - frameStarts.values[oldest];
+    return elapsed > 0 ? (frameStarts.count - 1) / elapsed : 0.0;
+}
+
+const char* FrameProfiler::getHudLine(size_t index, size_t& length) const {
+    length = index < hudLineCount ? hudLengths[index] : 0;
+    return index < hudLineCount ? hudLines[index] : "";
+}
+
+void FrameProfiler::refreshHudLocked() {
+    double fps = computeFpsLocked();
+
+    size_t line = 0;
+    int written = std::snprintf(hudLines[line], sizeof(hudLines[line]), "FPS %.1f   (ms)   p50    p95    p99", fps);
+    hudLengths[line++] = static_cast<size_t>(std::max(0, written));
+
+    for (int i = 0; i < PHASE_COUNT; ++i) {
+        PhaseSummary s = summarize(rings[i]);
+        written = std::snprintf(hudLines[line], sizeof(hudLines[line]), "%-11s %6.2f %6.2f %6.2f",
+            phaseName(static_cast<FramePhase>(i)), s.p50, s.p95, s.p99);
+        hudLengths[line++] = static_cast<size_t>(std::max(0, std::min(written, static_cast<int>(sizeof(hudLines[0])) - 1)));
+    }
+    hudLineCount = line;
+}
+
+void FrameProfiler::logSummaryLocked() {
+    if (!Logger::instance().shouldLog(LogLevel::Info)) return;
+
+    PhaseSummary frame = summarize(rings[static_cast<int>(FramePhase::Frame)]);
+    Logger::LineBuilder line(LogLevel::Info);
+    line.stream() << "[PERF] frame p50=" << frame.p50 << "ms p95=" << frame.p95 << "ms p99=" << frame.p99 << "ms";
+    for (int i = 0; i < PHASE_COUNT; ++i) {
+        if (i == static_cast<int>(FramePhase::Frame)) continue;
+        PhaseSummary s = summarize(rings[i]);
+        line.stream() << " | " << phaseName(static_cast<FramePhase>(i)) << " p95=" << s.p95;
+    }
+}
+
+// === Chrome trace-event 输出 ===
+// 使用 JSON Array 格式：末尾的 "]" 可以省略，因此进程异常退出时文件仍然可以打开
+
+bool FrameProfiler::startTrace(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (traceFile) {
+        flushTraceLocked();
+        std::fputs("\n]\n", traceFile);
+        std::fclose(traceFile);
+    }
+
+    traceFile = std::fopen(path.c_str(), "w");
+    if (!traceFile) {
+        GANTT_LOG(LogLevel::Error, "Could not open trace file " << path);
+        return false;
+    }
+
+    std::fputs("[\n", traceFile);
+    std::fprintf(traceFile, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"GanttChart\"}}");
+    traceNeedsComma = true;
+    pendingEvents.clear();
+    droppedEvents = totalDroppedEvents = 0;
+    return true;
+}
+
+void FrameProfiler::stopTrace() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!traceFile) return;
+
+    flushTraceLocked();
+    std::fputs("\n]\n", traceFile);
+    std::fclose(traceFile);
+    traceFile = nullptr;
+    if (totalDroppedEvents > 0) {
+        GANTT_LOG(LogLevel::Warning, "Trace buffer overflowed: " << totalDroppedEvents << " events were dropped");
+    }
+}
+
+void FrameProfiler::flushTraceLocked() {
+    if (!traceFile) {
+        pendingEvents.clear();
+        droppedEvents = 0;
+        return;
+    }
+
+    // 缓冲区满时丢弃的事件数写成计数器事件，在 Perfetto 中显示为一条轨道
+    if (droppedEvents > 0) {
+        std::fprintf(traceFile, "%s\n{\"name\":\"dropped_events\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":0,"
+            "\"args\":{\"dropped\":%zu}}",
+            traceNeedsComma ? "," : "", toMicroseconds(Clock::now()), droppedEvents);
+        traceNeedsComma = true;
+        totalDroppedEvents += droppedEvents;
+        droppedEvents = 0;
+    }
+
+    for (const auto& e : pendingEvents) {
+        std::fprintf(traceFile, "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+            traceNeedsComma ? "," : "", phaseName(e.phase),
+            e.phase == FramePhase::Update ? "update" : "frame",
+            e.startUs, e.durationUs, e.threadId);
+        traceNeedsComma = true;
+    }
+    pendingEvents.clear();
+    std::fflush(traceFile);
+}
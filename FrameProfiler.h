@@ -0,0 +1,153 @@
+//
+// 帧阶段性能分析器
+// 记录各绘制阶段耗时，维护滚动百分位，并可导出 Chrome trace-event JSON（可在 Perfetto 中打开）
+//
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+#include "GanttConfig.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 被计时的阶段
+enum class FramePhase {
+    Clear,
+    Axes,
+    Operations,
+    Labels,
+    Display,
+    Update,   // update() 数据处理，可能来自其他线程，不计入帧
+    Frame,    // 整帧耗时
+    Count
+};
+
+// 单个阶段的统计结果（单位：毫秒）
+struct PhaseSummary {
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double mean = 0.0;
+    double max = 0.0;
+    size_t samples = 0;
+};
+
+class FrameProfiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief RAII阶段计时，未启用时不读取时钟
+     */
+    class Scope {
+    public:
+        Scope(FrameProfiler& profiler, FramePhase phase);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        FrameProfiler& profiler;
+        FramePhase phase;
+        bool active;
+        Clock::time_point start;
+    };
+
+    FrameProfiler();
+    ~FrameProfiler();
+
+    void setEnabled(bool value);
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 帧边界，由绘制线程调用
+     */
+    void beginFrame();
+    void endFrame();
+
+    /**
+     * @brief 记录一段阶段耗时（线程安全）
+     */
+    void record(FramePhase phase, Clock::time_point start, Clock::time_point end);
+
+    /**
+     * @brief 获取阶段在滚动窗口内的统计
+     */
+    PhaseSummary getSummary(FramePhase phase) const;
+
+    /**
+     * @brief 滚动窗口内的平均帧率
+     */
+    double getFps() const;
+
+    /**
+     * @brief 开始/停止写入 Chrome trace-event JSON 文件
+     */
+    bool startTrace(const std::string& path);
+    void stopTrace();
+    bool isTracing() const { return traceFile != nullptr; }
+
+    /**
+     * @brief HUD文本（每 HUD_REFRESH_FRAMES 帧刷新一次，预先格式化到固定缓冲区）
+     */
+    size_t getHudLineCount() const { return hudLineCount; }
+    const char* getHudLine(size_t index, size_t& length) const;
+
+    static const char* phaseName(FramePhase phase);
+
+private:
+    static const int PHASE_COUNT = static_cast<int>(FramePhase::Count);
+    static const int MAX_HUD_LINES = PHASE_COUNT + 1;
+
+    struct TraceEvent {
+        FramePhase phase;
+        unsigned threadId;
+        double startUs;
+        double durationUs;
+    };
+
+    // 环形样本缓冲区
+    template<typename T>
+    struct Ring {
+        std::vector<T> values;
+        size_t next = 0;
+        size_t count = 0;
+    };
+    using SampleRing = Ring<float>;   // 阶段耗时（毫秒）
+
+    std::atomic<bool> enabled;
+    mutable std::mutex mutex;
+    Clock::time_point epoch;
+    Clock::time_point frameStart;
+    double frameAccum[PHASE_COUNT];
+    SampleRing rings[PHASE_COUNT];
+    Ring<double> frameStarts; // 帧开始时间（自 epoch 起的秒数，double 在长时间运行后仍保持微秒精度），用于计算帧率
+    mutable std::vector<float> scratch;
+    long long frameCounter = 0;
+
+    // trace 输出
+    std::FILE* traceFile = nullptr;
+    bool traceNeedsComma = false;
+    std::vector<TraceEvent> pendingEvents;
+    size_t droppedEvents = 0;        // 两次写出之间缓冲区已满而丢弃的事件数
+    size_t totalDroppedEvents = 0;   // 本次 trace 中丢弃的事件总数
+
+    // HUD
+    char hudLines[MAX_HUD_LINES][96];
+    size_t hudLengths[MAX_HUD_LINES];
+    size_t hudLineCount = 0;
+
+    template<typename T>
+    void pushSample(Ring<T>& ring, T value);
+    PhaseSummary summarize(const SampleRing& ring) const;
+    void flushTraceLocked();
+    void refreshHudLocked();
+    void logSummaryLocked();
+    double computeFpsLocked() const;
+    double toMicroseconds(Clock::time_point t) const;
+};
+
+#endif // FRAME_PROFILER_H
@@ -1,8 +1,8 @@
 #include "GanttChart.h"
 
-// ========== ļ̬Ա ==========
+// ========== 配置文件静态成员定义 ==========
 namespace GanttConfig {
-    // ·
+    // 字体路径定义
     const std::string FontConfig::DEFAULT_FONT_PATH = "arial.ttf";
     const std::string FontConfig::FALLBACK_FONT_PATHS[] = {
         "C:\\Windows\\Fonts\\arial.ttf",
@@ -11,41 +11,62 @@ namespace GanttConfig {
         "/usr/share/fonts/TTF/arial.ttf"
     };
 
-    // ʱ䲽ѡ
+    // 时间步长候选
     const int TimeAxisConfig::TIME_STEP_CANDIDATES[] = {
         50, 100, 200, 500, 1000, 2000
     };
+
+    // 性能跟踪输出
+    const std::string DebugConfig::TRACE_FILE_PATH = "gantt_trace.json";
 }
 
-// === 캯 ===
-GanttChart::GanttChart(sf::RenderWindow& win) : window(win) {
-    // Ĭ
+// === 构造函数 ===
+template<typename TimeT>
+BasicGanttChart<TimeT>::BasicGanttChart(sf::RenderWindow& win) : window(win) {
+    // 加载默认配置
     loadDefaultConfig();
+    shapeBatch.setPrimitiveType(sf::Triangles);
 }
 
-// === Ҫӿʵ ===
+// === 主要接口实现 ===
 
-bool GanttChart::init(const std::string& fontPath) {
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::init(const std::string& fontPath) {
     std::lock_guard<std::mutex> lock(dataMutex);
 
-    // Լ
+    // 尝试加载字体
     std::string actualFontPath = fontPath.empty() ?
         GanttConfig::FontConfig::DEFAULT_FONT_PATH : fontPath;
 
     if (!tryLoadFont(actualFontPath)) {
-        std::cout << "[WARNING] Could not load any font file. Using default font." << std::endl;
+        WARNING("Could not load any font file. Using default font.");
+    }
+
+    // 预热字形缓存（字形页在此之后保持稳定）
+    labelCache.setFont(font);
+
+    // 启用帧时间日志时同时输出 Chrome trace 文件
+    if (GanttConfig::DebugConfig::ENABLE_FRAME_TIME_LOG && !profiler.isTracing()) {
+        profiler.startTrace(GanttConfig::DebugConfig::TRACE_FILE_PATH);
     }
 
-    // 
+    // 清空所有数据
     operations.clear();
+    std::vector<Operation>().swap(ownedOperations);
+    borrowedData = false;
+    borrowedSource.reset();
     jobColors.clear();
+    buildRowIndex();
+    assignRowGroups();
+    rebuildDisplayLines();
+    groupLevels.clear();
 
-    // ͼĬֵ
+    // 重置视图参数到配置默认值
     zoomLevel = GanttConfig::ViewConfig::DEFAULT_ZOOM_LEVEL;
-    offsetX = 0.0f;
+    viewStartTime = 0.0;
     offsetY = 0.0f;
 
-    // ÷Χ
+    // 重置范围
     minTime = maxTime = 0;
     minMachine = maxMachine = 0;
     timeScale = 1.0f;
@@ -61,47 +82,396 @@ bool GanttChart::init(const std::string& fontPath) {
     return true;
 }
 
-bool GanttChart::update(const qm::Data& newData, bool immediate_draw) {
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::update(const Data& newData, bool immediate_draw) {
     return update(newData.data, immediate_draw);
 }
 
-bool GanttChart::update(const std::vector<qm::Operation>& newOperations, bool immediate_draw) {
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::update(const std::vector<Operation>& newOperations, bool immediate_draw) {
+    return updateFromView(View::fromRecords(newOperations), false, immediate_draw);
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::update(const View& view, bool immediate_draw) {
+    return updateFromView(view, false, immediate_draw);
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::updateBorrowed(const View& view, bool immediate_draw) {
+    return updateFromView(view, true, immediate_draw);
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::updateFromArrow(ArrowArray* array, ArrowSchema* schema, bool immediate_draw,
+    const ArrowColumnNames& names) {
+    // 导入（含必要的列转换）在锁外进行，不阻塞绘制
+    std::shared_ptr<BasicArrowOperationSource<TimeT>> source = std::make_shared<BasicArrowOperationSource<TimeT>>();
+    if (!source->import(array, schema, names)) {
+        std::lock_guard<std::mutex> lock(dataMutex);
+        updateStats.recordDropped();
+        return false;
+    }
+
+    const View view = source->view();
+    return updateFromView(view, true, immediate_draw, std::move(source));
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::updateFromShm(qm::BasicShmScheduleReader<TimeT>& reader, bool immediate_draw) {
+    std::shared_ptr<qm::ShmSlotLease<TimeT>> lease = reader.acquireNext();
+    if (!lease) {
+        return false;
+    }
+
+    const View view = lease->view();
+    return updateFromView(view, true, immediate_draw, std::move(lease));
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::updateFromView(const View& view, bool borrowed, bool immediate_draw,
+    std::shared_ptr<const void> source) {
+    using StatsClock = UpdatePipelineStats::Clock;
+    const StatsClock::time_point updateStart = StatsClock::now();
+
     if (!isInitialized) {
         ERROR("GanttChart not initialized. Call init() first.");
+        std::lock_guard<std::mutex> lock(dataMutex);
+        updateStats.recordDropped();
         return false;
     }
 
     {
         std::lock_guard<std::mutex> lock(dataMutex);
+        FrameProfiler::Scope updateScope(profiler, FramePhase::Update);
+        if (deferToHistory(view)) {
+            return true;
+        }
+
+        // 设置新数据：借用模式直接引用调用方内存，否则按视图收集一次到内部存储
+        if (borrowed) {
+            std::vector<Operation>().swap(ownedOperations);
+            operations = view;
+        }
+        else {
+            const size_t count = view.size();
+            ownedOperations.resize(count);
+            for (size_t i = 0; i < count; ++i) {
+                ownedOperations[i] = view[i];
+            }
+            operations = View::fromRecords(ownedOperations);
+        }
+        borrowedData = borrowed;
+        // 新数据就位后才释放上一次借用的内存
+        borrowedSource = std::move(source);
+        refreshDerivedData(updateStart);
+    }
+
+    // 立即绘制（如果请求的话）
+    if (immediate_draw) {
+        draw();
+    }
+
+    INFO("Updated gantt chart with " << view.size() << " operations");
+    return true;
+}
 
-        // վ
-        operations.clear();
-        jobColors.clear();
-        debugOutputShown = false;
+template<typename TimeT>
+void BasicGanttChart<TimeT>::refreshDerivedData(UpdatePipelineStats::Clock::time_point updateStart) {
+    using StatsClock = UpdatePipelineStats::Clock;
+
+    // 清空旧数据；差异只对应更新前的调度
+    jobColors.clear();
+    debugOutputShown = false;
+    clearDiffLocked();
+    loadProfile.clear();
+
+    buildRowIndex();
+    assignRowGroups();
+    rebuildDisplayLines();
+    if (gapIndexEnabled && !gapIndexCurrent) {
+        gapIndex.build(operations, rowOffsets, rowOperations);
+    }
+    gapIndexCurrent = false;
+    StatsClock::time_point stageEnd = StatsClock::now();
+    updateStats.recordStage(UpdateStage::Ingest, updateStart, stageEnd);
 
-        // 
-        operations = newOperations;
+    if (!operations.empty()) {
+        StatsClock::time_point stageStart = stageEnd;
+        calculateRanges();
+        stageEnd = StatsClock::now();
+        updateStats.recordStage(UpdateStage::Ranges, stageStart, stageEnd);
+
+        stageStart = stageEnd;
+        generateJobColors();
+        stageEnd = StatsClock::now();
+        updateStats.recordStage(UpdateStage::Colors, stageStart, stageEnd);
+
+        stageStart = stageEnd;
+        DATA_DEBUG("=== Data Updated ===");
+        printLoadedData();
+        if (showLoadCurve) {
+            loadProfile.build(operations, rowOffsets, rowOperations);
+        }
+        computeGroupOccupancy();
+        updateStats.recordStage(UpdateStage::Analysis, stageStart, StatsClock::now());
+    }
 
-        if (!operations.empty()) {
-            calculateRanges();
-            generateJobColors();
+    updateStats.recordUpdate(operations.size(), updateStart);
 
-            DATA_DEBUG("=== Data Updated ===");
-            printLoadedData();
+    // 回放或浏览历史时显示的是旧数据，不再写回记录
+    if (!replay && !browsingHistory) {
+        if (recorder) {
+            recorder->record(operations);
+        }
+        if (historyRing) {
+            historyRing->push(operations);
+        }
+    }
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::applyDelta(const Delta& delta, bool immediate_draw) {
+    using StatsClock = UpdatePipelineStats::Clock;
+    const StatsClock::time_point updateStart = StatsClock::now();
+
+    if (!isInitialized) {
+        ERROR("GanttChart not initialized. Call init() first.");
+        std::lock_guard<std::mutex> lock(dataMutex);
+        updateStats.recordDropped();
+        return false;
+    }
+
+    size_t changed;
+    {
+        std::lock_guard<std::mutex> lock(dataMutex);
+        FrameProfiler::Scope updateScope(profiler, FramePhase::Update);
+        if (deferToHistory(delta)) {
+            return true;
+        }
+        changed = applyDeltaLocked(delta);
+        refreshDerivedData(updateStart);
+    }
+
+    if (immediate_draw) {
+        draw();
+    }
+
+    INFO("Applied delta to gantt chart: " << delta.upserts.size() << " upserts, " << delta.removals.size()
+        << " removals, " << changed << " operations changed");
+    return true;
+}
+
+template<typename TimeT>
+size_t BasicGanttChart<TimeT>::applyDeltaLocked(const Delta& delta) {
+    // 借用的数据不能原地修改，先拷贝一次到内部存储
+    if (borrowedData) {
+        const size_t count = operations.size();
+        ownedOperations.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            ownedOperations[i] = operations[i];
+        }
+        borrowedData = false;
+        borrowedSource.reset();
+    }
+
+    const size_t changed = qm::applyScheduleDelta(ownedOperations, delta);
+    operations = View::fromRecords(ownedOperations);
+
+    // 空闲区间索引按键增量更新；调度中有重复的键时由 refreshDerivedData 重建
+    gapIndexCurrent = gapIndexEnabled && gapIndex.applyDelta(delta);
+    return changed;
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::updateFromServer(BasicScheduleServer<TimeT>& server, bool immediate_draw) {
+    // 客户端统计只在服务端统计窗口结束或客户端变化时重新格式化
+    const std::uint64_t statsVersion = server.getStatsVersion();
+    if (statsVersion != sourceStatusVersion) {
+        std::vector<std::string> lines;
+        server.formatStats(lines);
+        std::lock_guard<std::mutex> lock(dataMutex);
+        sourceStatusLines.swap(lines);
+        sourceStatusVersion = statsVersion;
+    }
+
+    typename BasicScheduleServer<TimeT>::Update update;
+    if (!server.takeUpdate(update)) {
+        return false;
+    }
+    if (!update.full) {
+        return applyDelta(update.delta, immediate_draw);
+    }
+
+    if (!isInitialized) {
+        ERROR("GanttChart not initialized. Call init() first.");
+        std::lock_guard<std::mutex> lock(dataMutex);
+        updateStats.recordDropped();
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(dataMutex);
+        if (deferToHistory(View::fromRecords(update.operations))) {
+            return true;
         }
     }
 
-    // ƣĻ
+    // 完整快照：服务端已拷贝出独立的向量，直接换入内部存储，后续增量可原地应用
+    installOperations(update.operations, immediate_draw);
+
+    INFO("Updated gantt chart from schedule client #" << update.clientId << " with " << getOperationCount()
+        << " operations (" << update.frames << " frames)");
+    return true;
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::installOperations(std::vector<Operation>& ops, bool immediate_draw) {
+    const UpdatePipelineStats::Clock::time_point updateStart = UpdatePipelineStats::Clock::now();
+    {
+        std::lock_guard<std::mutex> lock(dataMutex);
+        FrameProfiler::Scope updateScope(profiler, FramePhase::Update);
+        ownedOperations.swap(ops);
+        operations = View::fromRecords(ownedOperations);
+        borrowedData = false;
+        borrowedSource.reset();
+        refreshDerivedData(updateStart);
+    }
+
     if (immediate_draw) {
         draw();
     }
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::setSourceStatus(const std::vector<std::string>& lines) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    sourceStatusLines = lines;
+}
+
+// === 历史记录与回放 ===
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::setRecorder(BasicScheduleRecorder<TimeT>* historyRecorder) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    recorder = historyRecorder;
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::openReplay(const std::string& filename) {
+    if (!isInitialized) {
+        ERROR("GanttChart not initialized. Call init() first.");
+        return false;
+    }
+
+    std::unique_ptr<BasicScheduleHistoryReader<TimeT>> reader(new BasicScheduleHistoryReader<TimeT>());
+    if (!reader->open(filename)) {
+        ERROR("Failed to open schedule history: " << filename);
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(dataMutex);
+        replay = std::move(reader);
+        replayRecord = 0;
+        replayPosition = 0.0;
+        replayPlaying = false;
+        replaySeekPending = false;
+        draggingReplayBar = false;
+        replayLastTick = std::chrono::steady_clock::now();
+    }
+    return seekReplay(0);
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::closeReplay() {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    replay.reset();
+    replayPlaying = false;
+    replaySeekPending = false;
+    draggingReplayBar = false;
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::isReplaying() const {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    return replay != nullptr;
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::seekReplay(size_t record, bool immediate_draw) {
+    {
+        std::lock_guard<std::mutex> lock(dataMutex);
+        if (!replay) return false;
+
+        record = std::min(record, replay->getRecordCount() - 1);
+        if (!replay->seek(record, replayBuffer)) {
+            return false;
+        }
+        replayRecord = record;
+        // 播放中的小数位置属于同一条记录时保留
+        if (static_cast<size_t>(replayPosition) != record) {
+            replayPosition = static_cast<double>(record);
+        }
+    }
 
-    INFO("Updated gantt chart with " << newOperations.size() << " operations");
+    installOperations(replayBuffer, immediate_draw);
     return true;
 }
 
-void GanttChart::loadDefaultConfig() {
-    // ļĬϲ
+template<typename TimeT>
+void BasicGanttChart<TimeT>::setReplaySpeed(double recordsPerSecond) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    replaySpeed = std::max(GanttConfig::HistoryConfig::REPLAY_MIN_SPEED,
+        std::min(GanttConfig::HistoryConfig::REPLAY_MAX_SPEED, recordsPerSecond));
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::setReplayPlaying(bool playing) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    if (!replay) return;
+    // 停在末尾时从头播放
+    if (playing && !replayPlaying && replayRecord + 1 >= replay->getRecordCount()) {
+        replayPosition = 0.0;
+        replaySeekPending = true;
+    }
+    replayPlaying = playing;
+    replayLastTick = std::chrono::steady_clock::now();
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::updateReplay(bool immediate_draw) {
+    size_t target;
+    {
+        std::lock_guard<std::mutex> lock(dataMutex);
+        if (!replay) return false;
+
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        const double elapsed = std::chrono::duration<double>(now - replayLastTick).count();
+        replayLastTick = now;
+
+        const double lastRecord = static_cast<double>(replay->getRecordCount() - 1);
+        if (replayPlaying && !draggingReplayBar) {
+            replayPosition += elapsed * replaySpeed;
+            if (replayPosition >= lastRecord) {
+                replayPosition = lastRecord;
+                replayPlaying = false;
+            }
+        }
+
+        target = static_cast<size_t>(std::max(0.0, std::min(lastRecord, replayPosition)));
+        if (target == replayRecord && !replaySeekPending) {
+            return false;
+        }
+        replaySeekPending = false;
+    }
+
+    return seekReplay(target, immediate_draw);
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::loadDefaultConfig() {
+    // 从配置文件加载默认参数
     leftMargin = GanttConfig::LayoutConfig::LEFT_MARGIN;
     topMargin = GanttConfig::LayoutConfig::TOP_MARGIN;
     bottomMargin = GanttConfig::LayoutConfig::BOTTOM_MARGIN;
@@ -110,45 +480,34 @@ void GanttChart::loadDefaultConfig() {
     barSpacing = GanttConfig::LayoutConfig::DEFAULT_BAR_SPACING;
 
     zoomLevel = GanttConfig::ViewConfig::DEFAULT_ZOOM_LEVEL;
-    offsetX = 0.0f;
+    viewStartTime = 0.0;
     offsetY = 0.0f;
 
     INFO("Default configuration loaded from GanttConfig");
 }
 
-bool GanttChart::tryLoadFont(const std::string& fontPath) {
-    // ȳԼָ
-    if (font.loadFromFile(fontPath)) {
-        INFO("Font loaded successfully: " << fontPath);
-        return true;
-    }
-
-    // ʧܣԱ·
-    for (int i = 0; i < GanttConfig::FontConfig::FALLBACK_FONT_COUNT; ++i) {
-        if (font.loadFromFile(GanttConfig::FontConfig::FALLBACK_FONT_PATHS[i])) {
-            INFO("Fallback font loaded: " << GanttConfig::FontConfig::FALLBACK_FONT_PATHS[i]);
-            return true;
-        }
-    }
-
-    WARNING("Could not load any font file, using default system font");
-    return false;
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::tryLoadFont(const std::string& fontPath) {
+    return loadGanttFont(font, fontPath);
 }
 
-// === ԭйּܱ ===
+// === 原有功能保持兼容 ===
 
-void GanttChart::setData(const std::vector<qm::Operation>& ops) {
+template<typename TimeT>
+void BasicGanttChart<TimeT>::setData(const std::vector<Operation>& ops) {
     std::lock_guard<std::mutex> lock(dataMutex);
 
-    operations = ops;
-    calculateRanges();
-    generateJobColors();
-    DATA_DEBUG("=== Test Data Loaded ===");
-    printLoadedData();
+    ownedOperations = ops;
+    operations = View::fromRecords(ownedOperations);
+    borrowedData = false;
+    borrowedSource.reset();
+    // 与 update 相同的派生数据路径：行索引、范围、颜色、空闲区间索引、负载曲线，并清除旧的差异
+    refreshDerivedData(UpdatePipelineStats::Clock::now());
 }
 
-bool GanttChart::loadFromCSV(const std::string& filename) {
-    auto loadedOps = loadOperationsFromCSV(filename);
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::loadFromCSV(const std::string& filename) {
+    auto loadedOps = loadBasicOperationsFromCSV<TimeT>(filename);
     if (loadedOps.empty()) {
         ERROR("Failed to load operations from CSV file: " << filename);
         return false;
@@ -157,8 +516,20 @@ bool GanttChart::loadFromCSV(const std::string& filename) {
     return update(loadedOps);
 }
 
-// ӡѼصݽ֤
-void GanttChart::printLoadedData() {
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::loadFromJSON(const std::string& filename) {
+    auto loadedOps = loadBasicOperationsFromJSON<TimeT>(filename);
+    if (loadedOps.empty()) {
+        ERROR("Failed to load operations from JSON file: " << filename);
+        return false;
+    }
+
+    return update(loadedOps);
+}
+
+// 打印已加载的数据进行验证
+template<typename TimeT>
+void BasicGanttChart<TimeT>::printLoadedData() {
 #if ENABLE_DATA_ANALYSIS
     std::cout << "[DATA] === Loaded Operations Data ===" << std::endl;
     std::cout << "[DATA] Format: [Index] Job-Stage | Machine | Time | Critical" << std::endl;
@@ -178,7 +549,7 @@ void GanttChart::printLoadedData() {
     std::cout << "[DATA] Machine range: " << minMachine << " - " << maxMachine << " (count: " << (maxMachine - minMachine + 1) << ")" << std::endl;
     std::cout << "[DATA] Time scale: " << timeScale << " pixels per time unit" << std::endl;
 
-    // ص
+    // 检查重叠问题
     checkOverlaps();
 
     std::cout << "[DATA] === Job Colors ===" << std::endl;
@@ -191,12 +562,13 @@ void GanttChart::printLoadedData() {
 #endif
 }
 
-// еص
-void GanttChart::checkOverlaps() {
+// 检查数据中的重叠问题
+template<typename TimeT>
+void BasicGanttChart<TimeT>::checkOverlaps() {
     OVERLAP_DEBUG("=== Overlap Analysis ===");
 
-    // ص
-    std::map<int, std::vector<qm::Operation>> machineOps;
+    // 按机器分组检查重叠
+    std::map<int, std::vector<Operation>> machineOps;
     for (const auto& op : operations) {
         machineOps[op.machine_id].push_back(op);
     }
@@ -208,8 +580,8 @@ void GanttChart::checkOverlaps() {
         int machineId = pair.first;
         auto& ops = pair.second;
 
-        // ʼʱ
-        std::sort(ops.begin(), ops.end(), [](const qm::Operation& a, const qm::Operation& b) {
+        // 按开始时间排序
+        std::sort(ops.begin(), ops.end(), [](const Operation& a, const Operation& b) {
             return a.start_time < b.start_time;
             });
 
@@ -219,11 +591,11 @@ void GanttChart::checkOverlaps() {
             std::cout << "[OVERLAP]   J" << op.job_id << "-" << op.stage
                 << " [" << op.start_time << "-" << op.end_time << "]";
 
-            // һص
+            // 检查与下一个操作的重叠
             if (i + 1 < ops.size()) {
                 const auto& nextOp = ops[i + 1];
                 if (op.end_time > nextOp.start_time) {
-                    std::cout << "   OVERLAP with J" << nextOp.job_id << "-" << nextOp.stage
+                    std::cout << " ！！  OVERLAP with J" << nextOp.job_id << "-" << nextOp.stage
                         << " [" << nextOp.start_time << "-" << nextOp.end_time << "]";
                     hasOverlaps = true;
                 }
@@ -234,35 +606,114 @@ void GanttChart::checkOverlaps() {
 #endif
 
     if (!hasOverlaps) {
-        INFO(" No time overlaps detected on any machine.");
+        INFO("√ No time overlaps detected on any machine.");
     }
     else {
-        WARNING("  Time overlaps detected! This may cause visual issues.");
+        WARNING("！！  Time overlaps detected! This may cause visual issues.");
     }
 }
 
-// ʱͻķΧ̬
-void GanttChart::calculateRanges() {
+// 建立行索引：机器ID排序去重后压缩为连续行，操作按行分组（CSR）并在行内按开始时间排序
+template<typename TimeT>
+void BasicGanttChart<TimeT>::buildRowIndex() {
+    rowMachines.clear();
+    rowOffsets.clear();
+    rowOperations.clear();
+    rowMaxDuration.clear();
+    rowMaxEnd.clear();
     if (operations.empty()) return;
 
-    minTime = maxTime = operations[0].start_time;
-    minMachine = maxMachine = operations[0].machine_id;
+    rowMachines.reserve(operations.size());
+    for (const auto& op : operations) {
+        rowMachines.push_back(op.machine_id);
+    }
+    std::sort(rowMachines.begin(), rowMachines.end());
+    rowMachines.erase(std::unique(rowMachines.begin(), rowMachines.end()), rowMachines.end());
+    rowMachines.shrink_to_fit();
+
+    // 计数排序：先统计每行操作数，再前缀和得到偏移
+    std::vector<int> opRows(operations.size());
+    rowOffsets.assign(rowMachines.size() + 1, 0);
+    for (size_t i = 0; i < operations.size(); ++i) {
+        int row = static_cast<int>(std::lower_bound(rowMachines.begin(), rowMachines.end(),
+            operations.machineId[i]) - rowMachines.begin());
+        opRows[i] = row;
+        rowOffsets[row + 1]++;
+    }
+    for (size_t row = 0; row < rowMachines.size(); ++row) {
+        rowOffsets[row + 1] += rowOffsets[row];
+    }
+
+    rowOperations.resize(operations.size());
+    std::vector<int> cursor(rowOffsets.begin(), rowOffsets.end() - 1);
+    for (size_t i = 0; i < operations.size(); ++i) {
+        rowOperations[cursor[opRows[i]]++] = static_cast<int>(i);
+    }
+
+    rowMaxDuration.assign(rowMachines.size(), TimeT());
+    rowMaxEnd.resize(operations.size());
+    for (size_t row = 0; row < rowMachines.size(); ++row) {
+        std::sort(rowOperations.begin() + rowOffsets[row], rowOperations.begin() + rowOffsets[row + 1],
+            [this](int a, int b) { return operations.startTime[a] < operations.startTime[b]; });
+        for (int k = rowOffsets[row]; k < rowOffsets[row + 1]; ++k) {
+            const auto& op = operations[rowOperations[k]];
+            rowMaxDuration[row] = std::max(rowMaxDuration[row], op.end_time - op.start_time);
+            rowMaxEnd[k] = k > rowOffsets[row] ? std::max(rowMaxEnd[k - 1], op.end_time) : op.end_time;
+        }
+    }
+
+    RANGE_DEBUG("Row index built: " << rowMachines.size() << " rows for machine ids "
+        << rowMachines.front() << " - " << rowMachines.back());
+}
+
+// 计算时间和机器的范围，并动态调整布局（数据变化时调用）
+template<typename TimeT>
+void BasicGanttChart<TimeT>::calculateRanges() {
+    if (operations.empty()) return;
+
+    // 记录当前首行，布局变化后保持滚动位置
+    int firstVisibleRow = getFirstVisibleRow();
+    // 视图原点相对数据起点保持不变
+    double viewOffsetTime = viewStartTime - minTime;
+
+    computeDataStats();
+    updateLayout();
+    updateTimeScale();
+    viewStartTime = minTime + viewOffsetTime;
+    clampView();
+    scrollToRow(firstVisibleRow);
+}
 
+// 数据统计：只在数据变化时扫描一次
+template<typename TimeT>
+void BasicGanttChart<TimeT>::computeDataStats() {
+    minTime = maxTime = operations[0].start_time;
     for (const auto& op : operations) {
         minTime = std::min(minTime, op.start_time);
         maxTime = std::max(maxTime, op.end_time);
-        minMachine = std::min(minMachine, op.machine_id);
-        maxMachine = std::max(maxMachine, op.machine_id);
     }
 
-    // ݻֲ̬ʹļֵ
-    int machineCount = maxMachine - minMachine + 1;
-    float availableHeight = window.getSize().y - topMargin - bottomMargin;
+    // 行索引已按机器ID排序
+    minMachine = rowMachines.front();
+    maxMachine = rowMachines.back();
+
+    RANGE_DEBUG("=== Range Calculation Results ===");
+    RANGE_DEBUG("Time: " << minTime << " - " << maxTime << " (span: " << (maxTime - minTime) << ")");
+    RANGE_DEBUG("Machines: " << minMachine << " - " << maxMachine << " (count: " << rowMachines.size() << ")");
+}
+
+// 根据行数与窗口高度调整条形布局，O(1)
+template<typename TimeT>
+void BasicGanttChart<TimeT>::updateLayout() {
+    // 根据机器数量动态调整布局参数（使用配置文件阈值）
+    // 稀疏的机器ID已压缩为连续行，空缺的ID不占用行
+    int machineCount = std::max(1, getRowCount());
+    float availableHeight = window.getSize().y - topMargin - getBottomMargin();
 
     RANGE_DEBUG("Machine count: " << machineCount << ", Available height: " << availableHeight);
 
     if (machineCount <= GanttConfig::LayoutConfig::LUXURY_MACHINE_COUNT) {
-        // ٻʱΣ
+        // 很少机器时：大条形，宽间距
         barHeight = std::min(GanttConfig::LayoutConfig::MAX_BAR_HEIGHT,
             availableHeight / machineCount * GanttConfig::LayoutConfig::LUXURY_BAR_RATIO);
         barSpacing = std::min(GanttConfig::LayoutConfig::MAX_BAR_SPACING,
@@ -270,25 +721,25 @@ void GanttChart::calculateRanges() {
         RANGE_DEBUG("Layout: Very few machines - luxury display");
     }
     else if (machineCount <= GanttConfig::LayoutConfig::COMFORTABLE_MACHINE_COUNT) {
-        // ʱеΣм
+        // 少量机器时：中等条形，适中间距
         barHeight = std::min(60.0f, availableHeight / machineCount * GanttConfig::LayoutConfig::COMFORTABLE_BAR_RATIO);
         barSpacing = std::min(15.0f, availableHeight / machineCount * (1.0f - GanttConfig::LayoutConfig::COMFORTABLE_BAR_RATIO));
         RANGE_DEBUG("Layout: Few machines - comfortable display");
     }
     else if (machineCount <= GanttConfig::LayoutConfig::BALANCED_MACHINE_COUNT) {
-        // еƽʾ
+        // 中等数量机器：平衡显示
         barHeight = std::min(45.0f, availableHeight / machineCount * GanttConfig::LayoutConfig::BALANCED_BAR_RATIO);
         barSpacing = std::min(8.0f, availableHeight / machineCount * (1.0f - GanttConfig::LayoutConfig::BALANCED_BAR_RATIO));
         RANGE_DEBUG("Layout: Medium machines - balanced display");
     }
     else if (machineCount <= GanttConfig::LayoutConfig::COMPACT_MACHINE_COUNT) {
-        // ϶ʾ
+        // 较多机器：紧凑显示
         barHeight = std::min(30.0f, availableHeight / machineCount * GanttConfig::LayoutConfig::COMPACT_BAR_RATIO);
         barSpacing = std::min(5.0f, availableHeight / machineCount * (1.0f - GanttConfig::LayoutConfig::COMPACT_BAR_RATIO));
         RANGE_DEBUG("Layout: Many machines - compact display");
     }
     else {
-        // ʾÿռƽ
+        // 大量机器：超紧凑显示，按可用空间平均分配
         float totalSpace = availableHeight / machineCount;
         barHeight = std::max(GanttConfig::LayoutConfig::MIN_BAR_HEIGHT,
             totalSpace * GanttConfig::LayoutConfig::ULTRA_COMPACT_BAR_RATIO);
@@ -297,32 +748,19 @@ void GanttChart::calculateRanges() {
         RANGE_DEBUG("Layout: Very many machines - ultra-compact display");
     }
 
-    // ȷֲ÷Χ
+    // 确保布局参数在配置范围内
     barHeight = std::max(GanttConfig::LayoutConfig::MIN_BAR_HEIGHT,
         std::min(GanttConfig::LayoutConfig::MAX_BAR_HEIGHT, barHeight));
     barSpacing = std::max(GanttConfig::LayoutConfig::MIN_BAR_SPACING,
         std::min(GanttConfig::LayoutConfig::MAX_BAR_SPACING, barSpacing));
 
-    // ʱű - ż
-    float chartWidth = (window.getSize().x - leftMargin - rightMargin) * zoomLevel;
-    if (maxTime > minTime) {
-        timeScale = chartWidth / static_cast<float>(maxTime - minTime);
-    }
-    else {
-        timeScale = 1.0f;
-    }
-
-    RANGE_DEBUG("=== Range Calculation Results ===");
-    RANGE_DEBUG("Time: " << minTime << " - " << maxTime << " (span: " << (maxTime - minTime) << ")");
-    RANGE_DEBUG("Machines: " << minMachine << " - " << maxMachine << " (count: " << machineCount << ")");
     RANGE_DEBUG("Layout: barHeight=" << barHeight << ", barSpacing=" << barSpacing);
-    RANGE_DEBUG("Chart width: " << chartWidth << ", Time scale: " << timeScale);
 
-    // ֤ܸ߶Ƿʺϴ
+    // 验证总高度是否适合窗口，超出时启用行虚拟化滚动
     float totalRequiredHeight = machineCount * barHeight + (machineCount - 1) * barSpacing;
     if (totalRequiredHeight > availableHeight) {
-        WARNING("Total required height (" << totalRequiredHeight
-            << ") exceeds available height (" << availableHeight << ")");
+        RANGE_DEBUG("Rows exceed available height (" << totalRequiredHeight << "/" << availableHeight
+            << "), showing " << getVisibleRowCapacity() << " rows with scrollbar");
     }
     else {
         RANGE_DEBUG("Layout fits well: used " << totalRequiredHeight
@@ -331,18 +769,58 @@ void GanttChart::calculateRanges() {
     }
 }
 
-// Ϊÿjob_idɫ
-void GanttChart::generateJobColors() {
+// 时间缩放比例 = 图表宽度 * 缩放级别 / 时间跨度，O(1)
+template<typename TimeT>
+void BasicGanttChart<TimeT>::updateTimeScale() {
+    double chartWidth = (window.getSize().x - leftMargin - rightMargin) * zoomLevel;
+    if (maxTime > minTime) {
+        timeScale = chartWidth / (static_cast<double>(maxTime) - minTime);
+    }
+    else {
+        timeScale = 1.0;
+    }
+}
+
+// 最大缩放级别：深度缩放时按“每时间单位最多占多少像素”确定
+template<typename TimeT>
+double BasicGanttChart<TimeT>::getMaxZoomLevel() const {
+    double maxZoom = GanttConfig::ViewConfig::MAX_ZOOM_LEVEL;
+    if (GanttConfig::ViewConfig::ENABLE_DEEP_ZOOM && maxTime > minTime) {
+        double chartWidth = std::max(1.0f, window.getSize().x - leftMargin - rightMargin);
+        maxZoom = std::max(maxZoom, (static_cast<double>(maxTime) - minTime) *
+            GanttConfig::ViewConfig::DEEP_ZOOM_MAX_PIXELS_PER_UNIT / chartWidth);
+    }
+    return maxZoom;
+}
+
+// 限制水平平移范围（如果启用），边界余量按像素计
+template<typename TimeT>
+void BasicGanttChart<TimeT>::clampView() {
+    if (!GanttConfig::ViewConfig::ENABLE_VIEW_CLAMPING || operations.empty()) return;
+
+    const double chartWidth = window.getSize().x - leftMargin - rightMargin;
+    const double margin = GanttConfig::ViewConfig::VIEW_CLAMP_MARGIN / timeScale;
+    const double lowest = minTime - margin;
+    const double highest = minTime + std::max(0.0, (static_cast<double>(maxTime) - minTime) - chartWidth / timeScale) + margin;
+    viewStartTime = std::max(lowest, std::min(highest, viewStartTime));
+}
+
+// 为每个job_id生成颜色
+template<typename TimeT>
+void BasicGanttChart<TimeT>::generateJobColors() {
     jobColors.clear();
+    // 按首次出现的顺序收集作业，哈希去重保持线性
     std::vector<int> uniqueJobs;
+    std::unordered_map<int, size_t> jobIndex;
+    jobIndex.reserve(operations.size() / 4 + 1);
 
-    for (const auto& op : operations) {
-        if (std::find(uniqueJobs.begin(), uniqueJobs.end(), op.job_id) == uniqueJobs.end()) {
-            uniqueJobs.push_back(op.job_id);
+    for (size_t i = 0; i < operations.size(); ++i) {
+        if (jobIndex.emplace(operations.jobId[i], uniqueJobs.size()).second) {
+            uniqueJobs.push_back(operations.jobId[i]);
         }
     }
 
-    // ɲͬɫʹļ
+    // 生成不同的颜色（使用配置文件参数）
     for (size_t i = 0; i < uniqueJobs.size(); ++i) {
         float hue = (360.0f * i) / uniqueJobs.size();
         sf::Color color = hsvToRgb(hue,
@@ -352,302 +830,1868 @@ void GanttChart::generateJobColors() {
     }
 }
 
-// HSVתRGBʹõĬɫ
-sf::Color GanttChart::hsvToRgb(float h, float s, float v) {
-    float c = v * s;
-    float x = c * (1 - std::abs(std::fmod(h / 60.0f, 2) - 1));
-    float m = v - c;
+// HSV转RGB（使用配置的默认颜色）
+template<typename TimeT>
+sf::Color BasicGanttChart<TimeT>::hsvToRgb(float h, float s, float v) {
+    return hsvToColor(h, s, v);
+}
 
-    float r, g, b;
-    if (h >= 0 && h < 60) {
-        r = c; g = x; b = 0;
-    }
-    else if (h >= 60 && h < 120) {
-        r = x; g = c; b = 0;
-    }
-    else if (h >= 120 && h < 180) {
-        r = 0; g = c; b = x;
-    }
-    else if (h >= 180 && h < 240) {
-        r = 0; g = x; b = c;
-    }
-    else if (h >= 240 && h < 300) {
-        r = x; g = 0; b = c;
-    }
-    else {
-        r = c; g = 0; b = x;
-    }
+// 获取行在屏幕上的Y坐标
+template<typename TimeT>
+float BasicGanttChart<TimeT>::getRowY(int row) const {
+    return topMargin + offsetY + row * getRowPitch();
+}
 
-    return sf::Color(
-        static_cast<sf::Uint8>((r + m) * 255),
-        static_cast<sf::Uint8>((g + m) * 255),
-        static_cast<sf::Uint8>((b + m) * 255)
-    );
+template<typename TimeT>
+float BasicGanttChart<TimeT>::getRowPitch() const {
+    return barHeight + barSpacing;
+}
+
+template<typename TimeT>
+int BasicGanttChart<TimeT>::getRowCount() const {
+    return static_cast<int>(displayLines.empty() ? rowMachines.size() : displayLines.size());
 }
 
-// ȡĻϵY
-float GanttChart::getMachineY(int machineId) {
-    int machineIndex = machineId - minMachine;
-    return topMargin + offsetY + machineIndex * (barHeight + barSpacing);
+// 实际底部边距：配置的边距加上显示时的负载曲线区
+template<typename TimeT>
+float BasicGanttChart<TimeT>::getBottomMargin() const {
+    return bottomMargin + (showLoadCurve
+        ? GanttConfig::LoadCurveConfig::STRIP_HEIGHT + GanttConfig::LoadCurveConfig::STRIP_GAP : 0.0f);
 }
 
-// ȡʱĻϵX
-float GanttChart::getTimeX(int time) {
-    return leftMargin + offsetX + (time - minTime) * timeScale;
+// 图表区域内完整可见的行数
+template<typename TimeT>
+int BasicGanttChart<TimeT>::getVisibleRowCapacity() const {
+    float chartHeight = window.getSize().y - topMargin - getBottomMargin();
+    return std::max(1, static_cast<int>((chartHeight + barSpacing) / getRowPitch()));
+}
+
+// 与图表区域相交的行范围（含部分可见的行）
+template<typename TimeT>
+void BasicGanttChart<TimeT>::getVisibleRows(int& firstRow, int& lastRow) const {
+    float chartHeight = window.getSize().y - topMargin - getBottomMargin();
+    firstRow = std::max(0, static_cast<int>(std::floor(-offsetY / getRowPitch())));
+    lastRow = std::min(getRowCount() - 1, static_cast<int>(std::floor((chartHeight - offsetY) / getRowPitch())));
+}
+
+// 按行滚动：offsetY 始终对齐到整行
+template<typename TimeT>
+void BasicGanttChart<TimeT>::scrollToRow(int row) {
+    int maxFirstRow = std::max(0, getRowCount() - getVisibleRowCapacity());
+    row = std::max(0, std::min(maxFirstRow, row));
+    offsetY = -row * getRowPitch();
+}
+
+template<typename TimeT>
+int BasicGanttChart<TimeT>::getFirstVisibleRow() const {
+    return static_cast<int>(std::lround(-offsetY / getRowPitch()));
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::scrollRows(int deltaRows) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    scrollToRow(getFirstVisibleRow() + deltaRows);
+}
+
+// 时间 -> 屏幕X坐标：先在 double 中减去相机原点，结果只在可见范围附近才是有意义的小数值
+template<typename TimeT>
+double BasicGanttChart<TimeT>::timeToX(double time) const {
+    return leftMargin + (time - viewStartTime) * timeScale;
+}
+
+template<typename TimeT>
+double BasicGanttChart<TimeT>::xToTime(double x) const {
+    return viewStartTime + (x - leftMargin) / timeScale;
+}
+
+// 获取时间在屏幕上的X坐标
+template<typename TimeT>
+float BasicGanttChart<TimeT>::getTimeX(TimeT time) const {
+    return static_cast<float>(timeToX(time));
+}
+
+// 添加缩放和平移控制（使用配置参数）
+// 以 anchorX 处的时间为锚点缩放，缩放前后该时间保持在同一屏幕位置
+// 深度缩放时按倍数缩放（每格滚轮 DEEP_ZOOM_FACTOR_PER_NOTCH），否则按 ZOOM_STEP 线性缩放
+template<typename TimeT>
+void BasicGanttChart<TimeT>::handleZoom(float wheelDelta, float anchorX) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    double oldZoom = zoomLevel;
+    double newZoom = GanttConfig::ViewConfig::ENABLE_DEEP_ZOOM
+        ? zoomLevel * std::pow(GanttConfig::ViewConfig::DEEP_ZOOM_FACTOR_PER_NOTCH, static_cast<double>(wheelDelta))
+        : zoomLevel + wheelDelta * GanttConfig::InteractionConfig::MOUSE_WHEEL_ZOOM_FACTOR * GanttConfig::ViewConfig::ZOOM_STEP;
+    zoomLevel = std::max<double>(GanttConfig::ViewConfig::MIN_ZOOM_LEVEL, std::min(getMaxZoomLevel(), newZoom));
+
+    if (zoomLevel != oldZoom && !operations.empty()) {
+        double anchorTime = xToTime(anchorX);
+        updateTimeScale();
+        viewStartTime = anchorTime - (anchorX - leftMargin) / timeScale;
+        clampView();
+        INFO_RATE_LIMITED("Zoom level: " << zoomLevel);
+    }
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::handlePan(float deltaX, float deltaY) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+
+    // 根据配置调整平移速度
+    // 深度缩放时平移速度不再随缩放级别继续减小，保持在屏幕上可见的移动距离
+    float panZoom = static_cast<float>(std::min<double>(zoomLevel, GanttConfig::ViewConfig::MAX_ZOOM_LEVEL));
+    float adjustedDeltaX = deltaX * GanttConfig::ViewConfig::ZOOM_ADJUSTED_PAN_FACTOR / panZoom;
+    float adjustedDeltaY = deltaY * GanttConfig::ViewConfig::ZOOM_ADJUSTED_PAN_FACTOR / panZoom;
+
+    viewStartTime -= adjustedDeltaX / timeScale;
+
+    // 纵向按行滚动（每次一行）
+    if (adjustedDeltaY != 0.0f) {
+        scrollToRow(getFirstVisibleRow() + (adjustedDeltaY > 0 ? -1 : 1));
+    }
+
+    clampView();
+}
+
+// 绘制甘特图
+template<typename TimeT>
+void BasicGanttChart<TimeT>::draw() {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    profiler.beginFrame();
+
+    // 添加错误处理
+    try {
+        {
+            FrameProfiler::Scope scope(profiler, FramePhase::Clear);
+            window.clear(sf::Color::White);
+        }
+
+        if (operations.empty()) {
+            // 绘制空状态提示
+            static const char emptyText[] = "No Data - Load operations to display gantt chart";
+            labelCache.appendText(emptyText, sizeof(emptyText) - 1, 16,
+                window.getSize().x / 2 - 200, window.getSize().y / 2, sf::Color::Black);
+            labelCache.flush(window);
+
+            // 绘制基本坐标轴
+            drawAxes();
+        }
+        else {
+            {
+                FrameProfiler::Scope scope(profiler, FramePhase::Axes);
+                drawAxes();
+            }
+            {
+                FrameProfiler::Scope scope(profiler, FramePhase::Operations);
+                drawOperations();
+            }
+            {
+                FrameProfiler::Scope scope(profiler, FramePhase::Labels);
+                drawLabels();
+                if (cursorActive) {
+                    drawTimeCursor();
+                }
+                drawScrollbar();
+                if (showLoadCurve) {
+                    drawLoadCurve();
+                }
+            }
+        }
+
+        if (showProfilerHud) {
+            drawProfilerHud();
+        }
+        if (!sourceStatusLines.empty()) {
+            drawSourceStatus();
+        }
+        if (replay) {
+            drawReplayBar();
+        }
+        else if (browsingHistory && historyRing && historyRing->contains(historyCursor)) {
+            drawHistoryStatus();
+        }
+        else if (diffActive && showDiffOverlay) {
+            drawDiffStatus();
+        }
+
+        {
+            FrameProfiler::Scope scope(profiler, FramePhase::Display);
+            window.display();
+        }
+        updateStats.recordFrameDisplayed(UpdatePipelineStats::Clock::now());
+    }
+    catch (const std::exception& e) {
+        ERROR("Error during drawing: " << e.what());
+        // 至少尝试清除窗口
+        try {
+            window.clear(sf::Color::White);
+            window.display();
+        }
+        catch (...) {
+            // 忽略二次错误
+        }
+    }
+
+    profiler.endFrame();
+}
+
+// 绘制性能HUD（文本由分析器预先格式化）
+template<typename TimeT>
+void BasicGanttChart<TimeT>::drawProfilerHud() {
+    const unsigned size = GanttConfig::FontConfig::STATUS_FONT_SIZE;
+    const float lineHeight = size + 4.0f;
+    const float x = leftMargin + 10;
+    const float y = topMargin + 5;
+    const size_t lineCount = profiler.getHudLineCount();
+    if (lineCount == 0) return;
+
+    shapeBatch.clear();
+    appendRect(x - 4, y - 2, 230, lineCount * lineHeight + 6, sf::Color(255, 255, 255, 220));
+    window.draw(shapeBatch);
+
+    for (size_t i = 0; i < lineCount; ++i) {
+        size_t length;
+        const char* line = profiler.getHudLine(i, length);
+        labelCache.appendText(line, length, size, x, y + i * lineHeight, sf::Color::Blue);
+    }
+    labelCache.flush(window);
+}
+
+// 绘制数据源状态（右上角，按最长一行确定背景宽度）
+template<typename TimeT>
+void BasicGanttChart<TimeT>::drawSourceStatus() {
+    const unsigned size = GanttConfig::FontConfig::STATUS_FONT_SIZE;
+    const float lineHeight = size + 4.0f;
+    float width = 0.0f;
+    for (const std::string& line : sourceStatusLines) {
+        float lineWidth, lineHeightMeasured;
+        labelCache.measure(line.c_str(), line.size(), size, lineWidth, lineHeightMeasured);
+        width = std::max(width, lineWidth);
+    }
+    const float x = window.getSize().x - rightMargin - width - 10;
+    const float y = topMargin + 5;
+
+    shapeBatch.clear();
+    appendRect(x - 4, y - 2, width + 8, sourceStatusLines.size() * lineHeight + 6, sf::Color(255, 255, 255, 220));
+    window.draw(shapeBatch);
+
+    for (size_t i = 0; i < sourceStatusLines.size(); ++i) {
+        const std::string& line = sourceStatusLines[i];
+        labelCache.appendText(line.c_str(), line.size(), size, x, y + i * lineHeight, sf::Color(0, 100, 0));
+    }
+    labelCache.flush(window);
+}
+
+// === 内存历史环 ===
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::enableHistory(size_t memoryBudgetBytes, size_t maxEntries) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    if (historyRing) {
+        historyRing->setLimits(memoryBudgetBytes, maxEntries);
+        return;
+    }
+    historyRing.reset(new BasicScheduleHistoryRing<TimeT>(memoryBudgetBytes, maxEntries));
+    browsingHistory = false;
+    if (!operations.empty()) {
+        historyRing->push(operations);
+    }
+    INFO("Schedule history enabled: up to " << maxEntries << " schedules, " << (memoryBudgetBytes >> 20) << " MB");
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::disableHistory() {
+    // 浏览中先回到最新的调度，避免关闭后停留在旧数据上
+    if (isBrowsingHistory()) {
+        stepHistory(std::numeric_limits<int>::max(), false);
+    }
+    std::lock_guard<std::mutex> lock(dataMutex);
+    historyRing.reset();
+    browsingHistory = false;
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::isBrowsingHistory() const {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    return browsingHistory;
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::deferToHistory(const View& view) {
+    if (!browsingHistory || !historyRing) return false;
+    historyRing->push(view);
+    return true;
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::deferToHistory(const Delta& delta) {
+    if (!browsingHistory || !historyRing) return false;
+    historyRing->pushDelta(delta);
+    return true;
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::stepHistory(int steps, bool immediate_draw) {
+    if (!isInitialized || steps == 0) return false;
+    const UpdatePipelineStats::Clock::time_point updateStart = UpdatePipelineStats::Clock::now();
+
+    size_t shown, count;
+    {
+        std::lock_guard<std::mutex> lock(dataMutex);
+        if (!historyRing || historyRing->empty() || replay) return false;
+        FrameProfiler::Scope updateScope(profiler, FramePhase::Update);
+
+        const size_t first = historyRing->getFirst();
+        const size_t last = historyRing->getLast();
+        // 浏览中的记录可能已被淘汰，此时只能整体跳转
+        const bool cursorValid = !browsingHistory || historyRing->contains(historyCursor);
+        const size_t current = !browsingHistory ? last : (cursorValid ? historyCursor : first);
+        const long long wanted = static_cast<long long>(current) + steps;
+        const size_t target = static_cast<size_t>(std::max(static_cast<long long>(first),
+            std::min(static_cast<long long>(last), wanted)));
+        if (cursorValid && target == current) return false;
+
+        // 相邻记录只应用一条增量，否则从最近的关键帧重建
+        const bool wasBrowsing = browsingHistory;
+        browsingHistory = true;
+        if (cursorValid && (target == current + 1 || target + 1 == current) &&
+            historyRing->getStepDelta(current, target, historyStep)) {
+            applyDeltaLocked(historyStep);
+        }
+        else {
+            std::vector<Operation> snapshot;
+            if (!historyRing->materialize(target, snapshot)) {
+                browsingHistory = wasBrowsing;
+                ERROR("Failed to restore schedule history record " << target);
+                return false;
+            }
+            ownedOperations.swap(snapshot);
+            operations = View::fromRecords(ownedOperations);
+            borrowedData = false;
+            borrowedSource.reset();
+        }
+
+        historyCursor = target;
+        refreshDerivedData(updateStart);
+        // 刷新完成后再恢复实时状态，回到最新一条时不会重复追加
+        browsingHistory = target != last;
+        shown = target - first + 1;
+        count = historyRing->size();
+    }
+
+    if (immediate_draw) {
+        draw();
+    }
+
+    INFO("Showing schedule history " << shown << "/" << count << (shown == count ? " (live)" : ""));
+    return true;
+}
+
+// 浏览历史时在轴标题左侧显示位置与内存用量
+template<typename TimeT>
+void BasicGanttChart<TimeT>::drawHistoryStatus() {
+    const size_t first = historyRing->getFirst();
+    char info[128];
+    int length = std::snprintf(info, sizeof(info), "History %zu/%zu  (%zu newer)  %.1f/%.0f MB  [, .] step  [L] live",
+        historyCursor - first + 1, historyRing->size(), historyRing->getLast() - historyCursor,
+        historyRing->getMemoryUsage() / 1048576.0, historyRing->getMemoryBudget() / 1048576.0);
+    labelCache.appendText(info, static_cast<size_t>(std::max(0, length)), GanttConfig::FontConfig::STATUS_FONT_SIZE,
+        leftMargin, window.getSize().y - 20.0f, sf::Color(150, 60, 0));
+    labelCache.flush(window);
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::showDiff(const View& before, bool immediate_draw) {
+    if (!isInitialized) {
+        ERROR("GanttChart not initialized. Call init() first.");
+        return false;
+    }
+
+    qm::ScheduleDiffCounts counts;
+    {
+        std::lock_guard<std::mutex> lock(dataMutex);
+        qm::ScheduleDiff diff;
+        qm::diffSchedules(before, operations, diff);
+        std::vector<DiffGhost> ghosts;
+        collectDiffGhosts(before, diff, ghosts);
+        setDiffLocked(diff, ghosts, operations, true);
+        counts = scheduleDiff.counts;
+    }
+
+    if (immediate_draw) {
+        draw();
+    }
+
+    INFO("Schedule diff: " << counts.changed << " changed, " << counts.added << " added, " << counts.removed << " removed");
+    return true;
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::updateWithDiff(const View& next, bool immediate_draw) {
+    using StatsClock = UpdatePipelineStats::Clock;
+    const StatsClock::time_point updateStart = StatsClock::now();
+
+    if (!isInitialized) {
+        ERROR("GanttChart not initialized. Call init() first.");
+        std::lock_guard<std::mutex> lock(dataMutex);
+        updateStats.recordDropped();
+        return false;
+    }
+
+    qm::ScheduleDiffCounts counts;
+    {
+        std::lock_guard<std::mutex> lock(dataMutex);
+        FrameProfiler::Scope updateScope(profiler, FramePhase::Update);
+        if (deferToHistory(next)) {
+            return true;
+        }
+
+        // 旧位置要在应用增量之前从当前数据中取出
+        qm::ScheduleDiff diff;
+        qm::diffSchedules(operations, next, diff);
+        std::vector<DiffGhost> ghosts;
+        collectDiffGhosts(operations, diff, ghosts);
+
+        Delta delta;
+        qm::scheduleDiffToDelta(diff, operations, next, delta);
+        applyDeltaLocked(delta);
+        refreshDerivedData(updateStart);
+
+        // 增量应用后的顺序与 next 不同，按键重新对齐
+        setDiffLocked(diff, ghosts, next, false);
+        counts = scheduleDiff.counts;
+    }
+
+    if (immediate_draw) {
+        draw();
+    }
+
+    INFO("Updated gantt chart with diff: " << counts.changed << " changed (" << counts.moved << " moved, "
+        << counts.shifted << " shifted, " << counts.resized << " resized), " << counts.added << " added, "
+        << counts.removed << " removed");
+    return true;
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::clearDiff() {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    clearDiffLocked();
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::clearDiffLocked() {
+    scheduleDiff.clear();
+    diffFlags.clear();
+    diffGhosts.clear();
+    diffActive = false;
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::setDiffOverlayVisible(bool visible) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    showDiffOverlay = visible;
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::getDiffCounts(qm::ScheduleDiffCounts& counts) const {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    if (!diffActive) return false;
+    counts = scheduleDiff.counts;
+    return true;
+}
+
+// 位置或时长变化、以及被删除的操作保留基准中的位置，用于绘制旧位置
+template<typename TimeT>
+void BasicGanttChart<TimeT>::collectDiffGhosts(const View& before, const qm::ScheduleDiff& diff,
+    std::vector<DiffGhost>& ghosts) const {
+    const std::uint8_t moved = qm::DiffMachine | qm::DiffStart | qm::DiffDuration | qm::DiffRemoved;
+    ghosts.clear();
+    for (const qm::OperationChange& change : diff.changes) {
+        if (change.flags & moved) {
+            ghosts.push_back({ before[change.before], change.flags });
+        }
+    }
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::setDiffLocked(qm::ScheduleDiff& diff, std::vector<DiffGhost>& ghosts, const View& after,
+    bool alignedToOperations) {
+    diffFlags.assign(operations.size(), 0);
+    if (alignedToOperations) {
+        for (const qm::OperationChange& change : diff.changes) {
+            if (change.after != qm::OperationChange::NO_INDEX) {
+                diffFlags[change.after] = change.flags;
+            }
+        }
+    }
+    else {
+        std::unordered_map<std::uint64_t, std::uint8_t, qm::KeyHash> flagsByKey;
+        flagsByKey.reserve(diff.changes.size());
+        for (const qm::OperationChange& change : diff.changes) {
+            if (change.after != qm::OperationChange::NO_INDEX) {
+                flagsByKey.emplace(qm::packKey(after.jobId[change.after], after.stage[change.after]), change.flags);
+            }
+        }
+        if (!flagsByKey.empty()) {
+            for (size_t i = 0; i < operations.size(); ++i) {
+                const auto found = flagsByKey.find(qm::packKey(operations.jobId[i], operations.stage[i]));
+                if (found != flagsByKey.end()) {
+                    diffFlags[i] = found->second;
+                }
+            }
+        }
+    }
+
+    std::swap(scheduleDiff, diff);
+    diffGhosts.swap(ghosts);
+    diffActive = true;
+}
+
+// 未变化的操作淡化；变化的操作按 新增 > 换机器 > 平移/时长 > 关键标记 的优先级选择描边颜色
+template<typename TimeT>
+void BasicGanttChart<TimeT>::applyDiffStyle(std::uint8_t flags, sf::Color& fill, sf::Color& outlineColor,
+    float& outline) const {
+    using Diff = GanttConfig::DiffConfig;
+    if (flags == 0) {
+        fill.a = static_cast<sf::Uint8>(Diff::DIM_ALPHA);
+        outlineColor.a = static_cast<sf::Uint8>(Diff::DIM_ALPHA);
+        return;
+    }
+
+    outline = static_cast<float>(Diff::OUTLINE_THICKNESS);
+    if (flags & qm::DiffAdded) {
+        outlineColor = sf::Color(Diff::ADDED_R, Diff::ADDED_G, Diff::ADDED_B);
+    }
+    else if (flags & qm::DiffMachine) {
+        outlineColor = sf::Color(Diff::MOVED_R, Diff::MOVED_G, Diff::MOVED_B);
+    }
+    else if (flags & (qm::DiffStart | qm::DiffDuration)) {
+        outlineColor = sf::Color(Diff::SHIFTED_R, Diff::SHIFTED_G, Diff::SHIFTED_B);
+    }
+    else {
+        outlineColor = sf::Color(Diff::CRITICAL_R, Diff::CRITICAL_G, Diff::CRITICAL_B);
+    }
+}
+
+// 旧位置画成半透明块，位于当前操作之下；所在机器已不在行索引中的跳过
+template<typename TimeT>
+void BasicGanttChart<TimeT>::appendDiffGhosts(int firstRow, int lastRow) {
+    using Diff = GanttConfig::DiffConfig;
+    const double windowWidth = window.getSize().x;
+    const sf::Color movedColor(Diff::MOVED_R, Diff::MOVED_G, Diff::MOVED_B, Diff::GHOST_ALPHA);
+    const sf::Color shiftedColor(Diff::SHIFTED_R, Diff::SHIFTED_G, Diff::SHIFTED_B, Diff::GHOST_ALPHA);
+    const sf::Color removedColor(128, 128, 128, Diff::GHOST_ALPHA);
+
+    for (const DiffGhost& entry : diffGhosts) {
+        const Operation& ghost = entry.operation;
+        const auto rowIt = std::lower_bound(rowMachines.begin(), rowMachines.end(), ghost.machine_id);
+        if (rowIt == rowMachines.end() || *rowIt != ghost.machine_id) continue;
+        const int line = getRowLine(static_cast<int>(rowIt - rowMachines.begin()));
+        if (line < firstRow || line > lastRow) continue;
+
+        const double startX = timeToX(ghost.start_time);
+        const double endX = timeToX(ghost.end_time);
+        if (startX > windowWidth || endX < 0.0) continue;
+        const float x = static_cast<float>(std::max(startX, -1.0));
+        const float width = std::max(1.0f, static_cast<float>(std::min(endX, windowWidth + 1.0)) - x);
+
+        const sf::Color& color = (entry.flags & qm::DiffRemoved) ? removedColor
+            : ((entry.flags & qm::DiffMachine) ? movedColor : shiftedColor);
+        appendRect(x, getRowY(line), width, barHeight, color);
+    }
+}
+
+// 差异统计显示在轴标题左侧（与历史浏览状态同一位置，二者不同时显示）
+template<typename TimeT>
+void BasicGanttChart<TimeT>::drawDiffStatus() {
+    const qm::ScheduleDiffCounts& counts = scheduleDiff.counts;
+    char info[192];
+    int length = std::snprintf(info, sizeof(info),
+        "Diff: %zu changed (%zu moved, %zu shifted, %zu resized, %zu critical)  %zu added  %zu removed  [V] overlay",
+        counts.changed, counts.moved, counts.shifted, counts.resized, counts.criticalChanged, counts.added, counts.removed);
+    labelCache.appendText(info, static_cast<size_t>(std::max(0, length)), GanttConfig::FontConfig::STATUS_FONT_SIZE,
+        leftMargin, window.getSize().y - 20.0f, sf::Color(110, 0, 140));
+    labelCache.flush(window);
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::setOccupancyHeatmap(const BasicOccupancyHeatmap<TimeT>& heatmap, bool immediate_draw) {
+    {
+        std::lock_guard<std::mutex> lock(dataMutex);
+        const int buckets = heatmap.getBucketCount();
+        const int maxLevel = GanttConfig::HeatmapConfig::COLOR_LEVELS - 1;
+        heatMachines = heatmap.getMachines();
+        heatLevels.resize(heatMachines.size() * buckets);
+        for (size_t row = 0; row < heatMachines.size(); ++row) {
+            std::uint8_t* levels = heatLevels.data() + row * buckets;
+            for (int b = 0; b < buckets; ++b) {
+                levels[b] = static_cast<std::uint8_t>(std::lround(heatmap.getOccupancy(row, b) * maxLevel));
+            }
+        }
+        heatStartTime = static_cast<double>(heatmap.getStartTime());
+        heatBucketWidth = (static_cast<double>(heatmap.getEndTime()) - heatStartTime) / buckets;
+        heatBuckets = heatBucketWidth > 0.0 ? buckets : 0;
+    }
+
+    if (immediate_draw) {
+        draw();
+    }
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::clearOccupancyHeatmap() {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    heatMachines.clear();
+    heatLevels.clear();
+    heatBuckets = 0;
+}
+
+// 浅黄 -> 橙 -> 深红，级别 0 不绘制
+template<typename TimeT>
+sf::Color BasicGanttChart<TimeT>::heatColor(int level) {
+    static const float stops[3][3] = { { 255, 255, 178 }, { 253, 141, 60 }, { 189, 0, 38 } };
+    const float t = static_cast<float>(level) / (GanttConfig::HeatmapConfig::COLOR_LEVELS - 1) * 2.0f;
+    const int i = std::min(1, static_cast<int>(t));
+    const float f = t - i;
+    return sf::Color(
+        static_cast<sf::Uint8>(stops[i][0] + (stops[i + 1][0] - stops[i][0]) * f),
+        static_cast<sf::Uint8>(stops[i][1] + (stops[i + 1][1] - stops[i][1]) * f),
+        static_cast<sf::Uint8>(stops[i][2] + (stops[i + 1][2] - stops[i][2]) * f),
+        static_cast<sf::Uint8>(GanttConfig::HeatmapConfig::ALPHA));
+}
+
+// 每个可见行占满整个行距，只遍历可见的桶，相邻同级的桶合并为一个矩形
+template<typename TimeT>
+void BasicGanttChart<TimeT>::appendHeatmap(int firstRow, int lastRow) {
+    const double windowWidth = window.getSize().x;
+    const int firstBucket = std::max(0, static_cast<int>(std::floor((xToTime(0.0) - heatStartTime) / heatBucketWidth)));
+    const int lastBucket = std::min(heatBuckets - 1,
+        static_cast<int>(std::floor((xToTime(windowWidth) - heatStartTime) / heatBucketWidth)));
+    if (firstBucket > lastBucket) return;
+
+    for (int line = firstRow; line <= lastRow; ++line) {
+        const int row = getLineRow(line);
+        if (row < 0) continue;
+        const auto it = std::lower_bound(heatMachines.begin(), heatMachines.end(), rowMachines[row]);
+        if (it == heatMachines.end() || *it != rowMachines[row]) continue;
+        const std::uint8_t* levels = heatLevels.data() + static_cast<size_t>(it - heatMachines.begin()) * heatBuckets;
+        const float y = getRowY(line) - barSpacing / 2;
+
+        int runStart = firstBucket;
+        for (int b = firstBucket; b <= lastBucket + 1; ++b) {
+            if (b <= lastBucket && levels[b] == levels[runStart]) continue;
+            if (levels[runStart] > 0) {
+                const double x0 = std::max(-1.0, timeToX(heatStartTime + runStart * heatBucketWidth));
+                const double x1 = std::min(windowWidth + 1.0, timeToX(heatStartTime + b * heatBucketWidth));
+                appendRect(static_cast<float>(x0), y, static_cast<float>(std::max(1.0, x1 - x0)), getRowPitch(),
+                    heatColor(levels[runStart]));
+            }
+            runStart = b;
+        }
+    }
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::setLoadCurveVisible(bool visible) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    if (visible == showLoadCurve) return;
+    showLoadCurve = visible;
+
+    // 曲线区占用底部边距（见 getBottomMargin），与 applyLayoutConfig 一样只重新布局
+    if (!visible) {
+        loadProfile.clear();
+    }
+    else if (!operations.empty()) {
+        loadProfile.build(operations, rowOffsets, rowOperations);
+    }
+    if (!operations.empty()) {
+        int firstVisibleRow = getFirstVisibleRow();
+        updateLayout();
+        updateTimeScale();
+        scrollToRow(firstVisibleRow);
+        clampView();
+    }
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::isLoadCurveVisible() const {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    return showLoadCurve;
+}
+
+// 把每个像素列的值画成从基线向上的柱，相邻同高的列合并为一个矩形
+template<typename TimeT>
+void BasicGanttChart<TimeT>::appendLoadArea(const std::vector<float>& values, float left, float baseline, float scale,
+    sf::Color color) {
+    size_t runStart = 0;
+    float runHeight = 0.0f;
+    for (size_t i = 0; i <= values.size(); ++i) {
+        float height = -1.0f;
+        if (i < values.size()) {
+            // 非零负载至少显示 1 像素
+            height = values[i] > 0.0f ? std::max(1.0f, std::round(values[i] * scale)) : 0.0f;
+            if (i > 0 && height == runHeight) continue;
+        }
+        if (i > 0 && runHeight > 0.0f) {
+            appendRect(left + runStart, baseline - runHeight, static_cast<float>(i - runStart), runHeight, color);
+        }
+        runStart = i;
+        runHeight = height;
+    }
+}
+
+// 负载曲线位于时间轴下方，与图表同宽；两条曲线共用纵轴（最大值为两者峰值的较大者）
+template<typename TimeT>
+void BasicGanttChart<TimeT>::drawLoadCurve() {
+    using Load = GanttConfig::LoadCurveConfig;
+    const float left = leftMargin;
+    const float width = window.getSize().x - leftMargin - rightMargin;
+    const float top = window.getSize().y - getBottomMargin() + Load::STRIP_OFFSET;
+    const float height = Load::STRIP_HEIGHT;
+    if (width < 1.0f) return;
+
+    const size_t columns = static_cast<size_t>(width);
+    loadBusy.resize(columns);
+    loadCritical.resize(columns);
+    loadProfile.resample(xToTime(left), xToTime(left + columns), columns, loadBusy.data(), loadCritical.data());
+
+    const int peak = std::max(1, std::max(loadProfile.getPeakBusy(), loadProfile.getPeakCritical()));
+    const float scale = height / peak;
+
+    shapeBatch.clear();
+    appendRect(left, top, width, height, sf::Color(245, 245, 245));
+    appendLoadArea(loadBusy, left, top + height, scale, sf::Color(Load::BUSY_R, Load::BUSY_G, Load::BUSY_B));
+    appendLoadArea(loadCritical, left, top + height, scale,
+        sf::Color(Load::CRITICAL_R, Load::CRITICAL_G, Load::CRITICAL_B, Load::CRITICAL_A));
+    appendRect(left, top + height, width, 1, sf::Color::Black);
+    window.draw(shapeBatch);
+
+    // 左侧边距内标注峰值
+    const unsigned size = GanttConfig::FontConfig::STATUS_FONT_SIZE;
+    char info[32];
+    labelCache.appendText("Load", 4, size, 5, top, sf::Color::Black);
+    int length = std::snprintf(info, sizeof(info), "busy %d", loadProfile.getPeakBusy());
+    labelCache.appendText(info, static_cast<size_t>(std::max(0, length)), size, 5, top + size + 4,
+        sf::Color(Load::BUSY_R, Load::BUSY_G, Load::BUSY_B));
+    length = std::snprintf(info, sizeof(info), "crit %d", loadProfile.getPeakCritical());
+    labelCache.appendText(info, static_cast<size_t>(std::max(0, length)), size, 5, top + 2 * (size + 4),
+        sf::Color(Load::CRITICAL_R, Load::CRITICAL_G, Load::CRITICAL_B));
+    labelCache.flush(window);
+}
+
+// 回放进度条位于底部边距内（时间刻度标签与轴标题之间），与图表同宽
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::getReplayBarRect(sf::FloatRect& bar) const {
+    if (!replay || replay->getRecordCount() == 0) return false;
+    const float height = GanttConfig::HistoryConfig::REPLAY_BAR_HEIGHT;
+    bar = sf::FloatRect(leftMargin, window.getSize().y - getBottomMargin() + 24,
+        window.getSize().x - leftMargin - rightMargin, height);
+    return bar.width > 0;
+}
+
+// 按横坐标设置播放位置，实际跳转在 updateReplay 中执行，拖动时不会逐像素解码
+template<typename TimeT>
+void BasicGanttChart<TimeT>::dragReplayBarTo(float x) {
+    sf::FloatRect bar;
+    if (!getReplayBarRect(bar)) return;
+
+    float ratio = std::max(0.0f, std::min(1.0f, (x - bar.left) / bar.width));
+    replayPosition = std::floor(ratio * (replay->getRecordCount() - 1) + 0.5);
+    replayPlaying = false;
+    replaySeekPending = true;
+}
+
+// 绘制回放进度条，当前记录信息写在轴标题左侧
+template<typename TimeT>
+void BasicGanttChart<TimeT>::drawReplayBar() {
+    sf::FloatRect bar;
+    if (!getReplayBarRect(bar)) return;
+
+    const size_t count = replay->getRecordCount();
+    const float ratio = count > 1 ? static_cast<float>(replayRecord) / (count - 1) : 1.0f;
+    const float thumbX = bar.left + bar.width * ratio;
+
+    shapeBatch.clear();
+    appendRect(bar.left, bar.top, bar.width, bar.height, sf::Color(230, 230, 230));
+    appendRect(bar.left, bar.top, thumbX - bar.left, bar.height, sf::Color(120, 160, 220));
+    appendRect(thumbX - 2, bar.top - 2, 4, bar.height + 4, sf::Color(60, 60, 60));
+    window.draw(shapeBatch);
+
+    const ScheduleHistoryEntry& entry = replay->getEntry(replayRecord);
+    char info[128];
+    int length = std::snprintf(info, sizeof(info), "Record %zu/%zu  iteration %lld  t=%.3fs  %gx  %s",
+        replayRecord + 1, count, entry.iteration, entry.timestampUs / 1e6, replaySpeed,
+        replayPlaying ? "playing" : "paused");
+    const unsigned size = GanttConfig::FontConfig::STATUS_FONT_SIZE;
+    labelCache.appendText(info, static_cast<size_t>(std::max(0, length)), size, bar.left, window.getSize().y - 20.0f, sf::Color(60, 60, 60));
+    labelCache.flush(window);
+}
+
+// 重置调试标志
+template<typename TimeT>
+void BasicGanttChart<TimeT>::resetDebugFlag() {
+    debugOutputShown = false;
+}
+
+// 处理鼠标滚轮缩放（使用配置参数），以图表中心为锚点
+template<typename TimeT>
+void BasicGanttChart<TimeT>::handleMouseWheel(float delta) {
+    float centerX = leftMargin + (window.getSize().x - leftMargin - rightMargin) / 2.0f;
+    handleZoom(delta, centerX);
+}
+
+// 以鼠标位置为锚点缩放
+template<typename TimeT>
+void BasicGanttChart<TimeT>::handleMouseWheel(float delta, float mouseX) {
+    handleZoom(delta, mouseX);
+}
+
+// 处理键盘平移（使用配置参数）
+template<typename TimeT>
+void BasicGanttChart<TimeT>::handleKeyboard() {
+    if (!GanttConfig::InteractionConfig::ENABLE_KEYBOARD_PAN) return;
+
+    float panSpeed = GanttConfig::ViewConfig::PAN_SPEED;
+
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left) || sf::Keyboard::isKeyPressed(sf::Keyboard::A)) {
+        handlePan(panSpeed, 0);
+    }
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right) || sf::Keyboard::isKeyPressed(sf::Keyboard::D)) {
+        handlePan(-panSpeed, 0);
+    }
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up) || sf::Keyboard::isKeyPressed(sf::Keyboard::W)) {
+        handlePan(0, panSpeed);
+    }
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down) || sf::Keyboard::isKeyPressed(sf::Keyboard::S)) {
+        handlePan(0, -panSpeed);
+    }
+}
+
+// 重置视图（使用配置默认值）
+template<typename TimeT>
+void BasicGanttChart<TimeT>::resetView() {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    zoomLevel = GanttConfig::ViewConfig::DEFAULT_ZOOM_LEVEL;
+    viewStartTime = minTime;
+    offsetY = 0.0f;
+    if (!operations.empty()) {
+        updateTimeScale();
+        scrollToRow(0);
+    }
+    INFO("View reset to default");
+}
+
+// 处理SFML事件
+template<typename TimeT>
+void BasicGanttChart<TimeT>::handleEvent(const sf::Event& event) {
+    switch (event.type) {
+    case sf::Event::MouseWheelScrolled:
+        handleMouseWheel(event.mouseWheelScroll.delta, static_cast<float>(event.mouseWheelScroll.x));
+        break;
+
+    case sf::Event::KeyPressed:
+        switch (event.key.code) {
+        case sf::Keyboard::Space:
+            resetView();
+            break;
+        case sf::Keyboard::R:
+            resetDebugFlag();
+            INFO("Debug output flag reset. Next draw will show debug info.");
+            break;
+        case sf::Keyboard::D:
+            INFO("=== Manual Debug Output Requested ===");
+            printLoadedData();
+            break;
+        case sf::Keyboard::F3:
+            // 切换性能HUD，显示时自动启用计时
+            showProfilerHud = !showProfilerHud;
+            if (showProfilerHud) profiler.setEnabled(true);
+            break;
+        case sf::Keyboard::PageUp:
+            scrollRows(-getVisibleRowCapacity());
+            break;
+        case sf::Keyboard::PageDown:
+            scrollRows(getVisibleRowCapacity());
+            break;
+        case sf::Keyboard::Home:
+            scrollRows(-getRowCount());
+            break;
+        case sf::Keyboard::End:
+            scrollRows(getRowCount());
+            break;
+        case sf::Keyboard::P:
+            // 回放：播放/暂停
+            if (isReplaying()) {
+                bool playing;
+                {
+                    std::lock_guard<std::mutex> lock(dataMutex);
+                    playing = replayPlaying;
+                }
+                setReplayPlaying(!playing);
+            }
+            break;
+        case sf::Keyboard::V: {
+            // 差异叠加层：显示/隐藏
+            std::lock_guard<std::mutex> lock(dataMutex);
+            showDiffOverlay = !showDiffOverlay;
+            break;
+        }
+        case sf::Keyboard::H: {
+            // 占用热力图：显示/隐藏
+            std::lock_guard<std::mutex> lock(dataMutex);
+            showHeatmap = !showHeatmap;
+            break;
+        }
+        case sf::Keyboard::T: {
+            // 时间游标：显示/隐藏，显示时放在图表中央
+            std::lock_guard<std::mutex> lock(dataMutex);
+            cursorActive = !cursorActive;
+            draggingCursor = false;
+            if (cursorActive) {
+                cursorTime = xToTime(leftMargin + (window.getSize().x - leftMargin - rightMargin) / 2.0);
+            }
+            break;
+        }
+        case sf::Keyboard::G: {
+            // 空闲区间底纹：显示/隐藏
+            bool visible;
+            {
+                std::lock_guard<std::mutex> lock(dataMutex);
+                visible = showIdleGaps;
+            }
+            setIdleGapsVisible(!visible);
+            break;
+        }
+        case sf::Keyboard::Equal:
+            // 机器分组：全部展开
+            setAllGroupsExpanded(true);
+            break;
+        case sf::Keyboard::Hyphen:
+            // 机器分组：全部折叠
+            setAllGroupsExpanded(false);
+            break;
+        case sf::Keyboard::U:
+            // 负载曲线：显示/隐藏
+            setLoadCurveVisible(!isLoadCurveVisible());
+            break;
+        case sf::Keyboard::L:
+            // 内存历史：回到最新的调度
+            stepHistory(std::numeric_limits<int>::max(), false);
+            break;
+        case sf::Keyboard::LBracket:
+        case sf::Keyboard::RBracket: {
+            // 回放：减速/加速一倍
+            bool faster = event.key.code == sf::Keyboard::RBracket;
+            double speed;
+            {
+                std::lock_guard<std::mutex> lock(dataMutex);
+                speed = replaySpeed;
+            }
+            setReplaySpeed(faster ? speed * 2.0 : speed / 2.0);
+            break;
+        }
+        case sf::Keyboard::Comma:
+        case sf::Keyboard::Period: {
+            // 未回放时在内存历史中单步
+            if (!isReplaying()) {
+                stepHistory(event.key.code == sf::Keyboard::Period ? 1 : -1, false);
+                break;
+            }
+            // 回放：单步后退/前进一条记录（由 updateReplay 执行跳转）
+            std::lock_guard<std::mutex> lock(dataMutex);
+            if (replay) {
+                size_t last = replay->getRecordCount() - 1;
+                size_t target = event.key.code == sf::Keyboard::Period ? std::min(last, replayRecord + 1)
+                    : (replayRecord > 0 ? replayRecord - 1 : 0);
+                replayPlaying = false;
+                replayPosition = static_cast<double>(target);
+                replaySeekPending = true;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+        break;
+
+    case sf::Event::MouseButtonPressed:
+        if (event.mouseButton.button == sf::Mouse::Left) {
+            handleMousePress(static_cast<float>(event.mouseButton.x), static_cast<float>(event.mouseButton.y));
+        }
+        break;
+
+    case sf::Event::MouseButtonReleased:
+        if (event.mouseButton.button == sf::Mouse::Left) {
+            std::lock_guard<std::mutex> lock(dataMutex);
+            draggingScrollbar = false;
+            draggingReplayBar = false;
+            draggingCursor = false;
+        }
+        break;
+
+    case sf::Event::MouseMoved: {
+        // 拖动状态与按下/释放处理一样在锁内读取
+        std::lock_guard<std::mutex> lock(dataMutex);
+        if (draggingScrollbar) {
+            dragScrollbarTo(static_cast<float>(event.mouseMove.y));
+        }
+        else if (draggingReplayBar) {
+            dragReplayBarTo(static_cast<float>(event.mouseMove.x));
+        }
+        else if (draggingCursor) {
+            const float chartRight = window.getSize().x - rightMargin;
+            cursorTime = xToTime(std::max(leftMargin, std::min(chartRight, static_cast<float>(event.mouseMove.x))));
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+// 处理鼠标左键：滚动条拖动/翻页，或拾取操作
+template<typename TimeT>
+void BasicGanttChart<TimeT>::handleMousePress(float x, float y) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+
+    // 回放进度条：点击或拖动跳转
+    sf::FloatRect replayBar;
+    if (getReplayBarRect(replayBar) &&
+        sf::FloatRect(replayBar.left, replayBar.top - 4, replayBar.width, replayBar.height + 8).contains(x, y)) {
+        draggingReplayBar = true;
+        dragReplayBarTo(x);
+        return;
+    }
+
+    sf::FloatRect track, thumb;
+    if (getScrollbarRects(track, thumb) && track.contains(x, y)) {
+        if (thumb.contains(x, y)) {
+            draggingScrollbar = true;
+            scrollbarGrabOffset = y - thumb.top;
+        }
+        else {
+            // 点击滑块外的轨道：翻一页
+            int page = getVisibleRowCapacity();
+            scrollToRow(getFirstVisibleRow() + (y < thumb.top ? -page : page));
+        }
+        return;
+    }
+
+    // 分组行：点击（包括左侧标签）展开/折叠
+    if (!displayLines.empty() && y >= topMargin && y <= window.getSize().y - getBottomMargin()) {
+        const int line = static_cast<int>(std::floor((y - topMargin - offsetY) / getRowPitch()));
+        if (line >= 0 && line < getRowCount() && getLineRow(line) < 0) {
+            const int group = -getLineRow(line) - 1;
+            groupExpanded[group] = !groupExpanded[group];
+            applyDisplayLines();
+            return;
+        }
+    }
+
+    // 时间游标显示时，在图表内按下即把游标移到该处并开始拖动
+    if (cursorActive && x >= leftMargin && x <= window.getSize().x - rightMargin &&
+        y >= topMargin && y <= window.getSize().y - getBottomMargin()) {
+        cursorTime = xToTime(x);
+        draggingCursor = true;
+        return;
+    }
+
+    Operation picked;
+    if (pickOperationLocked(x, y, picked)) {
+        INFO("Picked J" << picked.job_id << "-" << picked.stage << " on M" << picked.machine_id
+            << " [" << picked.start_time << "-" << picked.end_time << "]"
+            << (picked.is_critical ? " (critical)" : ""));
+    }
+}
+
+// 拖动滑块：按滑块位置换算为首行
+template<typename TimeT>
+void BasicGanttChart<TimeT>::dragScrollbarTo(float y) {
+    sf::FloatRect track, thumb;
+    if (!getScrollbarRects(track, thumb)) return;
+
+    float travel = track.height - thumb.height;
+    int maxFirstRow = std::max(0, getRowCount() - getVisibleRowCapacity());
+    float ratio = travel > 0 ? (y - scrollbarGrabOffset - track.top) / travel : 0.0f;
+    ratio = std::max(0.0f, std::min(1.0f, ratio));
+    scrollToRow(static_cast<int>(std::lround(ratio * maxFirstRow)));
+}
+
+// 计算滚动条轨道和滑块位置；行数不超过可见容量时无滚动条
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::getScrollbarRects(sf::FloatRect& track, sf::FloatRect& thumb) const {
+    int rowCount = getRowCount();
+    int capacity = getVisibleRowCapacity();
+    if (rowCount <= capacity) return false;
+
+    const float width = GanttConfig::LayoutConfig::SCROLLBAR_WIDTH;
+    track = sf::FloatRect(window.getSize().x - rightMargin + (rightMargin - width) / 2, topMargin,
+        width, window.getSize().y - topMargin - getBottomMargin());
+
+    float thumbHeight = std::max(GanttConfig::LayoutConfig::MIN_SCROLLBAR_THUMB,
+        track.height * capacity / rowCount);
+    int maxFirstRow = rowCount - capacity;
+    float ratio = static_cast<float>(std::max(0, std::min(maxFirstRow, getFirstVisibleRow()))) / maxFirstRow;
+    thumb = sf::FloatRect(track.left, track.top + (track.height - thumbHeight) * ratio, width, thumbHeight);
+    return true;
+}
+
+// 绘制滚动条
+template<typename TimeT>
+void BasicGanttChart<TimeT>::drawScrollbar() {
+    sf::FloatRect track, thumb;
+    if (!getScrollbarRects(track, thumb)) return;
+
+    shapeBatch.clear();
+    appendRect(track.left, track.top, track.width, track.height, sf::Color(230, 230, 230));
+    appendRect(thumb.left, thumb.top, thumb.width, thumb.height,
+        draggingScrollbar ? sf::Color(110, 110, 110) : sf::Color(160, 160, 160));
+    window.draw(shapeBatch);
+}
+
+// === 查询接口 ===
+
+template<typename TimeT>
+size_t BasicGanttChart<TimeT>::getOperationCount() const {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    return operations.size();
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::hasOverlaps() const {
+    std::lock_guard<std::mutex> lock(dataMutex);
+
+    if (operations.empty()) return false;
+
+    // 按机器分组检查重叠
+    std::map<int, std::vector<Operation>> machineOps;
+    for (const auto& op : operations) {
+        machineOps[op.machine_id].push_back(op);
+    }
+
+    for (auto& pair : machineOps) {
+        auto& ops = pair.second;
+        std::sort(ops.begin(), ops.end(), [](const Operation& a, const Operation& b) {
+            return a.start_time < b.start_time;
+            });
+
+        for (size_t i = 0; i + 1 < ops.size(); ++i) {
+            if (ops[i].end_time > ops[i + 1].start_time) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::pickOperation(float x, float y, Operation& result) const {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    return pickOperationLocked(x, y, result);
+}
+
+// 命中测试：由Y直接换算行号，只在该行内按时间查找
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::pickOperationLocked(float x, float y, Operation& result) const {
+    if (operations.empty() || x < leftMargin || y < topMargin ||
+        y > window.getSize().y - getBottomMargin()) {
+        return false;
+    }
+
+    float rowPosition = (y - topMargin - offsetY) / getRowPitch();
+    int line = static_cast<int>(std::floor(rowPosition));
+    if (line < 0 || line >= getRowCount()) return false;
+    if ((rowPosition - line) * getRowPitch() > barHeight) return false; // 落在行间距上
+    const int row = getLineRow(line);
+    if (row < 0) return false; // 分组行
+
+    // 与绘制一致：窄于1像素的操作按1像素宽处理
+    double time = xToTime(x);
+    double minWidth = 1.0 / timeScale;
+    double maxDuration = std::max<double>(rowMaxDuration[row], minWidth);
+
+    // 行内按开始时间排序：从最后一个开始时间不晚于time的操作向前查找（后绘制的在上层）
+    auto begin = rowOperations.begin() + rowOffsets[row];
+    auto end = rowOperations.begin() + rowOffsets[row + 1];
+    auto it = std::upper_bound(begin, end, time, [this](double t, int index) {
+        return t < operations.startTime[index];
+        });
+
+    while (it != begin) {
+        --it;
+        const auto& op = operations[*it];
+        if (op.start_time + maxDuration <= time) break; // 更早开始的操作不可能覆盖 time
+        if (time < std::max<double>(op.end_time, op.start_time + minWidth)) {
+            result = op;
+            return true;
+        }
+    }
+    return false;
+}
+
+// rowMaxEnd 行内单调不减：之前的操作都在 from 之前结束；按开始时间二分得到右端
+template<typename TimeT>
+void BasicGanttChart<TimeT>::getRowCandidates(int row, double from, double to, bool closed, int& first, int& last) const {
+    const auto maxEndBegin = rowMaxEnd.begin() + rowOffsets[row];
+    const auto maxEndEnd = rowMaxEnd.begin() + rowOffsets[row + 1];
+    first = rowOffsets[row] + static_cast<int>(std::upper_bound(maxEndBegin, maxEndEnd, from,
+        [](double t, TimeT end) { return t < end; }) - maxEndBegin);
+
+    const auto begin = rowOperations.begin() + first;
+    const auto end = rowOperations.begin() + rowOffsets[row + 1];
+    const auto it = closed
+        ? std::upper_bound(begin, end, to, [this](double t, int index) { return t < operations.startTime[index]; })
+        : std::lower_bound(begin, end, to, [this](int index, double t) { return operations.startTime[index] < t; });
+    last = static_cast<int>(it - rowOperations.begin());
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::collectOperationsLocked(double from, double to, bool closed,
+    std::vector<Operation>& result) const {
+    for (int row = 0; row < static_cast<int>(rowMachines.size()); ++row) {
+        int first, last;
+        getRowCandidates(row, from, to, closed, first, last);
+        for (int k = first; k < last; ++k) {
+            const int index = rowOperations[k];
+            if (from < operations.endTime[index]) {
+                result.push_back(operations[index]);
+            }
+        }
+    }
+}
+
+template<typename TimeT>
+std::vector<typename BasicGanttChart<TimeT>::Operation> BasicGanttChart<TimeT>::operationsAt(TimeT t) const {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    std::vector<Operation> result;
+    collectOperationsLocked(static_cast<double>(t), static_cast<double>(t), true, result);
+    return result;
+}
+
+template<typename TimeT>
+std::vector<typename BasicGanttChart<TimeT>::Operation> BasicGanttChart<TimeT>::operationsIn(TimeT t0, TimeT t1) const {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    std::vector<Operation> result;
+    collectOperationsLocked(static_cast<double>(t0), static_cast<double>(t1), !(t0 < t1), result);
+    return result;
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::setTimeCursor(TimeT t) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    cursorTime = static_cast<double>(t);
+    cursorActive = true;
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::clearTimeCursor() {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    cursorActive = false;
+    draggingCursor = false;
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::getTimeCursor(TimeT& t) const {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    if (!cursorActive) return false;
+    t = static_cast<TimeT>(cursorTime);
+    return true;
+}
+
+// 游标线与运行中操作的高亮画在操作之上；面板只列出可见行，代价与可见行数成正比
+template<typename TimeT>
+void BasicGanttChart<TimeT>::drawTimeCursor() {
+    using Cursor = GanttConfig::CursorConfig;
+    const sf::Color lineColor(Cursor::LINE_R, Cursor::LINE_G, Cursor::LINE_B);
+    const float chartBottom = window.getSize().y - getBottomMargin();
+    const float chartRight = window.getSize().x - rightMargin;
+    const double clipLeft = leftMargin;
+    const double clipRight = chartRight;
+
+    int firstRow, lastRow;
+    getVisibleRows(firstRow, lastRow);
+
+    int visibleMachines = 0;
+    for (int line = firstRow; line <= lastRow; ++line) {
+        if (getLineRow(line) >= 0) ++visibleMachines;
+    }
+
+    const unsigned size = GanttConfig::FontConfig::STATUS_FONT_SIZE;
+    const float lineHeight = size + 4.0f;
+    const int listed = std::max(0, std::min(visibleMachines, static_cast<int>(Cursor::PANEL_MAX_LINES)));
+    const float panelX = chartRight - Cursor::PANEL_WIDTH - 5;
+    const float panelY = topMargin + 5;
+
+    shapeBatch.clear();
+    appendRect(panelX, panelY, Cursor::PANEL_WIDTH, lineHeight * (listed + 2) + 6, sf::Color(255, 255, 255, 220));
+
+    char info[128];
+    int busyRows = 0;
+    int listedCount = 0;
+    for (int line = firstRow; line <= lastRow; ++line) {
+        const int row = getLineRow(line);
+        if (row < 0) continue;
+        int first, last;
+        getRowCandidates(row, cursorTime, cursorTime, true, first, last);
+        const int queued = rowOffsets[row + 1] - last;
+
+        // 同一机器上可能有多个重叠的操作，面板只列出最后开始的一个
+        int running = -1;
+        for (int k = first; k < last; ++k) {
+            const int index = rowOperations[k];
+            if (cursorTime < operations.endTime[index]) {
+                running = index;
+                const double startX = std::max(clipLeft, timeToX(operations.startTime[index]));
+                const double endX = std::min(clipRight, timeToX(operations.endTime[index]));
+                appendRect(static_cast<float>(startX), getRowY(line) - 1, static_cast<float>(std::max(1.0, endX - startX)),
+                    barHeight + 2, sf::Color(lineColor.r, lineColor.g, lineColor.b, Cursor::HIGHLIGHT_A));
+            }
+        }
+        if (running >= 0) ++busyRows;
+        if (listedCount >= listed) continue;
+        ++listedCount;
+
+        int length;
+        if (running >= 0) {
+            const auto& op = operations[running];
+            length = std::snprintf(info, sizeof(info), "M%d  J%d-%d  [%.10g - %.10g]%s  queued %d", op.machine_id,
+                op.job_id, op.stage, static_cast<double>(op.start_time), static_cast<double>(op.end_time),
+                op.is_critical ? " *" : "", queued);
+        }
+        else {
+            length = std::snprintf(info, sizeof(info), "M%d  idle  queued %d", rowMachines[row], queued);
+        }
+        labelCache.appendText(info, static_cast<size_t>(std::max(0, length)), size, panelX + 5,
+            panelY + 3 + lineHeight * listedCount, running >= 0 ? sf::Color::Black : sf::Color(120, 120, 120));
+    }
+
+    const double x = timeToX(cursorTime);
+    if (x >= clipLeft && x <= clipRight) {
+        appendRect(static_cast<float>(x) - 1, topMargin, 2, chartBottom - topMargin, lineColor);
+    }
+    window.draw(shapeBatch);
+
+    int length = std::snprintf(info, sizeof(info), "t = %.10g   busy %d / %d visible machines", cursorTime, busyRows,
+        visibleMachines);
+    labelCache.appendText(info, static_cast<size_t>(std::max(0, length)), size, panelX + 5, panelY + 3, lineColor);
+    if (visibleMachines > listed) {
+        length = std::snprintf(info, sizeof(info), "... %d more rows", visibleMachines - listed);
+        labelCache.appendText(info, static_cast<size_t>(std::max(0, length)), size, panelX + 5,
+            panelY + 3 + lineHeight * (listed + 1), sf::Color(120, 120, 120));
+    }
+    labelCache.flush(window);
 }
 
-// źƽƿƣʹò
-void GanttChart::handleZoom(float delta) {
-    float oldZoom = zoomLevel;
-    zoomLevel = std::max(GanttConfig::ViewConfig::MIN_ZOOM_LEVEL,
-        std::min(GanttConfig::ViewConfig::MAX_ZOOM_LEVEL,
-            zoomLevel + delta * GanttConfig::ViewConfig::ZOOM_STEP));
-
-    if (zoomLevel != oldZoom) {
-        std::lock_guard<std::mutex> lock(dataMutex);
-        calculateRanges();
-        std::cout << "Zoom level: " << zoomLevel << std::endl;
+template<typename TimeT>
+void BasicGanttChart<TimeT>::setIdleGapIndexEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    if (enabled == gapIndexEnabled) return;
+    gapIndexEnabled = enabled;
+    if (enabled) {
+        gapIndex.build(operations, rowOffsets, rowOperations);
+    }
+    else {
+        gapIndex.clear();
+        showIdleGaps = false;
     }
 }
 
-void GanttChart::handlePan(float deltaX, float deltaY) {
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::findFirstFit(int machineId, TimeT duration, TimeT t0, TimeT t1, GapFit& fit) const {
     std::lock_guard<std::mutex> lock(dataMutex);
-
-    // õƽٶ
-    float adjustedDeltaX = deltaX * GanttConfig::ViewConfig::ZOOM_ADJUSTED_PAN_FACTOR / zoomLevel;
-    float adjustedDeltaY = deltaY * GanttConfig::ViewConfig::ZOOM_ADJUSTED_PAN_FACTOR / zoomLevel;
-
-    offsetX += adjustedDeltaX;
-    offsetY += adjustedDeltaY;
-
-    // ƽƷΧã
-    if (GanttConfig::ViewConfig::ENABLE_VIEW_CLAMPING && !operations.empty()) {
-        float maxOffsetX = std::max(0.0f, (maxTime - minTime) * timeScale - (window.getSize().x - leftMargin - rightMargin));
-        float maxOffsetY = std::max(0.0f, (maxMachine - minMachine + 1) * (barHeight + barSpacing) - (window.getSize().y - topMargin - bottomMargin));
-
-        offsetX = std::max(-maxOffsetX - GanttConfig::ViewConfig::VIEW_CLAMP_MARGIN,
-            std::min(GanttConfig::ViewConfig::VIEW_CLAMP_MARGIN, offsetX));
-        offsetY = std::max(-maxOffsetY - GanttConfig::ViewConfig::VIEW_CLAMP_MARGIN,
-            std::min(GanttConfig::ViewConfig::VIEW_CLAMP_MARGIN, offsetY));
-    }
+    return gapIndexEnabled && gapIndex.firstFit(machineId, duration, t0, t1, fit);
 }
 
-// Ƹͼ
-void GanttChart::draw() {
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::findFirstFit(TimeT duration, TimeT t0, TimeT t1, GapFit& fit) const {
     std::lock_guard<std::mutex> lock(dataMutex);
+    return gapIndexEnabled && gapIndex.firstFit(duration, t0, t1, fit);
+}
 
-    // Ӵ
-    try {
-        window.clear(sf::Color::White);
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::findBestFit(TimeT duration, TimeT t0, TimeT t1, GapFit& fit) const {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    return gapIndexEnabled && gapIndex.bestFit(duration, t0, t1, fit);
+}
 
-        if (operations.empty()) {
-            // ƿ״̬ʾ
-            sf::Text emptyText("No Data - Load operations to display gantt chart", font, 16);
-            emptyText.setFillColor(sf::Color::Black);
-            emptyText.setPosition(window.getSize().x / 2 - 200, window.getSize().y / 2);
-            window.draw(emptyText);
+template<typename TimeT>
+void BasicGanttChart<TimeT>::setIdleGapsVisible(bool visible) {
+    if (visible) {
+        setIdleGapIndexEnabled(true);
+    }
+    std::lock_guard<std::mutex> lock(dataMutex);
+    showIdleGaps = visible && gapIndexEnabled;
+}
 
-            // ƻ
-            drawAxes();
-        }
-        else {
-            drawAxes();
-            drawOperations();
-            drawLabels();
+// 每个可见行只取与可见时间窗口相交的空闲区间；最后一个操作之后画到窗口右边缘
+template<typename TimeT>
+void BasicGanttChart<TimeT>::appendIdleGaps(int firstRow, int lastRow) {
+    using Gap = GanttConfig::IdleGapConfig;
+    const sf::Color color(Gap::R, Gap::G, Gap::B, Gap::A);
+    const double windowWidth = window.getSize().x;
+    const double visibleStart = xToTime(0.0);
+    const double visibleEnd = xToTime(windowWidth);
+
+    for (int line = firstRow; line <= lastRow; ++line) {
+        const int row = getLineRow(line);
+        if (row < 0) continue;
+        const float y = getRowY(line);
+        gapIndex.getGaps(rowMachines[row], visibleStart, visibleEnd, gapScratch);
+        for (const auto& gap : gapScratch) {
+            const double x0 = std::max(-1.0, timeToX(static_cast<double>(gap.first)));
+            const double x1 = std::min(windowWidth + 1.0, timeToX(static_cast<double>(gap.second)));
+            if (x1 - x0 < Gap::MIN_SHADE_WIDTH) continue;
+            appendRect(static_cast<float>(x0), y, static_cast<float>(x1 - x0), barHeight, color);
         }
 
-        window.display();
-    }
-    catch (const std::exception& e) {
-        ERROR("Error during drawing: " << e.what());
-        // ٳ
-        try {
-            window.clear(sf::Color::White);
-            window.display();
-        }
-        catch (...) {
-            // Զδ
+        TimeT tail;
+        if (gapIndex.getTail(rowMachines[row], tail)) {
+            const double x0 = std::max(-1.0, timeToX(static_cast<double>(tail)));
+            if (x0 < windowWidth) {
+                appendRect(static_cast<float>(x0), y, static_cast<float>(windowWidth + 1.0 - x0), barHeight, color);
+            }
         }
     }
 }
 
-// õԱ־
-void GanttChart::resetDebugFlag() {
-    debugOutputShown = false;
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::loadMachineGroups(const std::string& filename) {
+    MachineGroups loaded;
+    if (!loaded.loadFromFile(filename)) return false;
+    setMachineGroups(loaded);
+    return true;
 }
 
-// ţʹò
-void GanttChart::handleMouseWheel(float delta) {
-    handleZoom(delta * GanttConfig::InteractionConfig::MOUSE_WHEEL_ZOOM_FACTOR);
+template<typename TimeT>
+void BasicGanttChart<TimeT>::setMachineGroups(const MachineGroups& groups) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    machineGroups = groups;
+    groupExpanded.assign(machineGroups.getGroups().size(), 0);
+    assignRowGroups();
+    computeGroupOccupancy();
+    applyDisplayLines();
 }
 
-// ƽƣʹò
-void GanttChart::handleKeyboard() {
-    if (!GanttConfig::InteractionConfig::ENABLE_KEYBOARD_PAN) return;
-
-    float panSpeed = GanttConfig::ViewConfig::PAN_SPEED;
+template<typename TimeT>
+void BasicGanttChart<TimeT>::clearMachineGroups() {
+    setMachineGroups(MachineGroups());
+}
 
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left) || sf::Keyboard::isKeyPressed(sf::Keyboard::A)) {
-        handlePan(panSpeed, 0);
-    }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right) || sf::Keyboard::isKeyPressed(sf::Keyboard::D)) {
-        handlePan(-panSpeed, 0);
-    }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up) || sf::Keyboard::isKeyPressed(sf::Keyboard::W)) {
-        handlePan(0, panSpeed);
-    }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down) || sf::Keyboard::isKeyPressed(sf::Keyboard::S)) {
-        handlePan(0, -panSpeed);
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::setGroupExpanded(const std::string& path, bool expanded) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    const int group = machineGroups.findGroup(path);
+    if (group < 0) return false;
+    groupExpanded[group] = expanded;
+    // 展开时同时展开各级上级分组，使其可见
+    if (expanded) {
+        const auto& groups = machineGroups.getGroups();
+        for (int parent = groups[group].parent; parent >= 0; parent = groups[parent].parent) {
+            groupExpanded[parent] = 1;
+        }
     }
+    applyDisplayLines();
+    return true;
 }
 
-// ͼʹĬֵ
-void GanttChart::resetView() {
+template<typename TimeT>
+void BasicGanttChart<TimeT>::setAllGroupsExpanded(bool expanded) {
     std::lock_guard<std::mutex> lock(dataMutex);
-    zoomLevel = GanttConfig::ViewConfig::DEFAULT_ZOOM_LEVEL;
-    offsetX = 0.0f;
-    offsetY = 0.0f;
-    calculateRanges();
-    std::cout << "View reset to default" << std::endl;
+    if (machineGroups.empty()) return;
+    std::fill(groupExpanded.begin(), groupExpanded.end(), expanded ? 1 : 0);
+    applyDisplayLines();
 }
 
-// SFML¼
-void GanttChart::handleEvent(const sf::Event& event) {
-    switch (event.type) {
-    case sf::Event::MouseWheelScrolled:
-        handleMouseWheel(event.mouseWheelScroll.delta);
-        break;
-
-    case sf::Event::KeyPressed:
-        switch (event.key.code) {
-        case sf::Keyboard::Space:
-            resetView();
-            break;
-        case sf::Keyboard::R:
-            resetDebugFlag();
-            INFO("Debug output flag reset. Next draw will show debug info.");
-            break;
-        case sf::Keyboard::D:
-            INFO("=== Manual Debug Output Requested ===");
-            printLoadedData();
-            break;
-        default:
-            break;
+// 机器行归入分组，并统计各分组（含下级）中有操作的机器数
+template<typename TimeT>
+void BasicGanttChart<TimeT>::assignRowGroups() {
+    const auto& groups = machineGroups.getGroups();
+    rowGroups.clear();
+    groupMachineCounts.assign(groups.size(), 0);
+    if (groups.empty()) return;
+
+    rowGroups.resize(rowMachines.size());
+    for (size_t row = 0; row < rowMachines.size(); ++row) {
+        const int group = machineGroups.getGroupOf(rowMachines[row]);
+        rowGroups[row] = group;
+        for (int g = group; g >= 0; g = groups[g].parent) {
+            ++groupMachineCounts[g];
         }
-        break;
-
-    default:
-        break;
     }
 }
 
-// === ѯӿ ===
+// 按分组树深度优先排列显示行：分组行之后是展开时的下级分组与本组机器，未分组的机器排在最后；
+// 没有机器的分组不显示
+template<typename TimeT>
+void BasicGanttChart<TimeT>::rebuildDisplayLines() {
+    displayLines.clear();
+    rowLines.clear();
+    if (rowGroups.empty()) return;
+
+    // 各分组直接包含的机器行（CSR，行内保持机器ID顺序）
+    const auto& groups = machineGroups.getGroups();
+    std::vector<int> groupOffsets(groups.size() + 1, 0);
+    for (int group : rowGroups) {
+        if (group >= 0) ++groupOffsets[group + 1];
+    }
+    for (size_t g = 0; g < groups.size(); ++g) {
+        groupOffsets[g + 1] += groupOffsets[g];
+    }
+    std::vector<int> groupRows(groupOffsets.back());
+    std::vector<int> cursor(groupOffsets.begin(), groupOffsets.end() - 1);
+    for (size_t row = 0; row < rowGroups.size(); ++row) {
+        if (rowGroups[row] >= 0) groupRows[cursor[rowGroups[row]]++] = static_cast<int>(row);
+    }
 
-size_t GanttChart::getOperationCount() const {
-    std::lock_guard<std::mutex> lock(dataMutex);
-    return operations.size();
+    rowLines.assign(rowMachines.size(), -1);
+    auto pushRow = [this](int row) {
+        rowLines[row] = static_cast<int>(displayLines.size());
+        displayLines.push_back(row);
+    };
+    auto visit = [&](auto& self, int group) -> void {
+        if (groupMachineCounts[group] == 0) return;
+        displayLines.push_back(-(group + 1));
+        if (!groupExpanded[group]) return;
+        for (int child : groups[group].children) {
+            self(self, child);
+        }
+        for (int k = groupOffsets[group]; k < groupOffsets[group + 1]; ++k) {
+            pushRow(groupRows[k]);
+        }
+    };
+    for (int root : machineGroups.getRoots()) {
+        visit(visit, root);
+    }
+    for (size_t row = 0; row < rowGroups.size(); ++row) {
+        if (rowGroups[row] < 0) pushRow(static_cast<int>(row));
+    }
 }
 
-bool GanttChart::hasOverlaps() const {
-    std::lock_guard<std::mutex> lock(dataMutex);
+// 显示行变化后重新布局（行数决定条形高度），保持首行
+template<typename TimeT>
+void BasicGanttChart<TimeT>::applyDisplayLines() {
+    int firstVisibleRow = getFirstVisibleRow();
+    rebuildDisplayLines();
+    if (!operations.empty()) {
+        updateLayout();
+        updateTimeScale();
+        scrollToRow(firstVisibleRow);
+        clampView();
+    }
+}
 
-    if (operations.empty()) return false;
+// 分组汇总占用：每台机器的操作合并为互不重叠的忙碌区间，按桶的覆盖长度计入直接所属的分组（差分数组
+// 记录完整覆盖的桶，首尾两个桶按比例计入），前缀和之后由下级向上级累加；每次数据更新计算一次，
+// 折叠/展开不需要重算。占用率 = 忙碌时长 / (机器数 * 桶宽)
+template<typename TimeT>
+void BasicGanttChart<TimeT>::computeGroupOccupancy() {
+    const auto& groups = machineGroups.getGroups();
+    groupLevels.clear();
+    if (groups.empty() || operations.empty()) return;
+
+    const int buckets = GanttConfig::GroupConfig::OCCUPANCY_BUCKETS;
+    const int levels = GanttConfig::GroupConfig::COLOR_LEVELS;
+    const double span = static_cast<double>(maxTime) - static_cast<double>(minTime);
+    groupStartTime = static_cast<double>(minTime);
+    groupBucketWidth = span > 0 ? span / buckets : 1.0;
+
+    // 每个分组 buckets + 1 个差分值（完整覆盖的桶）与 buckets 个部分覆盖值（首尾桶），部分覆盖在前缀和之后再加
+    std::vector<double> full(groups.size() * (buckets + 1), 0.0);
+    std::vector<double> partial(groups.size() * buckets, 0.0);
+    auto addSpan = [&](int group, double from, double to) {
+        const double a = std::max(0.0, std::min<double>(buckets, (from - groupStartTime) / groupBucketWidth));
+        const double b = std::max(0.0, std::min<double>(buckets, (to - groupStartTime) / groupBucketWidth));
+        if (b <= a) return;
+        const int first = std::min(buckets - 1, static_cast<int>(a));
+        const int last = std::min(buckets - 1, static_cast<int>(b));
+        double* groupPartial = partial.data() + static_cast<size_t>(group) * buckets;
+        if (first == last) {
+            groupPartial[first] += b - a;
+            return;
+        }
+        groupPartial[first] += first + 1 - a;
+        groupPartial[last] += b - last;
+        double* groupFull = full.data() + static_cast<size_t>(group) * (buckets + 1);
+        groupFull[first + 1] += 1.0;
+        groupFull[last] -= 1.0;
+    };
 
-    // ص
-    std::map<int, std::vector<qm::Operation>> machineOps;
-    for (const auto& op : operations) {
-        machineOps[op.machine_id].push_back(op);
+    for (size_t row = 0; row < rowMachines.size(); ++row) {
+        const int group = rowGroups[row];
+        if (group < 0 || rowOffsets[row] == rowOffsets[row + 1]) continue;
+        // 行内按开始时间排序，重叠的操作合并后只计一次
+        TimeT spanStart = operations.startTime[rowOperations[rowOffsets[row]]];
+        TimeT spanEnd = operations.endTime[rowOperations[rowOffsets[row]]];
+        for (int k = rowOffsets[row] + 1; k < rowOffsets[row + 1]; ++k) {
+            const int op = rowOperations[k];
+            if (operations.startTime[op] > spanEnd) {
+                addSpan(group, static_cast<double>(spanStart), static_cast<double>(spanEnd));
+                spanStart = operations.startTime[op];
+            }
+            spanEnd = std::max(spanEnd, operations.endTime[op]);
+        }
+        addSpan(group, static_cast<double>(spanStart), static_cast<double>(spanEnd));
     }
 
-    for (auto& pair : machineOps) {
-        auto& ops = pair.second;
-        std::sort(ops.begin(), ops.end(), [](const qm::Operation& a, const qm::Operation& b) {
-            return a.start_time < b.start_time;
-            });
+    // 前缀和得到每桶的覆盖长度（以桶宽为单位）；上级分组的下标总是小于下级，倒序累加到上级
+    std::vector<double> coverage(groups.size() * buckets);
+    for (size_t g = 0; g < groups.size(); ++g) {
+        double running = 0.0;
+        for (int b = 0; b < buckets; ++b) {
+            running += full[g * (buckets + 1) + b];
+            coverage[g * buckets + b] = running + partial[g * buckets + b];
+        }
+    }
+    for (size_t g = groups.size(); g-- > 0;) {
+        const int parent = groups[g].parent;
+        if (parent < 0) continue;
+        for (int b = 0; b < buckets; ++b) {
+            coverage[static_cast<size_t>(parent) * buckets + b] += coverage[g * buckets + b];
+        }
+    }
 
-        for (size_t i = 0; i + 1 < ops.size(); ++i) {
-            if (ops[i].end_time > ops[i + 1].start_time) {
-                return true;
-            }
+    groupLevels.assign(groups.size() * buckets, 0);
+    for (size_t g = 0; g < groups.size(); ++g) {
+        if (groupMachineCounts[g] == 0) continue;
+        for (int b = 0; b < buckets; ++b) {
+            const double occupancy = std::min(1.0, coverage[g * buckets + b] / groupMachineCounts[g]);
+            // 向上取整：有任何占用的桶至少为 1 级
+            groupLevels[g * buckets + b] = static_cast<std::uint8_t>(std::ceil(occupancy * levels - 1e-9));
         }
     }
+}
 
-    return false;
+// 分组行：底色占满可见宽度，只遍历可见的桶，相邻同级的桶合并为一个矩形
+template<typename TimeT>
+void BasicGanttChart<TimeT>::appendGroupOccupancy(int group, float y) {
+    using Group = GanttConfig::GroupConfig;
+    const double windowWidth = window.getSize().x;
+    appendRect(leftMargin, y, static_cast<float>(windowWidth - leftMargin), barHeight,
+        sf::Color(Group::BACKGROUND_R, Group::BACKGROUND_G, Group::BACKGROUND_B));
+    if (groupLevels.empty()) return;
+
+    const int buckets = Group::OCCUPANCY_BUCKETS;
+    const int firstBucket = std::max(0, static_cast<int>(std::floor((xToTime(0.0) - groupStartTime) / groupBucketWidth)));
+    const int lastBucket = std::min(buckets - 1,
+        static_cast<int>(std::floor((xToTime(windowWidth) - groupStartTime) / groupBucketWidth)));
+    if (firstBucket > lastBucket) return;
+
+    const std::uint8_t* levels = groupLevels.data() + static_cast<size_t>(group) * buckets;
+    int runStart = firstBucket;
+    for (int b = firstBucket; b <= lastBucket + 1; ++b) {
+        if (b <= lastBucket && levels[b] == levels[runStart]) continue;
+        if (levels[runStart] > 0) {
+            const double x0 = std::max(-1.0, timeToX(groupStartTime + runStart * groupBucketWidth));
+            const double x1 = std::min(windowWidth + 1.0, timeToX(groupStartTime + b * groupBucketWidth));
+            const int alpha = 40 + levels[runStart] * 215 / Group::COLOR_LEVELS;
+            appendRect(static_cast<float>(x0), y, static_cast<float>(std::max(1.0, x1 - x0)), barHeight,
+                sf::Color(Group::FILL_R, Group::FILL_G, Group::FILL_B, static_cast<sf::Uint8>(alpha)));
+        }
+        runStart = b;
+    }
+}
+
+template<typename TimeT>
+int BasicGanttChart<TimeT>::getLineRow(int line) const {
+    return displayLines.empty() ? line : displayLines[line];
+}
+
+template<typename TimeT>
+int BasicGanttChart<TimeT>::getRowLine(int row) const {
+    return rowLines.empty() ? row : rowLines[row];
 }
 
-void GanttChart::getTimeRange(int& minT, int& maxT) const {
+template<typename TimeT>
+void BasicGanttChart<TimeT>::getTimeRange(TimeT& minT, TimeT& maxT) const {
     std::lock_guard<std::mutex> lock(dataMutex);
     minT = minTime;
     maxT = maxTime;
 }
 
-void GanttChart::getMachineRange(int& minM, int& maxM) const {
+template<typename TimeT>
+void BasicGanttChart<TimeT>::getMachineRange(int& minM, int& maxM) const {
     std::lock_guard<std::mutex> lock(dataMutex);
     minM = minMachine;
     maxM = maxMachine;
 }
 
-// === ؽӿʵ ===
+// === 配置相关接口实现 ===
 
-void GanttChart::applyLayoutConfig(float leftM, float topM, float bottomM, float rightM) {
+template<typename TimeT>
+void BasicGanttChart<TimeT>::applyLayoutConfig(float leftM, float topM, float bottomM, float rightM) {
     std::lock_guard<std::mutex> lock(dataMutex);
     leftMargin = leftM;
     topMargin = topM;
     bottomMargin = bottomM;
     rightMargin = rightM;
 
+    // 边距只影响布局与缩放比例，不需要重新扫描数据
     if (!operations.empty()) {
-        calculateRanges();
+        int firstVisibleRow = getFirstVisibleRow();
+        updateLayout();
+        updateTimeScale();
+        scrollToRow(firstVisibleRow);
+        clampView();
     }
 
     INFO("Custom layout configuration applied");
 }
 
-void GanttChart::applyViewConfig(float zoom, float panSpeed) {
+template<typename TimeT>
+void BasicGanttChart<TimeT>::applyViewConfig(float zoom, float panSpeed) {
     std::lock_guard<std::mutex> lock(dataMutex);
-    zoomLevel = std::max(GanttConfig::ViewConfig::MIN_ZOOM_LEVEL,
-        std::min(GanttConfig::ViewConfig::MAX_ZOOM_LEVEL, zoom));
+    zoomLevel = std::max<double>(GanttConfig::ViewConfig::MIN_ZOOM_LEVEL, std::min<double>(getMaxZoomLevel(), zoom));
 
     if (!operations.empty()) {
-        calculateRanges();
+        updateTimeScale();
+        clampView();
     }
 
     INFO("Custom view configuration applied");
 }
 
-void GanttChart::printCurrentConfig() const {
+template<typename TimeT>
+UpdateStatsSnapshot BasicGanttChart<TimeT>::getStats() const {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    return updateStats.snapshot();
+}
+
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::dumpStats(const std::string& filename) const {
+    UpdateStatsSnapshot stats = getStats();
+    if (!stats.dumpToFile(filename)) {
+        ERROR("Could not write stats file " << filename);
+        return false;
+    }
+    INFO("Update pipeline stats written to " << filename);
+    return true;
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::resetStats() {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    updateStats.reset();
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::setProfilerHudVisible(bool visible) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    showProfilerHud = visible;
+    if (visible) {
+        profiler.setEnabled(true);
+    }
+}
+
+template<typename TimeT>
+void BasicGanttChart<TimeT>::printCurrentConfig() const {
     std::cout << "[CONFIG] === Current Configuration ===" << std::endl;
     std::cout << "[CONFIG] Layout: margins(" << leftMargin << "," << topMargin
         << "," << bottomMargin << "," << rightMargin << ")" << std::endl;
     std::cout << "[CONFIG] Bars: height=" << barHeight << ", spacing=" << barSpacing << std::endl;
-    std::cout << "[CONFIG] View: zoom=" << zoomLevel << ", offset(" << offsetX << "," << offsetY << ")" << std::endl;
+    std::cout << "[CONFIG] View: zoom=" << zoomLevel << ", view start=" << viewStartTime << ", offsetY=" << offsetY << std::endl;
     std::cout << "[CONFIG] Window: " << window.getSize().x << "x" << window.getSize().y << std::endl;
 }
 
-// === Ʒ ===
+// === 绘制方法 ===
+
+// 绘制坐标轴
+template<typename TimeT>
+void BasicGanttChart<TimeT>::drawAxes() {
+    shapeBatch.clear();
+
+    // 绘制Y轴（机器轴）
+    appendRect(leftMargin - 1, topMargin, 2, window.getSize().y - topMargin - getBottomMargin(), sf::Color::Black);
+
+    // 绘制X轴（时间轴）
+    appendRect(leftMargin, window.getSize().y - getBottomMargin(), window.getSize().x - leftMargin - rightMargin, 2, sf::Color::Black);
+
+    // 网格线（可选）- 与刻度共用同一组可见刻度，画在操作块之下
+    long long firstTick, lastTick, timeStep;
+    if (GanttConfig::TimeAxisConfig::ENABLE_GRID_LINES && !operations.empty() &&
+        computeTimeTicks(firstTick, lastTick, timeStep)) {
+        const sf::Color gridColor(GanttConfig::ColorConfig::AXIS_R, GanttConfig::ColorConfig::AXIS_G,
+            GanttConfig::ColorConfig::AXIS_B, static_cast<sf::Uint8>(GanttConfig::TimeAxisConfig::GRID_LINE_ALPHA * 255));
+        const float gridHeight = window.getSize().y - topMargin - getBottomMargin();
+
+        for (long long time = firstTick; time <= lastTick; time += timeStep) {
+            float x = static_cast<float>(timeToX(static_cast<double>(time)));
+            if (x < leftMargin) continue;
+            appendRect(x, topMargin, static_cast<float>(GanttConfig::TimeAxisConfig::TICK_THICKNESS), gridHeight, gridColor);
+        }
+    }
+
+    window.draw(shapeBatch);
+}
+
+// 从配置的候选步长（按10的幂缩放）中选择不小于标签间距对应时间跨度的最小步长
+template<typename TimeT>
+long long BasicGanttChart<TimeT>::chooseTimeStep() const {
+    const double rawStep = GanttConfig::TimeAxisConfig::LABEL_SPACING_PIXELS / std::max(1e-9, timeScale);
+
+    long long best = 0;
+    long long scale = 1;
+    for (int exponent = 0; exponent <= 15; ++exponent) {
+        for (int i = 0; i < GanttConfig::TimeAxisConfig::TIME_STEP_CANDIDATE_COUNT; ++i) {
+            const long long base = GanttConfig::TimeAxisConfig::TIME_STEP_CANDIDATES[i];
+
+            // 缩小方向：50/10=5, 100/100=1 ... 仅保留整数步长
+            long long smaller = (base % scale == 0) ? base / scale : 0;
+            if (smaller >= GanttConfig::TimeAxisConfig::MIN_TIME_STEP && smaller >= rawStep &&
+                (best == 0 || smaller < best)) {
+                best = smaller;
+            }
+
+            // 放大方向：2000, 20000, 200000 ...
+            long long larger = base * scale;
+            if (larger >= rawStep && (best == 0 || larger < best)) {
+                best = larger;
+            }
+        }
+        scale *= 10;
+    }
+
+    return std::max<long long>(GanttConfig::TimeAxisConfig::MIN_TIME_STEP, best);
+}
+
+// 计算当前可见窗口内的刻度范围，刻度对齐到步长的整数倍
+template<typename TimeT>
+bool BasicGanttChart<TimeT>::computeTimeTicks(long long& firstTick, long long& lastTick, long long& timeStep) const {
+    if (operations.empty() || timeScale <= 0.0) return false;
 
-// 
-void GanttChart::drawAxes() {
-    // Yᣨᣩ
-    sf::RectangleShape yAxis(sf::Vector2f(2, window.getSize().y - topMargin - bottomMargin));
-    yAxis.setPosition(leftMargin - 1, topMargin);
-    yAxis.setFillColor(sf::Color::Black);
-    window.draw(yAxis);
+    timeStep = chooseTimeStep();
 
-    // Xᣨʱᣩ
-    sf::RectangleShape xAxis(sf::Vector2f(window.getSize().x - leftMargin - rightMargin, 2));
-    xAxis.setPosition(leftMargin, window.getSize().y - bottomMargin);
-    xAxis.setFillColor(sf::Color::Black);
-    window.draw(xAxis);
+    // 标签允许略微伸入左边距（与原有可见性判断一致）
+    double visibleMin = xToTime(leftMargin - 50.0);
+    double visibleMax = xToTime(window.getSize().x);
+    visibleMin = std::max(visibleMin, static_cast<double>(minTime));
+    visibleMax = std::min(visibleMax, static_cast<double>(maxTime));
+    if (visibleMin > visibleMax) return false;
+
+    firstTick = static_cast<long long>(std::ceil(visibleMin / timeStep)) * timeStep;
+    lastTick = static_cast<long long>(std::floor(visibleMax / timeStep)) * timeStep;
+    return firstTick <= lastTick;
+}
+
+// 向形状批次追加矩形（两个三角形）
+template<typename TimeT>
+void BasicGanttChart<TimeT>::appendRect(float x, float y, float width, float height, const sf::Color& color) {
+    const float r = x + width, b = y + height;
+    shapeBatch.append(sf::Vertex(sf::Vector2f(x, y), color));
+    shapeBatch.append(sf::Vertex(sf::Vector2f(r, y), color));
+    shapeBatch.append(sf::Vertex(sf::Vector2f(x, b), color));
+    shapeBatch.append(sf::Vertex(sf::Vector2f(x, b), color));
+    shapeBatch.append(sf::Vertex(sf::Vector2f(r, y), color));
+    shapeBatch.append(sf::Vertex(sf::Vector2f(r, b), color));
 }
 
-// Ʋ
-void GanttChart::drawOperations() {
+// 绘制操作块
+template<typename TimeT>
+void BasicGanttChart<TimeT>::drawOperations() {
     bool shouldShowDebug = !debugOutputShown;
 
     if (shouldShowDebug) {
         DRAW_DEBUG("=== Drawing Operations ===");
-        DRAW_DEBUG("Zoom: " << zoomLevel << ", Offset: (" << offsetX << ", " << offsetY << ")");
+        DRAW_DEBUG("Zoom: " << zoomLevel << ", View start: " << viewStartTime << ", Offset Y: " << offsetY);
         DRAW_DEBUG("Visible operations (showing first 5):");
     }
 
@@ -658,73 +2702,119 @@ void GanttChart::drawOperations() {
     auto startTime = std::chrono::high_resolution_clock::now();
 #endif
 
-    for (size_t i = 0; i < operations.size(); ++i) {
-        const auto& op = operations[i];
-        float x = getTimeX(op.start_time);
-        float y = getMachineY(op.machine_id);
-        float width = (op.end_time - op.start_time) * timeScale;
+    shapeBatch.clear();
 
-        // Ƿڿɼ
-        if (x + width < 0 || x > window.getSize().x ||
-            y + barHeight < 0 || y > window.getSize().y) {
-            continue; // ɼĲ
-        }
+    // 只遍历可见行；行内操作按开始时间排序
+    int firstRow, lastRow;
+    getVisibleRows(firstRow, lastRow);
 
-        visibleCount++;
+    // 可见时间窗口（double），裁剪在转换为 float 顶点坐标之前完成
+    const double windowWidth = window.getSize().x;
+    const double visibleStart = xToTime(0.0);
+    const double clipLeft = -GanttConfig::ColorConfig::CRITICAL_BORDER_THICKNESS - 1.0;
+    const double clipRight = windowWidth + GanttConfig::ColorConfig::CRITICAL_BORDER_THICKNESS + 1.0;
 
-#if ENABLE_DRAWING_DEBUG
-        if (shouldShowDebug && drawnCount < 5) {
-            std::cout << "[DRAW] J" << op.job_id << "-" << op.stage << " | "
-                << "M" << op.machine_id << " | "
-                << "(" << std::setw(6) << std::fixed << std::setprecision(1) << x << ","
-                << std::setw(6) << std::fixed << std::setprecision(1) << y << ") | "
-                << "size(" << std::setw(6) << std::fixed << std::setprecision(1) << width << ","
-                << std::setw(4) << barHeight << ") | "
-                << "[" << op.start_time << "-" << op.end_time << "]" << std::endl;
-        }
-#endif
+    // 热力图在最下层
+    if (showHeatmap && heatBuckets > 0) {
+        appendHeatmap(firstRow, lastRow);
+    }
+    if (showIdleGaps) {
+        appendIdleGaps(firstRow, lastRow);
+    }
 
-        // Ʋ
-        sf::RectangleShape rect(sf::Vector2f(std::max(1.0f, width), barHeight));
-        rect.setPosition(x, y);
-        rect.setFillColor(jobColors[op.job_id]);
+    // 差异叠加层：旧位置先画，位于操作之下
+    const bool diffOverlay = diffActive && showDiffOverlay && diffFlags.size() == operations.size();
+    if (diffOverlay) {
+        appendDiffGhosts(firstRow, lastRow);
+    }
 
-        // ñ߿
-        if (op.is_critical) {
-            rect.setOutlineThickness(2);
-            rect.setOutlineColor(sf::Color::Red);
-        }
-        else {
-            rect.setOutlineThickness(1);
-            rect.setOutlineColor(sf::Color::Black);
+    for (int line = firstRow; line <= lastRow; ++line) {
+        const int row = getLineRow(line);
+        const float y = getRowY(line);
+        if (row < 0) {
+            // 分组行只画汇总占用
+            appendGroupOccupancy(-row - 1, y);
+            continue;
         }
 
-        window.draw(rect);
-        drawnCount++;
+        // 开始时间早于 visibleStart - 本行最长时长 的操作一定在左侧不可见
+        const auto rowBegin = rowOperations.begin() + rowOffsets[row];
+        const auto rowEnd = rowOperations.begin() + rowOffsets[row + 1];
+        const double earliestStart = visibleStart - rowMaxDuration[row];
+        const auto first = std::lower_bound(rowBegin, rowEnd, earliestStart, [this](int index, double t) {
+            return operations.startTime[index] < t;
+            });
+
+        for (auto it = first; it != rowEnd; ++it) {
+            const auto& op = operations[*it];
+            const double startX = timeToX(op.start_time);
+            const double endX = timeToX(op.end_time);
+
+            // 越过右边界后本行剩余操作均不可见
+            if (startX > windowWidth) break;
+            if (endX < 0.0) continue; // 跳过不可见的操作
 
-        // Ʊǩı - ֻе㹻ʱ
-        if (width > 30 && barHeight > 15) {
-            std::string label = "J" + std::to_string(op.job_id) + "-" + std::to_string(op.stage);
+            // 裁剪到窗口附近后再转为 float，深度缩放下坐标不会失去精度
+            float x = static_cast<float>(std::max(startX, clipLeft));
+            float width = static_cast<float>(std::min(endX, clipRight)) - x;
 
-            // ݾδСѡС
-            int fontSize = 10;
-            if (width > 80) fontSize = 12;
-            if (width > 120) fontSize = 14;
+            visibleCount++;
 
-            sf::Text text(label, font, fontSize);
-            text.setFillColor(sf::Color::Black);
+#if ENABLE_DRAWING_DEBUG
+            if (shouldShowDebug && drawnCount < 5) {
+                DRAW_DEBUG("J" << op.job_id << "-" << op.stage << " | "
+                    << "M" << op.machine_id << " | "
+                    << "(" << std::setw(6) << std::fixed << std::setprecision(1) << x << ","
+                    << std::setw(6) << std::fixed << std::setprecision(1) << y << ") | "
+                    << "size(" << std::setw(6) << std::fixed << std::setprecision(1) << width << ","
+                    << std::setw(4) << barHeight << ") | "
+                    << "[" << op.start_time << "-" << op.end_time << "]");
+            }
+#endif
 
-            // ıλ
-            sf::FloatRect textBounds = text.getLocalBounds();
-            if (textBounds.width < width - 4) {
-                float textX = x + (width - textBounds.width) / 2;
-                float textY = y + (barHeight - textBounds.height) / 2 - 2;
-                text.setPosition(textX, textY);
-                window.draw(text);
+            // 绘制操作矩形：先画外扩的边框矩形，再覆盖填充矩形（等价于 RectangleShape 外描边）
+            float rectWidth = std::max(1.0f, width);
+            float outline;
+            sf::Color outlineColor;
+            sf::Color fill = jobColors[op.job_id];
+            if (op.is_critical) {
+                outline = static_cast<float>(GanttConfig::ColorConfig::CRITICAL_BORDER_THICKNESS);
+                outlineColor = sf::Color::Red;
+            }
+            else {
+                outline = static_cast<float>(GanttConfig::ColorConfig::NORMAL_BORDER_THICKNESS);
+                outlineColor = sf::Color::Black;
+            }
+            if (diffOverlay) {
+                applyDiffStyle(diffFlags[*it], fill, outlineColor, outline);
+            }
+            appendRect(x - outline, y - outline, rectWidth + 2 * outline, barHeight + 2 * outline, outlineColor);
+            appendRect(x, y, rectWidth, barHeight, fill);
+            drawnCount++;
+
+            // 绘制标签文本 - 只有当矩形足够大时
+            if (width > GanttConfig::FontConfig::MIN_WIDTH_FOR_TEXT && barHeight > GanttConfig::FontConfig::MIN_HEIGHT_FOR_TEXT) {
+                // 根据矩形大小选择字体大小
+                unsigned fontSize = GanttConfig::FontConfig::OPERATION_FONT_SIZE_SMALL;
+                if (width > GanttConfig::FontConfig::FONT_SIZE_THRESHOLD_1) fontSize = GanttConfig::FontConfig::OPERATION_FONT_SIZE_MEDIUM;
+                if (width > GanttConfig::FontConfig::FONT_SIZE_THRESHOLD_2) fontSize = GanttConfig::FontConfig::OPERATION_FONT_SIZE_LARGE;
+
+                const CachedLabel& label = labelCache.get(LabelKind::Operation, op.job_id, op.stage, fontSize);
+
+                // 计算文本居中位置
+                if (label.width < width - GanttConfig::FontConfig::TEXT_PADDING) {
+                    float textX = x + (width - label.width) / 2;
+                    float textY = y + (barHeight - label.height) / 2 - 2;
+                    labelCache.appendLabel(label, fontSize, textX, textY, sf::Color::Black);
+                }
             }
         }
     }
 
+    // 一次提交所有矩形，再提交所有文字
+    window.draw(shapeBatch);
+    labelCache.flush(window);
+
     if (shouldShowDebug) {
         PERF_DEBUG("Visible operations: " << visibleCount << "/" << operations.size());
         PERF_DEBUG("Actually drawn: " << drawnCount);
@@ -733,98 +2823,91 @@ void GanttChart::drawOperations() {
 #if ENABLE_PERFORMANCE_DEBUG
         auto endTime = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
-        std::cout << "[PERF] Drawing time: " << duration.count() << " microseconds" << std::endl;
+        PERF_DEBUG("Drawing time: " << duration.count() << " microseconds");
 #endif
     }
 }
 
-// Ʊǩ
-void GanttChart::drawLabels() {
+// 绘制标签
+template<typename TimeT>
+void BasicGanttChart<TimeT>::drawLabels() {
     if (operations.empty()) return;
 
-    // ƻǩ
-    for (int machine = minMachine; machine <= maxMachine; ++machine) {
-        float y = getMachineY(machine);
-
-        // ֻƿɼĻǩ
-        if (y < -20 || y > window.getSize().y + 20) continue;
-
-        std::string label = "M" + std::to_string(machine);
-        sf::Text text(label, font, 10);
-        text.setFillColor(sf::Color::Black);
+    const unsigned labelSize = GanttConfig::FontConfig::AXIS_LABEL_FONT_SIZE;
+    shapeBatch.clear();
+
+    // 绘制机器标签 - 只绘制可见行
+    int firstRow, lastRow;
+    getVisibleRows(firstRow, lastRow);
+    const auto& groups = machineGroups.getGroups();
+    for (int line = firstRow; line <= lastRow; ++line) {
+        const int row = getLineRow(line);
+        float y = getRowY(line);
+
+        if (row < 0) {
+            // 分组行：展开标记、名称与机器数，按层级缩进
+            const int group = -row - 1;
+            char text[96];
+            int length = std::snprintf(text, sizeof(text), "%c %s (%d)", groupExpanded[group] ? '-' : '+',
+                groups[group].name.c_str(), groupMachineCounts[group]);
+            labelCache.appendText(text, static_cast<size_t>(std::max(0, std::min(length, static_cast<int>(sizeof(text)) - 1))),
+                labelSize, 5 + groups[group].depth * GanttConfig::GroupConfig::INDENT, y + barHeight / 2 - 6, sf::Color::Black);
+            continue;
+        }
 
-        text.setPosition(5, y + barHeight / 2 - 6);
-        window.draw(text);
+        const int group = rowGroups.empty() ? -1 : rowGroups[row];
+        const float indent = group >= 0 ? (groups[group].depth + 1) * GanttConfig::GroupConfig::INDENT : 0.0f;
+        const CachedLabel& label = labelCache.get(LabelKind::Machine, rowMachines[row], 0, labelSize);
+        labelCache.appendLabel(label, labelSize, 5 + indent, y + barHeight / 2 - 6, sf::Color::Black);
     }
 
-    // ʱǩ - ̬
-    int totalTimeSpan = maxTime - minTime;
-    int labelCount = (window.getSize().x - leftMargin - rightMargin) / 80; // ÿ80һǩ
-    int timeStep = std::max(1, totalTimeSpan / labelCount);
-
-    // ȷǺֵ
-    if (timeStep < 50) timeStep = 50;
-    else if (timeStep < 100) timeStep = 100;
-    else if (timeStep < 200) timeStep = 200;
-    else if (timeStep < 500) timeStep = 500;
-    else timeStep = ((timeStep + 499) / 500) * 500; // ȡ500ı
-
-    for (int time = minTime; time <= maxTime; time += timeStep) {
-        float x = getTimeX(time);
-
-        // ֻƿɼʱǩ
-        if (x < leftMargin - 50 || x > window.getSize().x) continue;
-
-        std::string label = std::to_string(time);
-        sf::Text text(label, font, 10);
-        text.setFillColor(sf::Color::Black);
-
-        sf::FloatRect textBounds = text.getLocalBounds();
-        text.setPosition(x - textBounds.width / 2, window.getSize().y - bottomMargin + 5);
-        window.draw(text);
-
-        // ʱ̶
-        sf::RectangleShape tick(sf::Vector2f(1, 5));
-        tick.setPosition(x, window.getSize().y - bottomMargin);
-        tick.setFillColor(sf::Color::Black);
-        window.draw(tick);
+    // 绘制时间标签 - 只遍历可见时间窗口内的刻度
+    long long firstTick, lastTick, timeStep;
+    if (!computeTimeTicks(firstTick, lastTick, timeStep)) {
+        firstTick = 1;
+        lastTick = 0;
     }
 
-    // 
-    sf::Text yAxisTitle("Machine", font, 12);
-    yAxisTitle.setFillColor(sf::Color::Black);
-    yAxisTitle.setPosition(5, 5);
-    window.draw(yAxisTitle);
+    for (long long time = firstTick; time <= lastTick; time += timeStep) {
+        float x = static_cast<float>(timeToX(static_cast<double>(time)));
 
-    sf::Text xAxisTitle("Time", font, 12);
-    xAxisTitle.setFillColor(sf::Color::Black);
-    xAxisTitle.setPosition(window.getSize().x / 2 - 20, window.getSize().y - 20);
-    window.draw(xAxisTitle);
+        const CachedLabel& label = labelCache.get(LabelKind::TimeTick, time, 0, labelSize);
+        labelCache.appendLabel(label, labelSize, x - label.width / 2, window.getSize().y - getBottomMargin() + 5, sf::Color::Black);
 
-    // Ϣ
-    std::string zoomInfo = "Zoom: " + std::to_string(static_cast<int>(zoomLevel * 100)) + "%";
-    sf::Text zoomText(zoomInfo, font, 10);
-    zoomText.setFillColor(sf::Color::Blue);
-    zoomText.setPosition(window.getSize().x - 100, 5);
-    window.draw(zoomText);
+        // 绘制时间刻度线
+        appendRect(x, window.getSize().y - getBottomMargin(), 1, GanttConfig::TimeAxisConfig::TICK_HEIGHT, sf::Color::Black);
+    }
 
-    // ƲϢ
-    std::string opInfo = "Operations: " + std::to_string(operations.size());
-    sf::Text opText(opInfo, font, 10);
-    opText.setFillColor(sf::Color::Blue);
-    opText.setPosition(window.getSize().x - 100, 20);
-    window.draw(opText);
+    // 绘制轴标题
+    const unsigned titleSize = GanttConfig::FontConfig::TITLE_FONT_SIZE;
+    labelCache.appendText("Machine", 7, titleSize, 5, 5, sf::Color::Black);
+    labelCache.appendText("Time", 4, titleSize, window.getSize().x / 2 - 20, window.getSize().y - 20, sf::Color::Black);
+
+    // 绘制缩放信息和操作数量信息（格式化到栈缓冲区，不构造 std::string）
+    char info[64];
+    int length = zoomLevel < 100.0
+        ? std::snprintf(info, sizeof(info), "Zoom: %d%%", static_cast<int>(zoomLevel * 100))
+        : std::snprintf(info, sizeof(info), "Zoom: %.3gx", zoomLevel);
+    labelCache.appendText(info, static_cast<size_t>(std::max(0, length)), GanttConfig::FontConfig::STATUS_FONT_SIZE,
+        window.getSize().x - 100, 5, sf::Color::Blue);
+
+    length = std::snprintf(info, sizeof(info), "Operations: %zu", operations.size());
+    labelCache.appendText(info, static_cast<size_t>(std::max(0, length)), GanttConfig::FontConfig::STATUS_FONT_SIZE,
+        window.getSize().x - 100, 20, sf::Color::Blue);
+
+    window.draw(shapeBatch);
+    labelCache.flush(window);
 }
 
-// === ߺʵ ===
+// === 工具函数实现 ===
 
-// SFMLã޸ΪúǴ
+// 配置SFML窗口设置（修改为配置函数而不是创建函数）
 void configureWindow(sf::RenderWindow& window) {
     window.setFramerateLimit(GanttConfig::WindowConfig::FRAME_RATE_LIMIT);
     window.setVerticalSyncEnabled(GanttConfig::WindowConfig::ENABLE_VERTICAL_SYNC);
 }
 
-// ȡڴ
+// 获取窗口创建设置
 sf::ContextSettings getWindowContextSettings() {
     sf::ContextSettings settings;
     settings.antialiasingLevel = GanttConfig::WindowConfig::ENABLE_ANTIALIASING ? 4 : 0;
@@ -833,9 +2916,79 @@ sf::ContextSettings getWindowContextSettings() {
     return settings;
 }
 
-// CSVȡ
+bool loadGanttFont(sf::Font& font, const std::string& fontPath) {
+    // 首先尝试加载指定的字体
+    if (font.loadFromFile(fontPath)) {
+        INFO("Font loaded successfully: " << fontPath);
+        return true;
+    }
+
+    // 如果失败，尝试备用字体路径
+    for (int i = 0; i < GanttConfig::FontConfig::FALLBACK_FONT_COUNT; ++i) {
+        if (font.loadFromFile(GanttConfig::FontConfig::FALLBACK_FONT_PATHS[i])) {
+            INFO("Fallback font loaded: " << GanttConfig::FontConfig::FALLBACK_FONT_PATHS[i]);
+            return true;
+        }
+    }
+
+    WARNING("Could not load any font file, using default system font");
+    return false;
+}
+
+sf::Color hsvToColor(float h, float s, float v) {
+    float c = v * s;
+    float x = c * (1 - std::abs(std::fmod(h / 60.0f, 2) - 1));
+    float m = v - c;
+
+    float r, g, b;
+    if (h >= 0 && h < 60) {
+        r = c; g = x; b = 0;
+    }
+    else if (h >= 60 && h < 120) {
+        r = x; g = c; b = 0;
+    }
+    else if (h >= 120 && h < 180) {
+        r = 0; g = c; b = x;
+    }
+    else if (h >= 180 && h < 240) {
+        r = 0; g = x; b = c;
+    }
+    else if (h >= 240 && h < 300) {
+        r = x; g = 0; b = c;
+    }
+    else {
+        r = c; g = 0; b = x;
+    }
+
+    return sf::Color(
+        static_cast<sf::Uint8>((r + m) * 255),
+        static_cast<sf::Uint8>((g + m) * 255),
+        static_cast<sf::Uint8>((b + m) * 255)
+    );
+}
+
+// CSV读取函数
+namespace {
+    // 按目标时间类型解析，避免 64 位或浮点时间经过 int 截断
+    template<typename TimeT>
+    TimeT parseTime(const std::string& text) {
+        if (std::is_floating_point<TimeT>::value) {
+            return static_cast<TimeT>(std::stod(text));
+        }
+        if (sizeof(TimeT) > sizeof(int)) {
+            return static_cast<TimeT>(std::stoll(text));
+        }
+        return static_cast<TimeT>(std::stoi(text));
+    }
+}
+
 std::vector<qm::Operation> loadOperationsFromCSV(const std::string& filename) {
-    std::vector<qm::Operation> operations;
+    return loadBasicOperationsFromCSV<int>(filename);
+}
+
+template<typename TimeT>
+std::vector<qm::BasicOperation<TimeT>> loadBasicOperationsFromCSV(const std::string& filename) {
+    std::vector<qm::BasicOperation<TimeT>> operations;
     std::ifstream file(filename);
 
     if (!file.is_open()) {
@@ -853,21 +3006,21 @@ std::vector<qm::Operation> loadOperationsFromCSV(const std::string& filename) {
     while (std::getline(file, line)) {
         lineNumber++;
 
-        // ȥĩĻس
+        // 去除行末的回车符
         if (!line.empty() && line.back() == '\r') {
             line.pop_back();
         }
 
-        // УҪʽ
+        // 跳过标题行，但要检查格式
         if (isFirstLine) {
             CSV_DEBUG("Header line: " << line);
 
-            // ǷԤڵĸʽ
+            // 检查是否是预期的格式
             if (line.find("ID") != std::string::npos && line.find("Job") != std::string::npos) {
-                CSV_DEBUG(" Detected your CSV format (ID,Job,Operation,Machine,StartTime,EndTime,IsCritical)");
+                CSV_DEBUG("√ Detected your CSV format (ID,Job,Operation,Machine,StartTime,EndTime,IsCritical)");
             }
             else if (line.find("job_id") != std::string::npos) {
-                CSV_DEBUG(" Detected standard format (job_id,stage,machine_id,...)");
+                CSV_DEBUG("√ Detected standard format (job_id,stage,machine_id,...)");
             }
             else {
                 WARNING("Unknown header format, will attempt to parse...");
@@ -877,7 +3030,7 @@ std::vector<qm::Operation> loadOperationsFromCSV(const std::string& filename) {
             continue;
         }
 
-        // 
+        // 跳过空行
         if (line.empty()) {
             continue;
         }
@@ -888,16 +3041,16 @@ std::vector<qm::Operation> loadOperationsFromCSV(const std::string& filename) {
         std::string cell;
         std::vector<std::string> row;
 
-        // CSV
+        // 解析CSV行
         while (std::getline(ss, cell, ',')) {
-            // ȥǰո
+            // 去除前后空格和引号
             cell.erase(0, cell.find_first_not_of(" \t\""));
             cell.erase(cell.find_last_not_of(" \t\"") + 1);
             row.push_back(cell);
         }
 
 #if ENABLE_CSV_DEBUG
-        if (lineNumber <= 6) { // ֻʾǰеϸϢ
+        if (lineNumber <= 6) { // 只显示前几行的详细信息
             std::cout << "[CSV_DETAIL] Parsed " << row.size() << " cells: ";
             for (size_t i = 0; i < row.size(); ++i) {
                 std::cout << "[" << i << "]=\"" << row[i] << "\" ";
@@ -906,7 +3059,7 @@ std::vector<qm::Operation> loadOperationsFromCSV(const std::string& filename) {
         }
 #endif
 
-        // 
+        // 检查列数
         if (row.size() < 6) {
             if (lineNumber <= 10) {
                 ERROR("Line " << lineNumber << " has insufficient columns (" << row.size() << " < 6)");
@@ -914,21 +3067,21 @@ std::vector<qm::Operation> loadOperationsFromCSV(const std::string& filename) {
             continue;
         }
 
-        // 
-        qm::Operation op;
+        // 解析数据
+        qm::BasicOperation<TimeT> op;
         try {
-            // CSVʽID,Job,Operation,Machine,StartTime,EndTime,IsCritical
-            int id = std::stoi(row[0]);           // ID ()
+            // CSV格式：ID,Job,Operation,Machine,StartTime,EndTime,IsCritical
+            int id = std::stoi(row[0]);           // ID (用作索引)
             op.job_id = std::stoi(row[1]);        // Job -> job_id
             op.stage = std::stoi(row[2]);         // Operation -> stage  
             op.machine_id = std::stoi(row[3]);    // Machine -> machine_id
-            op.start_time = std::stoi(row[4]);    // StartTime -> start_time
-            op.end_time = std::stoi(row[5]);      // EndTime -> end_time
-            op.is_critical = (std::stoi(row[6]) == 1);  // IsCritical -> is_critical (1ʾtrue)
+            op.start_time = parseTime<TimeT>(row[4]);  // StartTime -> start_time
+            op.end_time = parseTime<TimeT>(row[5]);    // EndTime -> end_time
+            op.is_critical = (std::stoi(row[6]) == 1);  // IsCritical -> is_critical (1表示true)
 
             operations.push_back(op);
 
-            CSV_DEBUG_DETAILED(" Operation added: Job=" << op.job_id
+            CSV_DEBUG_DETAILED("√ Operation added: Job=" << op.job_id
                 << ", Stage=" << op.stage
                 << ", Machine=" << op.machine_id
                 << ", Time=[" << op.start_time << "-" << op.end_time << "]"
@@ -953,11 +3106,11 @@ std::vector<qm::Operation> loadOperationsFromCSV(const std::string& filename) {
     return operations;
 }
 
-// صĶ
+// 检查操作重叠的独立函数
 void checkOperationsOverlap(const std::vector<qm::Operation>& operations) {
     OVERLAP_DEBUG("=== Overlap Detection ===");
 
-    // 
+    // 按机器分组
     std::map<int, std::vector<qm::Operation>> machineOps;
     for (const auto& op : operations) {
         machineOps[op.machine_id].push_back(op);
@@ -968,7 +3121,7 @@ void checkOperationsOverlap(const std::vector<qm::Operation>& operations) {
         int machineId = pair.first;
         auto& ops = pair.second;
 
-        // ʼʱ
+        // 按开始时间排序
         std::sort(ops.begin(), ops.end(), [](const qm::Operation& a, const qm::Operation& b) {
             return a.start_time < b.start_time;
             });
@@ -981,11 +3134,11 @@ void checkOperationsOverlap(const std::vector<qm::Operation>& operations) {
             std::cout << "[OVERLAP]   J" << op.job_id << "-" << op.stage
                 << " [" << op.start_time << "-" << op.end_time << "]";
 
-            // һص
+            // 检查与下一个操作的重叠
             if (i + 1 < ops.size()) {
                 const auto& nextOp = ops[i + 1];
                 if (op.end_time > nextOp.start_time) {
-                    std::cout << "   OVERLAP with J" << nextOp.job_id << "-" << nextOp.stage
+                    std::cout << " ！！  OVERLAP with J" << nextOp.job_id << "-" << nextOp.stage
                         << " [" << nextOp.start_time << "-" << nextOp.end_time << "]"
                         << " (overlap time: " << (op.end_time - nextOp.start_time) << ")";
                     hasOverlaps = true;
@@ -997,14 +3150,14 @@ void checkOperationsOverlap(const std::vector<qm::Operation>& operations) {
     }
 
     if (!hasOverlaps) {
-        INFO(" No time overlaps detected on any machine.");
+        INFO("√ No time overlaps detected on any machine.");
     }
     else {
-        WARNING("  WARNING: Time overlaps detected! This will cause visual overlapping in the Gantt chart.");
+        WARNING("！！  WARNING: Time overlaps detected! This will cause visual overlapping in the Gantt chart.");
     }
 }
 
-// ӡvectorеĲ
+// 打印vector中的操作数据
 void printOperationsVector(const std::vector<qm::Operation>& operations) {
     DATA_DEBUG("=== Vector Content Analysis ===");
     DATA_DEBUG("Vector size: " << operations.size());
@@ -1028,7 +3181,7 @@ void printOperationsVector(const std::vector<qm::Operation>& operations) {
         return;
     }
 
-    // ʱͻΧ
+    // 分析时间和机器范围
     int minTime = operations[0].start_time;
     int maxTime = operations[0].end_time;
     int minMachine = operations[0].machine_id;
@@ -1045,15 +3198,15 @@ void printOperationsVector(const std::vector<qm::Operation>& operations) {
     DATA_DEBUG("Time range: " << minTime << " - " << maxTime << " (duration: " << (maxTime - minTime) << ")");
     DATA_DEBUG("Machine range: " << minMachine << " - " << maxMachine << " (count: " << (maxMachine - minMachine + 1) << ")");
 
-    // ص
+    // 检查重叠
     checkOperationsOverlap(operations);
 }
 
-// 
+// 创建测试数据
 std::vector<qm::Operation> createTestData(int jobCount, int stagesPerJob, int machineCount) {
     std::vector<qm::Operation> operations;
 
-    // ÿ̨ĵǰʱ
+    // 每台机器的当前时间
     std::vector<int> machineCurrentTime(machineCount, 0);
 
     int currentTime = 0;
@@ -1064,18 +3217,27 @@ std::vector<qm::Operation> createTestData(int jobCount, int stagesPerJob, int ma
             op.stage = stage;
             op.machine_id = (job * stagesPerJob + stage) % machineCount;
 
-            // ȷص
+            // 确保不重叠
             op.start_time = std::max(currentTime, machineCurrentTime[op.machine_id]);
-            op.end_time = op.start_time + 20 + (rand() % 30); // 20-50ʱ䵥λ
-            op.is_critical = (rand() % 4 == 0); // 25%Ϊؼ·
+            op.end_time = op.start_time + 20 + (rand() % 30); // 20-50时间单位
+            op.is_critical = (rand() % 4 == 0); // 25%概率为关键路径
 
-            // »ʱ
-            machineCurrentTime[op.machine_id] = op.end_time + 2; // Ӽ
+            // 更新机器时间
+            machineCurrentTime[op.machine_id] = op.end_time + 2; // 添加间隔
 
             operations.push_back(op);
-            currentTime = op.end_time + (rand() % 5); // 0-4ʱ䵥λ
+            currentTime = op.end_time + (rand() % 5); // 0-4时间单位间隔
         }
     }
 
     return operations;
-}
\ No newline at end of file
+}
+
+// === 显式实例化 ===
+template class BasicGanttChart<int>;
+template class BasicGanttChart<long long>;
+template class BasicGanttChart<double>;
+
+template std::vector<qm::BasicOperation<int>> loadBasicOperationsFromCSV<int>(const std::string&);
+template std::vector<qm::BasicOperation<long long>> loadBasicOperationsFromCSV<long long>(const std::string&);
+template std::vector<qm::BasicOperation<double>> loadBasicOperationsFromCSV<double>(const std::string&);
\ No newline at end of file
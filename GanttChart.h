@@ -2,7 +2,22 @@
 #define GANTT_CHART_H
 
 #include "data.h"
-#include "GanttConfig.h" // ʹļ
+#include "OperationView.h"
+#include "ArrowImport.h"
+#include "JsonReader.h"
+#include "ShmSchedule.h"
+#include "ScheduleServer.h"
+#include "ScheduleHistory.h"
+#include "ScheduleDiff.h"
+#include "OccupancyHeatmap.h"
+#include "LoadProfile.h"
+#include "IdleGapIndex.h"
+#include "MachineGroups.h"
+#include "GanttConfig.h" // 使用配置文件
+#include "LabelCache.h"
+#include "FrameProfiler.h"
+#include "UpdateStats.h"
+#include "Logger.h"
 #include <SFML/Graphics.hpp>
 #include <iostream>
 #include <vector>
@@ -10,276 +25,742 @@
 #include <sstream>
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <cctype>
+#include <cstdio>
 #include <chrono>
 #include <mutex>
+#include <memory>
+#include <type_traits>
+#include <limits>
 
-// ========== Ժ궨壨ʹļƣ==========
+// ========== 调试宏定义（使用配置文件控制）==========
 #if GanttConfig::DebugConfig::ENABLE_CSV_DEBUG
-#define CSV_DEBUG(x) do { std::cout << "[CSV] " << x << std::endl; } while(0)
-#define CSV_DEBUG_DETAILED(x) do { std::cout << "[CSV_DETAIL] " << x << std::endl; } while(0)
+#define CSV_DEBUG(x) GANTT_LOG(LogLevel::Debug, "[CSV] " << x)
+#define CSV_DEBUG_DETAILED(x) GANTT_LOG(LogLevel::Debug, "[CSV_DETAIL] " << x)
 #else
 #define CSV_DEBUG(x) do {} while(0)
 #define CSV_DEBUG_DETAILED(x) do {} while(0)
 #endif
 
 #if GanttConfig::DebugConfig::ENABLE_DATA_ANALYSIS
-#define DATA_DEBUG(x) do { std::cout << "[DATA] " << x << std::endl; } while(0)
-#define OVERLAP_DEBUG(x) do { std::cout << "[OVERLAP] " << x << std::endl; } while(0)
+#define DATA_DEBUG(x) GANTT_LOG(LogLevel::Debug, "[DATA] " << x)
+#define OVERLAP_DEBUG(x) GANTT_LOG(LogLevel::Debug, "[OVERLAP] " << x)
 #else
 #define DATA_DEBUG(x) do {} while(0)
 #define OVERLAP_DEBUG(x) do {} while(0)
 #endif
 
 #if GanttConfig::DebugConfig::ENABLE_DRAWING_DEBUG
-#define DRAW_DEBUG(x) do { std::cout << "[DRAW] " << x << std::endl; } while(0)
+#define DRAW_DEBUG(x) GANTT_LOG(LogLevel::Debug, "[DRAW] " << x)
 #else
 #define DRAW_DEBUG(x) do {} while(0)
 #endif
 
 #if GanttConfig::DebugConfig::ENABLE_RANGE_DEBUG
-#define RANGE_DEBUG(x) do { std::cout << "[RANGE] " << x << std::endl; } while(0)
+#define RANGE_DEBUG(x) GANTT_LOG(LogLevel::Debug, "[RANGE] " << x)
 #else
 #define RANGE_DEBUG(x) do {} while(0)
 #endif
 
 #if GanttConfig::DebugConfig::ENABLE_PERFORMANCE_DEBUG
-#define PERF_DEBUG(x) do { std::cout << "[PERF] " << x << std::endl; } while(0)
+#define PERF_DEBUG(x) GANTT_LOG(LogLevel::Debug, "[PERF] " << x)
 #else
 #define PERF_DEBUG(x) do {} while(0)
 #endif
 
-// ͨõԺ
-#define INFO(x) do { std::cout << "[INFO] " << x << std::endl; } while(0)
-#define ERROR(x) do { std::cerr << "[ERROR] " << x << std::endl; } while(0)
-#define WARNING(x) do { std::cout << "[WARNING] " << x << std::endl; } while(0)
+// 通用调试宏（异步输出，见 Logger.h）
+#define INFO(x) GANTT_LOG(LogLevel::Info, x)
+#define ERROR(x) GANTT_LOG(LogLevel::Error, x)
+#define WARNING(x) GANTT_LOG(LogLevel::Warning, x)
+
+// 限频版本，用于每帧或每次交互都可能触发的消息
+#define INFO_RATE_LIMITED(x) GANTT_LOG_RATE_LIMITED(LogLevel::Info, x)
+#define WARNING_RATE_LIMITED(x) GANTT_LOG_RATE_LIMITED(LogLevel::Warning, x)
+#define PERF_DEBUG_RATE_LIMITED(x) GANTT_LOG_RATE_LIMITED(LogLevel::Debug, "[PERF] " << x)
+
+// 甘特图绘制类，按时间类型模板化（int / long long / double）
+template<typename TimeT>
+class BasicGanttChart {
+public:
+    using TimeType = TimeT;
+    using Operation = qm::BasicOperation<TimeT>;
+    using Data = qm::BasicData<TimeT>;
+    using View = qm::OperationView<TimeT>;
+    using Delta = qm::BasicScheduleDelta<TimeT>;
+    using GapFit = typename BasicIdleGapIndex<TimeT>::Fit;
 
-// ͼ
-class GanttChart {
 private:
     sf::RenderWindow& window;
     sf::Font font;
-    std::vector<qm::Operation> operations;
+    std::vector<Operation> ownedOperations; // 拷贝模式下的数据副本；借用模式下为空
+    View operations;                        // 所有读取都经过视图，指向副本或调用方的内存
+    std::shared_ptr<const void> borrowedSource; // 借用数据的持有者（Arrow 批次、共享内存槽租约），随下一次更新释放
+    bool borrowedData = false;              // operations 是否引用外部内存（增量更新前需先拷贝）
     std::map<int, sf::Color> jobColors;
-    bool debugOutputShown = false;  // ӱ־ظϢ
-
-    // ͼ - ļȡĬֵ
+    bool debugOutputShown = false;  // 添加标志，避免重复输出调试信息
+
+    // 绘制批次 - 每帧复用，稳态下不分配内存
+    LabelCache labelCache;
+    sf::VertexArray shapeBatch;
+
+    // 行虚拟化 - 稀疏机器ID压缩为连续行，只遍历可见行
+    std::vector<int> rowMachines;    // 行号 -> 机器ID（升序）
+    std::vector<int> rowOffsets;     // 每行在 rowOperations 中的起始位置（CSR，长度为行数+1）
+    std::vector<int> rowOperations;  // 按行分组、行内按开始时间排序的操作下标
+    std::vector<TimeT> rowMaxDuration; // 每行最长操作的时长，用于二分定位第一个可见操作
+    std::vector<TimeT> rowMaxEnd;      // 与 rowOperations 对齐：行内截至该位置的最大结束时间（单调不减），用于区间查询
+    bool draggingScrollbar = false;
+    float scrollbarGrabOffset = 0.0f;
+
+    // 帧阶段性能分析
+    FrameProfiler profiler;
+    bool showProfilerHud = GanttConfig::DebugConfig::ENABLE_FPS_COUNTER;
+
+    // 更新流水线延迟与吞吐统计
+    UpdatePipelineStats updateStats;
+
+    // 数据源状态（例如套接字服务的各客户端吞吐），显示在右上角
+    std::vector<std::string> sourceStatusLines;
+    std::uint64_t sourceStatusVersion = 0;
+
+    // 历史记录与回放
+    BasicScheduleRecorder<TimeT>* recorder = nullptr;              // 每次数据更新后追加快照（回放期间暂停）
+    std::unique_ptr<BasicScheduleHistoryReader<TimeT>> replay;     // 回放模式下打开的历史文件
+    std::vector<Operation> replayBuffer;                           // 跳转结果，随后换入内部存储
+    size_t replayRecord = 0;          // 当前显示的记录
+    double replayPosition = 0.0;      // 播放位置（记录序号，带小数）
+    double replaySpeed = GanttConfig::HistoryConfig::REPLAY_DEFAULT_SPEED;
+    bool replayPlaying = false;
+    bool replaySeekPending = false;   // 进度条拖动或单步请求的跳转，在 updateReplay 中执行
+    bool draggingReplayBar = false;
+    std::chrono::steady_clock::time_point replayLastTick;
+
+    // 内存历史环：在最近的若干个调度间前后单步
+    std::unique_ptr<BasicScheduleHistoryRing<TimeT>> historyRing;
+    size_t historyCursor = 0;         // 浏览时显示的记录序号
+    bool browsingHistory = false;     // 浏览期间到达的新数据只追加到历史环，不替换显示
+    Delta historyStep;                // 单步增量（复用）
+
+    // 差异视图：与基准调度的对比结果，任何数据更新都会清除
+    qm::ScheduleDiff scheduleDiff;
+    std::vector<std::uint8_t> diffFlags;  // 与 operations 下标对齐的差异标志
+    struct DiffGhost {
+        Operation operation;              // 基准中的操作
+        std::uint8_t flags;
+    };
+    std::vector<DiffGhost> diffGhosts;    // 位置变化或删除的操作在基准中的位置
+    bool diffActive = false;
+    bool showDiffOverlay = true;
+
+    // 种群占用热力图叠加层（setOccupancyHeatmap 时拷贝的快照，与显示的调度无关）
+    std::vector<int> heatMachines;         // 热力图行 -> 机器ID（升序）
+    std::vector<std::uint8_t> heatLevels;  // 行数 * 桶数，量化后的占用率
+    double heatStartTime = 0.0;
+    double heatBucketWidth = 0.0;
+    int heatBuckets = 0;
+    bool showHeatmap = true;
+
+    // 全厂负载曲线：显示时每次数据更新重建，绘制时按像素列重采样
+    BasicLoadProfile<TimeT> loadProfile;
+    std::vector<float> loadBusy;           // 每个像素列的平均忙碌机器数（复用）
+    std::vector<float> loadCritical;       // 每个像素列的平均关键操作数（复用）
+    bool showLoadCurve = false;
+
+    // 时间游标：绘制时只对可见行查询
+    double cursorTime = 0.0;
+    bool cursorActive = false;
+    bool draggingCursor = false;
+
+    // 空闲区间索引：全量更新时由行索引重建，增量更新时只重建涉及的机器
+    BasicIdleGapIndex<TimeT> gapIndex;
+    std::vector<std::pair<TimeT, TimeT>> gapScratch;   // 绘制底纹时复用
+    bool gapIndexEnabled = false;
+    bool gapIndexCurrent = false;     // 增量已应用到索引，refreshDerivedData 不必重建
+    bool showIdleGaps = false;
+
+    // 机器分组：显示行（line）由分组行与展开分组中的机器行（row）组成，没有分组时两者相同
+    MachineGroups machineGroups;
+    std::vector<char> groupExpanded;          // 与 machineGroups 的分组对齐，默认折叠
+    std::vector<int> rowGroups;               // 机器行 -> 直接所属的分组，-1 表示未分组
+    std::vector<int> groupMachineCounts;      // 各分组（含下级）中有操作的机器数
+    std::vector<int> displayLines;            // 显示行 -> 机器行（>= 0）或 -(分组 + 1)；为空时与机器行相同
+    std::vector<int> rowLines;                // 机器行 -> 显示行，所在分组折叠时为 -1
+    std::vector<std::uint8_t> groupLevels;    // 分组数 * 桶数，量化后的汇总占用率，每次数据更新计算一次
+    double groupStartTime = 0.0;
+    double groupBucketWidth = 0.0;
+
+    // 图表参数 - 从配置文件读取默认值
     float leftMargin;
     float topMargin;
-    float bottomMargin;
+    float bottomMargin;                       // 配置的底部边距，不含负载曲线区
     float rightMargin;
     float barHeight;
     float barSpacing;
 
-    // ʱͻΧ
-    int minTime, maxTime;
+    // 时间和机器范围
+    TimeT minTime, maxTime;
     int minMachine, maxMachine;
-    float timeScale;
+    double timeScale;        // 每个时间单位的像素数
 
-    // źƽƲ - ļȡĬֵ
-    float zoomLevel;
-    float offsetX;
+    // 缩放和平移参数 - 从配置文件读取默认值
+    // 水平方向以图表左边缘对应的时间作为相机原点（double），屏幕坐标由相对原点的差值计算，
+    // 顶点坐标始终是较小的数值
+    double zoomLevel;
+    double viewStartTime;
     float offsetY;
 
-    // ̰߳ȫ
+    // 线程安全
     mutable std::mutex dataMutex;
     bool isInitialized = false;
 
 public:
-    explicit GanttChart(sf::RenderWindow& win);
+    explicit BasicGanttChart(sf::RenderWindow& win);
 
-    // === Ҫӿ ===
+    // === 主要接口 ===
 
     /**
-     * @brief ʼ״̬ĸͼ
-     * @param fontPath ļ·ѡʹļĬֵ
-     * @return ɹtrueʧܷfalse
+     * @brief 初始化空状态的甘特图
+     * @param fontPath 字体文件路径（可选，使用配置文件默认值）
+     * @return 成功返回true，失败返回false
      */
     bool init(const std::string& fontPath = "");
 
     /**
-     * @brief ǰһʾƵǰʾupdateܣ
-     * @param newData µĲ
-     * @param immediate_draw ǷƵڣĬtrue
-     * @return ɹtrueʧܷfalse
+     * @brief 清空前一个显示，绘制当前的显示（update功能）
+     * @param newData 新的操作数据
+     * @param immediate_draw 是否立即绘制到窗口（默认true）
+     * @return 成功返回true，失败返回false
+     */
+    bool update(const Data& newData, bool immediate_draw = true);
+
+    /**
+     * @brief 清空前一个显示，绘制当前的显示（update功能）- 重载版本
+     * @param newOperations 新的操作数据向量
+     * @param immediate_draw 是否立即绘制到窗口（默认true）
+     * @return 成功返回true，失败返回false
+     */
+    bool update(const std::vector<Operation>& newOperations, bool immediate_draw = true);
+
+    /**
+     * @brief 从调用方的自有布局更新（拷贝一次到内部存储）
+     * @param view 描述调用方内存的视图，调用返回后即可释放
+     */
+    bool update(const View& view, bool immediate_draw = true);
+
+    /**
+     * @brief 零拷贝更新：直接引用调用方的内存
+     * @param view 描述调用方内存的视图
+     * @note 在下一次 update/updateBorrowed/setData 之前，调用方必须保持该内存有效且不被修改
+     */
+    bool updateBorrowed(const View& view, bool immediate_draw = true);
+
+    /**
+     * @brief 通过 Arrow C 数据接口导入记录批次（struct 数组）并更新
+     * @param array, schema 所有权转移给图表（无论成功与否），类型一致的列零拷贝引用，直到下一次更新
+     * @param names 列名映射（默认与 qm::Operation 字段名一致）
+     * @return 成功返回true，列缺失或类型不支持时返回false
+     */
+    bool updateFromArrow(ArrowArray* array, ArrowSchema* schema, bool immediate_draw = true,
+        const ArrowColumnNames& names = ArrowColumnNames());
+
+    /**
+     * @brief 显示共享内存环中的最新完整槽（零拷贝，见 ShmSchedule.h）
+     * @param reader 已打开的读者，通常在主循环中每帧调用
+     * @return 有新数据并已更新时返回true，没有新数据时返回false
+     * @note 槽在下一次更新之前保持固定，写者会绕过它
+     */
+    bool updateFromShm(qm::BasicShmScheduleReader<TimeT>& reader, bool immediate_draw = true);
+
+    /**
+     * @brief 应用以 (job_id, stage) 为键的增量：先删除，再按键覆盖或追加
+     * @note 当前数据为借用模式时先拷贝到内部存储
+     */
+    bool applyDelta(const Delta& delta, bool immediate_draw = true);
+
+    /**
+     * @brief 取走套接字服务中显示客户端的更新（完整快照或合并后的增量），并刷新右上角的客户端统计
+     * @param server 已启动的服务，通常在主循环中每帧调用
+     * @return 有新数据并已更新时返回true
+     */
+    bool updateFromServer(BasicScheduleServer<TimeT>& server, bool immediate_draw = true);
+
+    /**
+     * @brief 设置右上角显示的数据源状态文本，空向量表示不显示
+     */
+    void setSourceStatus(const std::vector<std::string>& lines);
+
+    // === 历史记录与回放 ===
+
+    /**
+     * @brief 每次数据更新后把新数据追加到记录器（nullptr 停止记录），记录器由调用方拥有
+     */
+    void setRecorder(BasicScheduleRecorder<TimeT>* historyRecorder);
+
+    /**
+     * @brief 打开历史文件进入回放模式并显示第一条记录
+     * @note 回放模式下底部显示进度条：点击或拖动跳转，P 播放/暂停，[ ] 调整速度，逗号/句号单步
+     */
+    bool openReplay(const std::string& filename);
+
+    /**
+     * @brief 退出回放模式（保留当前显示的数据）
+     */
+    void closeReplay();
+
+    bool isReplaying() const;
+
+    /**
+     * @brief 跳转到指定记录（超出范围时取最后一条）
+     */
+    bool seekReplay(size_t record, bool immediate_draw = true);
+
+    /**
+     * @brief 设置播放速度（记录/秒）
+     */
+    void setReplaySpeed(double recordsPerSecond);
+    void setReplayPlaying(bool playing);
+
+    /**
+     * @brief 推进回放：播放中按速度前进，并执行进度条拖动等交互请求的跳转；通常在主循环中每帧调用
+     * @return 显示的记录发生变化时返回true
+     */
+    bool updateReplay(bool immediate_draw = false);
+
+    /**
+     * @brief 在内存中保留最近的调度（每次数据更新后追加），超出内存预算或条数上限时淘汰最旧的
+     * @note 逗号/句号后退/前进一步，L 回到最新；回放模式下这些键用于回放
+     */
+    void enableHistory(size_t memoryBudgetBytes = static_cast<size_t>(GanttConfig::HistoryConfig::RING_MEMORY_BUDGET_MB) << 20,
+        size_t maxEntries = GanttConfig::HistoryConfig::RING_MAX_ENTRIES);
+    void disableHistory();
+
+    /**
+     * @brief 在历史中前后移动 steps 步（负数后退）；移动到最新一条时回到实时显示
+     * @return 显示的记录发生变化时返回true
+     */
+    bool stepHistory(int steps, bool immediate_draw = true);
+
+    // 正在显示较早的调度（新数据暂不显示）
+    bool isBrowsingHistory() const;
+
+    /**
+     * @brief 以 before 为基准与当前显示的调度对比，并在图表上叠加差异
+     * @note 未变化的操作淡化显示，变化的操作按类型描边，旧位置以半透明块显示；V 键切换叠加层
+     */
+    bool showDiff(const View& before, bool immediate_draw = true);
+
+    /**
+     * @brief 用 next 替换显示的调度并叠加相对替换前的差异；只把变化的操作作为增量应用
+     */
+    bool updateWithDiff(const View& next, bool immediate_draw = true);
+
+    void clearDiff();
+    void setDiffOverlayVisible(bool visible);
+
+    /**
+     * @brief 当前差异的统计，没有差异时返回false
+     */
+    bool getDiffCounts(qm::ScheduleDiffCounts& counts) const;
+
+    /**
+     * @brief 把种群占用热力图作为颜色映射层画在操作之下（拷贝一份量化后的快照，按机器ID对应显示的行）
+     * @note 热力图更新后需要再次调用；H 键显示/隐藏
      */
-    bool update(const qm::Data& newData, bool immediate_draw = true);
+    void setOccupancyHeatmap(const BasicOccupancyHeatmap<TimeT>& heatmap, bool immediate_draw = false);
+    void clearOccupancyHeatmap();
 
     /**
-     * @brief ǰһʾƵǰʾupdateܣ- ذ汾
-     * @param newOperations µĲ
-     * @param immediate_draw ǷƵڣĬtrue
-     * @return ɹtrueʧܷfalse
+     * @brief 在时间轴下方显示全厂负载曲线：忙碌机器数与进行中的关键操作数（底部边距相应增加）
+     * @note U 键显示/隐藏
      */
-    bool update(const std::vector<qm::Operation>& newOperations, bool immediate_draw = true);
+    void setLoadCurveVisible(bool visible);
+    bool isLoadCurveVisible() const;
 
-    // === ԭйܽӿڣּԣ===
+    /**
+     * @brief 区间查询：时刻 t 正在进行的操作（start <= t < end），按机器ID、开始时间排序
+     * @note 每台机器两次二分查找，代价为 O(机器数 × log 操作数 + 结果数)
+     */
+    std::vector<Operation> operationsAt(TimeT t) const;
 
     /**
-     * @brief ֱ
+     * @brief 区间查询：与 [t0, t1) 有重叠的操作，按机器ID、开始时间排序；t1 不大于 t0 时等同于 operationsAt(t0)
      */
-    void setData(const std::vector<qm::Operation>& ops);
+    std::vector<Operation> operationsIn(TimeT t0, TimeT t1) const;
 
     /**
-     * @brief CSVļݲʾ
-     * @param filename CSVļ·
-     * @return ɹtrue
+     * @brief 显示时间游标：竖线标出时刻 t，高亮各可见行正在进行的操作，并在右上角列出每台机器的当前操作与排队数
+     * @note T 键显示/隐藏，显示时在图表内按住左键拖动游标
+     */
+    void setTimeCursor(TimeT t);
+    void clearTimeCursor();
+    bool getTimeCursor(TimeT& t) const;
+
+    /**
+     * @brief 维护每台机器的空闲区间索引，供插入/修复启发式查询（见 IdleGapIndex.h）
+     * @note 全量更新时由行索引重建；增量更新（applyDelta、历史单步）只重建涉及的机器
+     */
+    void setIdleGapIndexEnabled(bool enabled);
+
+    /**
+     * @brief 空闲区间查询，语义同 BasicIdleGapIndex 的 firstFit / bestFit；未启用索引时返回false
+     */
+    bool findFirstFit(int machineId, TimeT duration, TimeT t0, TimeT t1, GapFit& fit) const;
+    bool findFirstFit(TimeT duration, TimeT t0, TimeT t1, GapFit& fit) const;
+    bool findBestFit(TimeT duration, TimeT t0, TimeT t1, GapFit& fit) const;
+
+    /**
+     * @brief 在操作之下给空闲区间加底纹（显示时同时启用索引）；G 键切换
+     */
+    void setIdleGapsVisible(bool visible);
+
+    /**
+     * @brief 从旁路文件加载机器分组（格式见 MachineGroups.h），每个分组显示为一行可折叠的汇总占用
+     * @note 点击分组行展开/折叠，= 键全部展开，- 键全部折叠；只有展开的分组才绘制其中机器的操作
+     */
+    bool loadMachineGroups(const std::string& filename);
+    void setMachineGroups(const MachineGroups& groups);
+    void clearMachineGroups();
+
+    /**
+     * @brief 按完整路径展开/折叠分组，分组不存在时返回false
+     */
+    bool setGroupExpanded(const std::string& path, bool expanded);
+    void setAllGroupsExpanded(bool expanded);
+
+    // === 原有功能接口（保持兼容性）===
+
+    /**
+     * @brief 直接设置数据
+     */
+    void setData(const std::vector<Operation>& ops);
+
+    /**
+     * @brief 从CSV文件加载数据并更新显示
+     * @param filename CSV文件路径
+     * @return 成功返回true
      */
     bool loadFromCSV(const std::string& filename);
 
     /**
-     * @brief Ƹͼ
+     * @brief 从 JSON 数组或 NDJSON 文件加载数据并更新显示（格式见 JsonReader.h）
+     * @param filename JSON文件路径
+     * @return 成功返回true
+     */
+    bool loadFromJSON(const std::string& filename);
+
+    /**
+     * @brief 绘制甘特图
      */
     void draw();
 
     /**
-     * @brief ӡѼصݽ֤
+     * @brief 打印已加载的数据进行验证
      */
     void printLoadedData();
 
     /**
-     * @brief õԱ־
+     * @brief 重置调试标志
      */
     void resetDebugFlag();
 
     /**
-     * @brief 
+     * @brief 处理鼠标滚轮缩放（以图表中心为锚点）
      */
     void handleMouseWheel(float delta);
 
     /**
-     * @brief ƽ
+     * @brief 处理鼠标滚轮缩放，鼠标下的时间保持不动
+     * @param mouseX 鼠标的窗口X坐标
+     */
+    void handleMouseWheel(float delta, float mouseX);
+
+    /**
+     * @brief 处理键盘平移
      */
     void handleKeyboard();
 
     /**
-     * @brief ͼ
+     * @brief 重置视图
      */
     void resetView();
 
     /**
-     * @brief SFML¼
+     * @brief 处理SFML事件
      */
     void handleEvent(const sf::Event& event);
 
-    // === ѯӿ ===
+    // === 查询接口 ===
 
     /**
-     * @brief ȡǰ
+     * @brief 获取当前操作数量
      */
     size_t getOperationCount() const;
 
     /**
-     * @brief Ƿص
+     * @brief 检查是否有重叠操作
      */
     bool hasOverlaps() const;
 
     /**
-     * @brief ȡʱ䷶Χ
+     * @brief 命中测试：获取屏幕坐标处的操作
+     * @param x, y 窗口像素坐标
+     * @param result 命中的操作
+     * @return 命中返回true
+     */
+    bool pickOperation(float x, float y, Operation& result) const;
+
+    /**
+     * @brief 获取时间范围
      */
-    void getTimeRange(int& minT, int& maxT) const;
+    void getTimeRange(TimeT& minT, TimeT& maxT) const;
 
     /**
-     * @brief ȡΧ
+     * @brief 获取机器范围
      */
     void getMachineRange(int& minM, int& maxM) const;
 
-    // === ؽӿ ===
+    // === 配置相关接口 ===
 
     /**
-     * @brief ӦԶ岼
+     * @brief 应用自定义布局配置
      */
     void applyLayoutConfig(float leftM, float topM, float bottomM, float rightM);
 
     /**
-     * @brief ӦԶͼ
+     * @brief 应用自定义视图配置
      */
     void applyViewConfig(float zoom, float panSpeed);
 
     /**
-     * @brief ȡǰϢ
+     * @brief 获取当前配置信息
      */
     void printCurrentConfig() const;
 
+    // === 性能分析接口 ===
+
+    /**
+     * @brief 获取帧阶段性能分析器（百分位统计、Chrome trace 导出）
+     */
+    FrameProfiler& getProfiler() { return profiler; }
+
+    /**
+     * @brief 显示/隐藏性能HUD（F3键切换）
+     */
+    void setProfilerHudVisible(bool visible);
+
+    /**
+     * @brief 获取更新流水线统计：各阶段延迟百分位（拷贝、calculateRanges、
+     *        颜色生成、分析、首帧时间）以及吞吐、合并、丢弃计数
+     */
+    UpdateStatsSnapshot getStats() const;
+
+    /**
+     * @brief 将统计快照以JSON格式写入文件
+     * @param filename 输出文件路径
+     * @return 成功返回true
+     */
+    bool dumpStats(const std::string& filename) const;
+
+    /**
+     * @brief 清空统计
+     */
+    void resetStats();
+
 private:
-    // === ˽з ===
+    // === 私有方法 ===
 
-    // ļĬϲ
+    // 从配置文件加载默认参数
     void loadDefaultConfig();
 
-    // Լļ
+    // 尝试加载字体文件
     bool tryLoadFont(const std::string& fontPath);
 
-    // ʱͻķΧ̬
+    // update 的公共实现；borrowed 为 true 时不拷贝，直接使用视图；source 为视图所引用内存的持有者
+    bool updateFromView(const View& view, bool borrowed, bool immediate_draw,
+        std::shared_ptr<const void> source = nullptr);
+
+    // 数据就位后重建行索引、范围与颜色并记录统计（需持锁）
+    void refreshDerivedData(UpdatePipelineStats::Clock::time_point updateStart);
+
+    // 把 ops 换入内部存储并刷新（ops 换出旧数据）
+    void installOperations(std::vector<Operation>& ops, bool immediate_draw);
+
+    // 把增量应用到内部存储，借用的数据先拷贝一次（需持锁，不刷新）
+    size_t applyDeltaLocked(const Delta& delta);
+
+    // 浏览历史期间把新数据追加到历史环而不显示（需持锁）；返回false表示未在浏览
+    bool deferToHistory(const View& view);
+    bool deferToHistory(const Delta& delta);
+    void drawHistoryStatus();
+    void collectDiffGhosts(const View& before, const qm::ScheduleDiff& diff, std::vector<DiffGhost>& ghosts) const;
+    void setDiffLocked(qm::ScheduleDiff& diff, std::vector<DiffGhost>& ghosts, const View& after, bool alignedToOperations);
+    void clearDiffLocked();
+    void applyDiffStyle(std::uint8_t flags, sf::Color& fill, sf::Color& outlineColor, float& outline) const;
+    void appendDiffGhosts(int firstRow, int lastRow);
+    void drawDiffStatus();
+    void appendHeatmap(int firstRow, int lastRow);
+    static sf::Color heatColor(int level);
+    void drawLoadCurve();
+    void appendLoadArea(const std::vector<float>& values, float left, float baseline, float scale, sf::Color color);
+
+    // 回放进度条
+    bool getReplayBarRect(sf::FloatRect& bar) const;
+    void dragReplayBarTo(float x);
+    void drawReplayBar();
+
+    // 计算时间和机器的范围，并动态调整布局（数据变化时调用）
     void calculateRanges();
 
-    // Ϊÿjob_idɫ
+    // calculateRanges 的组成部分：数据统计 O(n)，布局与缩放比例 O(1)
+    void computeDataStats();
+    void updateLayout();
+    void updateTimeScale();
+    void clampView();
+
+    // 为每个job_id生成颜色
     void generateJobColors();
 
-    // HSVתRGB
+    // HSV转RGB
     sf::Color hsvToRgb(float h, float s, float v);
 
-    // ȡĻϵY
-    float getMachineY(int machineId);
-
-    // ȡʱĻϵX
-    float getTimeX(int time);
-
-    // źƽƿ
-    void handleZoom(float delta);
+    // 建立机器行索引（压缩稀疏机器ID）
+    void buildRowIndex();
+
+    // 机器分组：归属、显示行与汇总占用
+    void assignRowGroups();
+    void rebuildDisplayLines();
+    void applyDisplayLines();
+    void computeGroupOccupancy();
+    void appendGroupOccupancy(int group, float y);
+    int getLineRow(int line) const;
+    int getRowLine(int row) const;
+
+    // 行布局与可见行范围（按显示行）
+    float getRowY(int row) const;
+    float getRowPitch() const;
+    float getBottomMargin() const;
+    int getRowCount() const;
+    int getVisibleRowCapacity() const;
+    void getVisibleRows(int& firstRow, int& lastRow) const;
+    int getFirstVisibleRow() const;
+
+    // 按行滚动
+    void scrollToRow(int row);
+    void scrollRows(int deltaRows);
+
+    // 滚动条与鼠标交互
+    bool getScrollbarRects(sf::FloatRect& track, sf::FloatRect& thumb) const;
+    void handleMousePress(float x, float y);
+    void dragScrollbarTo(float y);
+    bool pickOperationLocked(float x, float y, Operation& result) const;
+
+    // 区间查询：第 row 行中可能与 [from, to) 重叠的操作在 rowOperations 中的范围 [first, last)；
+    // closed 为 true 时包括开始时间等于 to 的操作；范围内仍需检查结束时间
+    void getRowCandidates(int row, double from, double to, bool closed, int& first, int& last) const;
+    void collectOperationsLocked(double from, double to, bool closed, std::vector<Operation>& result) const;
+    void drawTimeCursor();
+    void appendIdleGaps(int firstRow, int lastRow);
+
+    // 时间与屏幕X坐标互相转换（相机相对，double 精度）
+    double timeToX(double time) const;
+    double xToTime(double x) const;
+    float getTimeX(TimeT time) const;
+    double getMaxZoomLevel() const;
+
+    // 时间刻度：选择步长并计算可见刻度范围
+    long long chooseTimeStep() const;
+    bool computeTimeTicks(long long& firstTick, long long& lastTick, long long& timeStep) const;
+
+    // 添加缩放和平移控制
+    void handleZoom(float delta, float anchorX);
     void handlePan(float deltaX, float deltaY);
 
-    // ط
+    // 向形状批次追加一个轴对齐矩形
+    void appendRect(float x, float y, float width, float height, const sf::Color& color);
+
+    // 绘制相关方法
     void drawAxes();
     void drawOperations();
     void drawLabels();
+    void drawScrollbar();
+    void drawProfilerHud();
+    void drawSourceStatus();
 
-    // еص
+    // 检查数据中的重叠问题
     void checkOverlaps();
 };
 
-// === ߺ ===
+// 默认使用紧凑的32位时间；其余实例在 GanttChart.cpp 中显式实例化
+using GanttChart = BasicGanttChart<int>;
+using GanttChart64 = BasicGanttChart<long long>;
+using GanttChartF = BasicGanttChart<double>;
+
+extern template class BasicGanttChart<int>;
+extern template class BasicGanttChart<long long>;
+extern template class BasicGanttChart<double>;
+
+// === 工具函数 ===
 
 /**
- * @brief SFML
- * @param window ҪõĴ
+ * @brief 配置SFML窗口设置
+ * @param window 要配置的窗口引用
  */
 void configureWindow(sf::RenderWindow& window);
 
 /**
- * @brief ȡڴ
- * @return úõ
+ * @brief 获取窗口创建设置
+ * @return 配置好的上下文设置
  */
 sf::ContextSettings getWindowContextSettings();
 
 /**
- * @brief CSVļز
- * @param filename CSVļ·
- * @return 
+ * @brief 加载字体，失败时依次尝试配置中的备用字体路径
+ * @return 所有路径都失败时返回false
+ */
+bool loadGanttFont(sf::Font& font, const std::string& fontPath);
+
+/**
+ * @brief HSV转RGB（h 为 0-360 度，s、v 为 0-1）
+ */
+sf::Color hsvToColor(float h, float s, float v);
+
+/**
+ * @brief 从CSV文件加载操作数据
+ * @param filename CSV文件路径
+ * @return 操作数据向量
  */
 std::vector<qm::Operation> loadOperationsFromCSV(const std::string& filename);
 
 /**
- * @brief صĶ
- * @param operations 
+ * @brief 从CSV文件加载指定时间类型的操作数据（long long / double 时间不会被截断）
+ * @param filename CSV文件路径
+ * @return 操作数据向量
+ */
+template<typename TimeT>
+std::vector<qm::BasicOperation<TimeT>> loadBasicOperationsFromCSV(const std::string& filename);
+
+/**
+ * @brief 检查操作重叠的独立函数
+ * @param operations 操作数据
  */
 void checkOperationsOverlap(const std::vector<qm::Operation>& operations);
 
 /**
- * @brief ӡvectorеĲ
- * @param operations 
+ * @brief 打印vector中的操作数据
+ * @param operations 操作数据
  */
 void printOperationsVector(const std::vector<qm::Operation>& operations);
 
 /**
- * @brief 
- * @param jobCount ҵ
- * @param stagesPerJob ÿҵĽ׶
- * @param machineCount 
- * @return Բ
+ * @brief 创建测试数据
+ * @param jobCount 作业数量
+ * @param stagesPerJob 每个作业的阶段数
+ * @param machineCount 机器数量
+ * @return 测试操作数据
  */
 std::vector<qm::Operation> createTestData(int jobCount, int stagesPerJob, int machineCount);
 
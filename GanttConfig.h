@@ -1,6 +1,6 @@
 //
-// GanttChart òļ
-// йʾܡصĲ
+// GanttChart 配置参数文件
+// 集中管理所有显示、性能、调试相关的参数
 //
 #ifndef GANTT_CONFIG_H
 #define GANTT_CONFIG_H
@@ -9,9 +9,9 @@
 
 namespace GanttConfig {
 
-    // ========== ںʾ ==========
+    // ========== 窗口和显示配置 ==========
     struct WindowConfig {
-        // ڲ
+        // 窗口参数
         static const int DEFAULT_WINDOW_WIDTH = 1600;
         static const int DEFAULT_WINDOW_HEIGHT = 900;
         static const int FRAME_RATE_LIMIT = 60;
@@ -20,20 +20,20 @@ namespace GanttConfig {
         static const int OPENGL_MAJOR_VERSION = 2;
         static const int OPENGL_MINOR_VERSION = 1;
 
-        // ֡
+        // 帧控制
         static const int TARGET_FRAME_TIME_MS = 16;  // ~60 FPS
-        static const int MAX_UPDATE_FREQUENCY_MS = 33; // Ƶ ~30 FPS
+        static const int MAX_UPDATE_FREQUENCY_MS = 33; // 最大更新频率 ~30 FPS
     };
 
-    // ========== ͼ ==========
+    // ========== 甘特图布局配置 ==========
     struct LayoutConfig {
-        // ߾
+        // 边距设置
         static constexpr float LEFT_MARGIN = 80.0f;
         static constexpr float TOP_MARGIN = 40.0f;
         static constexpr float BOTTOM_MARGIN = 60.0f;
         static constexpr float RIGHT_MARGIN = 30.0f;
 
-        // ͼ
+        // 条形图参数
         static constexpr float MIN_BAR_HEIGHT = 12.0f;
         static constexpr float MAX_BAR_HEIGHT = 80.0f;
         static constexpr float MIN_BAR_SPACING = 1.0f;
@@ -41,13 +41,17 @@ namespace GanttConfig {
         static constexpr float DEFAULT_BAR_HEIGHT = 25.0f;
         static constexpr float DEFAULT_BAR_SPACING = 2.0f;
 
-        // ֵڶ̬
-        static const int LUXURY_MACHINE_COUNT = 3;      // ݻʾֵ
-        static const int COMFORTABLE_MACHINE_COUNT = 6; // ʾֵ
-        static const int BALANCED_MACHINE_COUNT = 10;   // ƽʾֵ
-        static const int COMPACT_MACHINE_COUNT = 15;    // ʾֵ
+        // 滚动条（机器行超出可见区域时显示）
+        static constexpr float SCROLLBAR_WIDTH = 10.0f;
+        static constexpr float MIN_SCROLLBAR_THUMB = 20.0f;
 
-        // ֱ
+        // 布局阈值（用于动态调整）
+        static const int LUXURY_MACHINE_COUNT = 3;      // 奢华显示阈值
+        static const int COMFORTABLE_MACHINE_COUNT = 6; // 舒适显示阈值
+        static const int BALANCED_MACHINE_COUNT = 10;   // 平衡显示阈值
+        static const int COMPACT_MACHINE_COUNT = 15;    // 紧凑显示阈值
+
+        // 布局比例
         static constexpr float LUXURY_BAR_RATIO = 0.7f;
         static constexpr float COMFORTABLE_BAR_RATIO = 0.75f;
         static constexpr float BALANCED_BAR_RATIO = 0.8f;
@@ -55,108 +59,121 @@ namespace GanttConfig {
         static constexpr float ULTRA_COMPACT_BAR_RATIO = 0.9f;
     };
 
-    // ========== źƽ ==========
+    // ========== 缩放和平移配置 ==========
     struct ViewConfig {
-        // Ų
+        // 缩放参数
         static constexpr float MIN_ZOOM_LEVEL = 0.1f;
         static constexpr float MAX_ZOOM_LEVEL = 5.0f;
         static constexpr float DEFAULT_ZOOM_LEVEL = 1.0f;
         static constexpr float ZOOM_STEP = 0.1f;
 
-        // ƽƲ
+        // 深度缩放：按倍数缩放，上限由时间跨度决定（1个时间单位最多占多少像素），
+        // 视图以 double 时间原点表示，长时间跨度下放大到单位以下也不会抖动
+        static const bool ENABLE_DEEP_ZOOM = true;
+        static constexpr double DEEP_ZOOM_FACTOR_PER_NOTCH = 1.25;    // 每格滚轮的缩放倍数
+        static constexpr double DEEP_ZOOM_MAX_PIXELS_PER_UNIT = 1000.0;
+
+        // 平移参数
         static constexpr float PAN_SPEED = 20.0f;
-        static constexpr float ZOOM_ADJUSTED_PAN_FACTOR = 1.0f; // ʱƽٶȵ
+        static constexpr float ZOOM_ADJUSTED_PAN_FACTOR = 1.0f; // 缩放时平移速度调整
 
-        // ͼ
+        // 视图限制
         static const bool ENABLE_VIEW_CLAMPING = true;
-        static constexpr float VIEW_CLAMP_MARGIN = 50.0f; // ͼ߽
+        static constexpr float VIEW_CLAMP_MARGIN = 50.0f; // 视图边界余量
     };
 
-    // ========== ı ==========
+    // ========== 字体和文本配置 ==========
     struct FontConfig {
-        // 
+        // 字体设置
         static const std::string DEFAULT_FONT_PATH;
         static const std::string FALLBACK_FONT_PATHS[];
         static const int FALLBACK_FONT_COUNT = 4;
 
-        // С
+        // 字体大小
         static const int DEFAULT_FONT_SIZE = 11;
         static const int MIN_FONT_SIZE = 8;
         static const int MAX_FONT_SIZE = 16;
         static const int TITLE_FONT_SIZE = 12;
         static const int STATUS_FONT_SIZE = 10;
 
-        // ıʾֵ
-        static constexpr float MIN_WIDTH_FOR_TEXT = 30.0f;  // ʾıС
-        static constexpr float MIN_HEIGHT_FOR_TEXT = 15.0f; // ʾıС߶
-        static constexpr float TEXT_PADDING = 4.0f;         // ıڱ߾
-
-        // СӦ
-        static constexpr float FONT_SIZE_THRESHOLD_1 = 80.0f;  // еֵ
-        static constexpr float FONT_SIZE_THRESHOLD_2 = 120.0f; // ֵ
+        // 文本显示阈值
+        static constexpr float MIN_WIDTH_FOR_TEXT = 30.0f;  // 显示文本的最小宽度
+        static constexpr float MIN_HEIGHT_FOR_TEXT = 15.0f; // 显示文本的最小高度
+        static constexpr float TEXT_PADDING = 4.0f;         // 文本内边距
+
+        // 字体大小自适应
+        static constexpr float FONT_SIZE_THRESHOLD_1 = 80.0f;  // 中等字体阈值
+        static constexpr float FONT_SIZE_THRESHOLD_2 = 120.0f; // 大字体阈值
+        static const int OPERATION_FONT_SIZE_SMALL = 10;
+        static const int OPERATION_FONT_SIZE_MEDIUM = 12;
+        static const int OPERATION_FONT_SIZE_LARGE = 14;
+        static const int AXIS_LABEL_FONT_SIZE = 10;
+
+        // 标签缓存
+        static const int LABEL_CACHE_CAPACITY = 8192;  // 缓存槽位数（必须是2的幂）
     };
 
-    // ========== ɫʽ ==========
+    // ========== 颜色和样式配置 ==========
     struct ColorConfig {
-        // HSVɫɲ
+        // HSV颜色生成参数
         static constexpr float JOB_COLOR_SATURATION = 0.7f;
         static constexpr float JOB_COLOR_VALUE = 0.9f;
 
-        // ߿
+        // 边框设置
         static const int NORMAL_BORDER_THICKNESS = 1;
         static const int CRITICAL_BORDER_THICKNESS = 2;
 
-        // ɫRGBֵ
-        static const int BACKGROUND_R = 255, BACKGROUND_G = 255, BACKGROUND_B = 255; // ɫ
-        static const int AXIS_R = 0, AXIS_G = 0, AXIS_B = 0;                        // ɫ
-        static const int TEXT_R = 0, TEXT_G = 0, TEXT_B = 0;                        // ɫ
-        static const int CRITICAL_BORDER_R = 255, CRITICAL_BORDER_G = 0, CRITICAL_BORDER_B = 0; // ɫ
-        static const int STATUS_TEXT_R = 0, STATUS_TEXT_G = 0, STATUS_TEXT_B = 255;  // ɫ
+        // 背景和轴颜色（RGB值）
+        static const int BACKGROUND_R = 255, BACKGROUND_G = 255, BACKGROUND_B = 255; // 白色
+        static const int AXIS_R = 0, AXIS_G = 0, AXIS_B = 0;                        // 黑色
+        static const int TEXT_R = 0, TEXT_G = 0, TEXT_B = 0;                        // 黑色
+        static const int CRITICAL_BORDER_R = 255, CRITICAL_BORDER_G = 0, CRITICAL_BORDER_B = 0; // 红色
+        static const int STATUS_TEXT_R = 0, STATUS_TEXT_G = 0, STATUS_TEXT_B = 255;  // 蓝色
 
-        // Ĭҵɫʧʱ
-        static const int DEFAULT_JOB_R = 128, DEFAULT_JOB_G = 128, DEFAULT_JOB_B = 128; // ɫ
+        // 默认作业颜色（当生成失败时）
+        static const int DEFAULT_JOB_R = 128, DEFAULT_JOB_G = 128, DEFAULT_JOB_B = 128; // 灰色
     };
 
-    // ==========  ==========
+    // ========== 性能配置 ==========
     struct PerformanceConfig {
-        // Ӵü
+        // 视窗裁剪
         static const bool ENABLE_VIEWPORT_CULLING = true;
-        static constexpr float CULLING_MARGIN = 20.0f; // ü߽
+        static constexpr float CULLING_MARGIN = 20.0f; // 裁剪边界余量
 
-        // Ż
-        static const bool ENABLE_TEXT_OPTIMIZATION = true;  // ıŻ
-        static const bool ENABLE_OPERATION_LIMIT = false;   // ǷʾĲ
-        static const int MAX_VISIBLE_OPERATIONS = 5000;     // ɼ
+        // 绘制优化
+        static const bool ENABLE_TEXT_OPTIMIZATION = true;  // 文本绘制优化
+        static const bool ENABLE_OPERATION_LIMIT = false;   // 是否限制显示的操作数量
+        static const int MAX_VISIBLE_OPERATIONS = 5000;     // 最大可见操作数
 
-        // Ż
-        static const bool ENABLE_INCREMENTAL_UPDATE = false; // £δʵ֣
-        static const bool ENABLE_DIRTY_CHECKING = false;     // 飨δʵ֣
+        // 更新优化
+        static const bool ENABLE_INCREMENTAL_UPDATE = false; // 增量更新（未实现）
+        static const bool ENABLE_DIRTY_CHECKING = false;     // 脏检查（未实现）
 
-        // ڴ
+        // 内存管理
         static const bool ENABLE_MEMORY_OPTIMIZATION = true;
-        static const int RESERVE_OPERATIONS_SIZE = 1000;    // Ԥ
+        static const int RESERVE_OPERATIONS_SIZE = 1000;    // 预分配操作数量
     };
 
-    // ========== ʱ ==========
+    // ========== 时间轴配置 ==========
     struct TimeAxisConfig {
-        // ʱǩ
-        static const int LABEL_SPACING_PIXELS = 80;  // ʱǩࣨأ
-        static const int MIN_TIME_STEP = 1;          // Сʱ䲽
-        static const int TIME_STEP_CANDIDATES[];     // ѡʱ䲽
+        // 时间标签
+        static const int LABEL_SPACING_PIXELS = 80;  // 时间标签间距（像素）
+        static const int MIN_TIME_STEP = 1;          // 最小时间步长
+        static const int TIME_STEP_CANDIDATES[];     // 候选时间步长
         static const int TIME_STEP_CANDIDATE_COUNT = 6;
 
-        // ̶
+        // 刻度线
         static constexpr float TICK_HEIGHT = 5.0f;
         static const int TICK_THICKNESS = 1;
 
-        // ߣѡ
+        // 网格线（可选）
         static const bool ENABLE_GRID_LINES = false;
         static constexpr float GRID_LINE_ALPHA = 0.3f;
     };
 
-    // ==========  ==========
+    // ========== 调试配置 ==========
     struct DebugConfig {
-        // Կ - ͨ޸ЩֵƵ
+        // 调试开关 - 可以通过修改这些值来控制调试输出
         static const bool ENABLE_CSV_DEBUG = false;
         static const bool ENABLE_DATA_ANALYSIS = false;
         static const bool ENABLE_DRAWING_DEBUG = false;
@@ -164,51 +181,165 @@ namespace GanttConfig {
         static const bool ENABLE_PERFORMANCE_DEBUG = false;
         static const bool ENABLE_OVERLAP_DEBUG = false;
 
-        // 
-        static const int MAX_DEBUG_OPERATIONS_SHOW = 10;  // ʾĵԲ
-        static const int MAX_DEBUG_LINES_PER_FRAME = 50;  // ÿ֡
+        // 调试输出限制
+        static const int MAX_DEBUG_OPERATIONS_SHOW = 10;  // 最多显示的调试操作数
+        static const int MAX_DEBUG_LINES_PER_FRAME = 50;  // 每帧最大调试输出行数
 
-        // ܼ
+        // 性能监控
         static const bool ENABLE_FPS_COUNTER = false;
         static const bool ENABLE_FRAME_TIME_LOG = false;
-        static const int PERFORMANCE_LOG_INTERVAL_FRAMES = 60; // ÿ60֡һϢ
+        static const int PERFORMANCE_LOG_INTERVAL_FRAMES = 60; // 每60帧输出一次性能信息
+        static const int PROFILER_WINDOW_FRAMES = 240;         // 滚动百分位统计窗口（帧）
+        static const int HUD_REFRESH_FRAMES = 15;              // 性能HUD文本刷新间隔（帧）
+        static const std::string TRACE_FILE_PATH;              // Chrome trace-event 输出文件
+
+        // 异步日志
+        static const int DEFAULT_LOG_LEVEL = 1;                // 0=trace 1=debug 2=info 3=warning 4=error 5=off
+        static const int LOG_QUEUE_CAPACITY = 4096;            // 日志队列槽数（2的幂），满时丢弃
+        static const int LOG_MESSAGE_MAX_LENGTH = 240;         // 单条日志最大长度，超出截断
+        static const int LOG_FLUSH_INTERVAL_MS = 10;           // 后台线程空闲时的轮询间隔
+        static const int LOG_RATE_LIMIT_MS = 500;              // 限频日志的最小间隔
     };
 
-    // ==========  ==========
+    // ========== 交互配置 ==========
     struct InteractionConfig {
-        // 
+        // 鼠标滚轮
         static constexpr float MOUSE_WHEEL_ZOOM_FACTOR = 0.1f;
 
-        // Ӧ
+        // 键盘响应
         static const bool ENABLE_KEYBOARD_PAN = true;
         static const bool ENABLE_KEYBOARD_SHORTCUTS = true;
 
-        // ֧֣Ԥ
+        // 触摸支持（预留）
         static const bool ENABLE_TOUCH_SUPPORT = false;
         static constexpr float TOUCH_ZOOM_SENSITIVITY = 1.0f;
     };
 
-    // ========== ãԤչ==========
+    // ========== 动画配置（预留扩展）==========
     struct AnimationConfig {
-        // ͼл
+        // 视图切换动画
         static const bool ENABLE_SMOOTH_TRANSITIONS = false;
         static const int TRANSITION_DURATION_MS = 300;
 
-        // ݸ¶
+        // 数据更新动画
         static const bool ENABLE_UPDATE_ANIMATION = false;
         static const int UPDATE_ANIMATION_DURATION_MS = 200;
 
-        // 
+        // 缓动函数
         static const bool USE_EASING = false;
     };
 
-    // ========== ãԤչ==========
+    // ========== 数据输入配置 ==========
+    struct InputConfig {
+        // JSON / NDJSON 读取
+        static const int JSON_READ_BLOCK_SIZE = 1 << 20;              // 每次读取的块大小（字节）
+        static const long long JSON_PARALLEL_MIN_BYTES = 32LL << 20;  // NDJSON 文件超过此大小时分块并行解析
+        static const int JSON_MAX_DEPTH = 32;                         // 记录的最大嵌套深度，更深的值被忽略
+        static const int JSON_MAX_TOKEN_LENGTH = 64;                  // 键名与数值的最大长度，超出的不参与匹配
+        static const int JSON_STREAM_BATCH_SIZE = 4096;               // 流式读取时每批回调的最大操作数
+        static const int JSON_STREAM_FLUSH_MS = 100;                  // 流式读取时未满的批次最多等待的时间（毫秒）
+        static const int JSON_MAX_REPORTED_ERRORS = 5;                // 每个解析器最多报告的语法错误数
+
+        // 本机套接字调度服务（ScheduleServer.h）
+        static const long long SOCKET_MAX_FRAME_BYTES = 512LL << 20;  // 单帧负载上限，超出时断开该客户端
+        static const int SOCKET_MAX_CLIENTS = 16;                     // 同时连接的客户端上限
+        static const int SOCKET_READ_CHUNK = 256 << 10;               // 每轮每个客户端最多读取的字节数，保证客户端间公平
+        static const int SOCKET_MAX_PENDING_FRAMES = 8;               // 显示中的客户端累积这么多未显示的帧后暂停读取（反压）
+        static const int SOCKET_POLL_TIMEOUT_MS = 100;                // I/O 线程的轮询超时
+        static const int SOCKET_STATS_WINDOW_MS = 1000;               // 吞吐速率的统计窗口
+    };
+
+    // ========== 调度历史配置 ==========
+    struct HistoryConfig {
+        // 记录文件（ScheduleHistory.h）
+        static const int KEYFRAME_INTERVAL = 64;          // 每隔多少条记录写一个完整关键帧，决定跳转时最多重放的增量数
+        static const int KEYFRAME_DELTA_DIVISOR = 4;      // 增量超过操作数的 1/4 时改写关键帧
+        static const int RECORD_QUEUE_DEPTH = 8;          // 等待写入的快照数，写入落后时最新的快照覆盖队尾
+        static const int WRITE_BUFFER_SIZE = 1 << 20;     // 文件写缓冲区大小（字节）
+
+        // 回放
+        static constexpr double REPLAY_DEFAULT_SPEED = 10.0;  // 默认播放速度（记录/秒）
+        static constexpr double REPLAY_MIN_SPEED = 0.25;
+        static constexpr double REPLAY_MAX_SPEED = 4096.0;
+        static constexpr float REPLAY_BAR_HEIGHT = 8.0f;       // 底部进度条高度
+
+        // 内存历史环（前后对比最近的调度）
+        static const int RING_MAX_ENTRIES = 1000;         // 最多保留的调度数
+        static const int RING_MEMORY_BUDGET_MB = 256;     // 编码后的记录与工作缓冲区的内存上限，超出时淘汰最旧的调度
+    };
+
+    // ========== 差异视图配置 ==========
+    struct DiffConfig {
+        static const int PARALLEL_MIN_OPERATIONS = 200000;  // 两侧操作数之和超过此值时按键分区并行哈希连接
+
+        // 叠加层：未变化的操作淡化，有变化的操作按变化类型描边，基准中的旧位置半透明显示
+        static const int DIM_ALPHA = 50;                    // 未变化操作的填充不透明度（0-255）
+        static const int GHOST_ALPHA = 90;                  // 旧位置的不透明度
+        static const int OUTLINE_THICKNESS = 2;
+        static const int MOVED_R = 170, MOVED_G = 0, MOVED_B = 200;        // 换了机器：紫色
+        static const int SHIFTED_R = 255, SHIFTED_G = 140, SHIFTED_B = 0;  // 时间平移或时长变化：橙色
+        static const int CRITICAL_R = 220, CRITICAL_G = 0, CRITICAL_B = 0; // 仅关键标记变化：红色
+        static const int ADDED_R = 0, ADDED_G = 160, ADDED_B = 0;          // 新增：绿色
+    };
+
+    // ========== 种群占用热力图配置 ==========
+    struct HeatmapConfig {
+        static const int DEFAULT_BUCKETS = 512;               // 时间桶数
+        static const int PARALLEL_MIN_OPERATIONS = 100000;    // build 的总操作数超过此值时按槽位分块并行光栅化
+        static const int ALPHA = 170;                         // 叠加层不透明度（0-255）
+        static const int COLOR_LEVELS = 32;                   // 颜色量化级数，相邻同级的桶合并为一个矩形
+    };
+
+    // ========== 负载曲线配置 ==========
+    struct LoadCurveConfig {
+        static constexpr float STRIP_HEIGHT = 48.0f;    // 曲线区高度，显示时底部边距增加 STRIP_HEIGHT + STRIP_GAP
+        static constexpr float STRIP_OFFSET = 40.0f;    // 曲线区顶部到时间轴的距离（刻度标签与回放进度条之下）
+        static constexpr float STRIP_GAP = 4.0f;        // 曲线区与轴标题之间的间距
+        static const int BUSY_R = 70, BUSY_G = 130, BUSY_B = 180;                        // 忙碌机器数（钢蓝）
+        static const int CRITICAL_R = 220, CRITICAL_G = 30, CRITICAL_B = 30, CRITICAL_A = 170;  // 关键操作数（半透明红）
+    };
+
+    // ========== 时间游标配置 ==========
+    struct CursorConfig {
+        static constexpr float PANEL_WIDTH = 320.0f;    // 右上角信息面板宽度
+        static const int PANEL_MAX_LINES = 40;          // 面板最多列出的机器行数（只列出可见行）
+        static const int LINE_R = 230, LINE_G = 110, LINE_B = 0;    // 游标线（橙色）
+        static const int HIGHLIGHT_A = 80;              // 运行中操作的高亮不透明度
+    };
+
+    // ========== 空闲区间配置 ==========
+    struct IdleGapConfig {
+        static constexpr float MIN_SHADE_WIDTH = 2.0f;  // 窄于此宽度（像素）的空闲区间不画底纹
+        static const int R = 120, G = 200, B = 120, A = 90;   // 底纹颜色（半透明绿）
+    };
+
+    // ========== 机器分组配置 ==========
+    struct GroupConfig {
+        static const int OCCUPANCY_BUCKETS = 1024;      // 分组汇总占用的时间桶数（覆盖整个调度跨度）
+        static const int COLOR_LEVELS = 32;             // 占用率量化级数，相邻同级的桶合并为一个矩形
+        static constexpr float INDENT = 10.0f;          // 每级分组标签的缩进（像素）
+        static const int FILL_R = 50, FILL_G = 100, FILL_B = 170;        // 占用颜色，不透明度随占用率增加
+        static const int BACKGROUND_R = 235, BACKGROUND_G = 238, BACKGROUND_B = 245;  // 分组行底色
+    };
+
+    // ========== 小图网格配置 ==========
+    struct GridConfig {
+        static const int CELL_PADDING = 6;              // 单元格之间的间距（像素）
+        static const int TITLE_HEIGHT = 14;             // 单元格标题栏高度
+        static const int TITLE_FONT_SIZE = 10;
+        static const int MIN_ROW_HEIGHT_FOR_GAP = 3;    // 行高不小于此值时在行间留 1 像素空隙
+        static const int MIN_ROW_HEIGHT_FOR_CRITICAL = 4; // 行高不小于此值时关键操作顶部画红线
+        static const bool SHARED_TIME_SCALE = true;     // 所有单元格使用同一时间范围，便于比较完工时间
+        static constexpr float JOB_HUE_STEP = 137.508f; // 作业颜色按首次出现的顺序取黄金角色相，新作业不改变已有颜色
+    };
+
+    // ========== 导出配置（预留扩展）==========
     struct ExportConfig {
-        // ͼƬ
+        // 图片导出
         static const bool ENABLE_PNG_EXPORT = false;
         static const bool ENABLE_SVG_EXPORT = false;
 
-        // Ĭϵ
+        // 默认导出设置
         static const int EXPORT_WIDTH = 1920;
         static const int EXPORT_HEIGHT = 1080;
         static constexpr float EXPORT_SCALE_FACTOR = 2.0f;
@@ -216,6 +347,6 @@ namespace GanttConfig {
 
 } // namespace GanttConfig
 
-// ע⣺̬ԱĶӦ .cpp ļ
+// 注意：静态成员的定义应该在 .cpp 文件中
 
 #endif // GANTT_CONFIG_H
\ No newline at end of file
@@ -0,0 +1,364 @@
+#include "GanttGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    const sf::Color GRID_BACKGROUND(255, 255, 255);
+    const sf::Color TITLE_BACKGROUND(235, 235, 235);
+    const sf::Color FRAME_COLOR(160, 160, 160);
+
+    void appendQuad(sf::VertexArray& batch, float x, float y, float width, float height, const sf::Color& color) {
+        const float r = x + width, b = y + height;
+        batch.append(sf::Vertex(sf::Vector2f(x, y), color));
+        batch.append(sf::Vertex(sf::Vector2f(r, y), color));
+        batch.append(sf::Vertex(sf::Vector2f(x, b), color));
+        batch.append(sf::Vertex(sf::Vector2f(x, b), color));
+        batch.append(sf::Vertex(sf::Vector2f(r, y), color));
+        batch.append(sf::Vertex(sf::Vector2f(r, b), color));
+    }
+
+    std::uint32_t packColor(const sf::Color& color) {
+        std::uint32_t packed;
+        const sf::Uint8 bytes[4] = { color.r, color.g, color.b, color.a };
+        std::memcpy(&packed, bytes, sizeof(packed));
+        return packed;
+    }
+
+    // 以 RGBA 字节顺序填充矩形
+    void fillPixels(std::vector<sf::Uint8>& pixels, int stride, int x0, int y0, int x1, int y1, std::uint32_t color) {
+        for (int y = y0; y < y1; ++y) {
+            sf::Uint8* row = pixels.data() + (static_cast<size_t>(y) * stride + x0) * 4;
+            for (int x = x0; x < x1; ++x, row += 4) {
+                std::memcpy(row, &color, sizeof(color));
+            }
+        }
+    }
+}
+
+template<typename TimeT>
+BasicGanttGrid<TimeT>::BasicGanttGrid(sf::RenderWindow& win) : window(win) {
+    frameBatch.setPrimitiveType(sf::Triangles);
+}
+
+template<typename TimeT>
+bool BasicGanttGrid<TimeT>::init(const std::string& fontPath) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    if (!loadGanttFont(font, fontPath.empty() ? GanttConfig::FontConfig::DEFAULT_FONT_PATH : fontPath)) {
+        WARNING("Could not load any font file. Using default font.");
+    }
+    labelCache.setFont(font);
+    layoutDirty = true;
+    isInitialized = true;
+    INFO("Gantt grid initialized");
+    return true;
+}
+
+template<typename TimeT>
+void BasicGanttGrid<TimeT>::setCellCount(size_t count) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    const size_t previous = cells.size();
+    cells.resize(count);
+    for (size_t i = previous; i < count; ++i) {
+        formatHeader(i);
+    }
+    layoutDirty = true;
+}
+
+template<typename TimeT>
+size_t BasicGanttGrid<TimeT>::getCellCount() const {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    return cells.size();
+}
+
+template<typename TimeT>
+void BasicGanttGrid<TimeT>::setColumns(int columns) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    requestedColumns = std::max(0, columns);
+    layoutDirty = true;
+}
+
+template<typename TimeT>
+void BasicGanttGrid<TimeT>::setSharedTimeScale(bool shared) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    if (sharedTimeScale == shared) return;
+    sharedTimeScale = shared;
+    for (Cell& cell : cells) {
+        cell.dirty = true;
+    }
+}
+
+template<typename TimeT>
+bool BasicGanttGrid<TimeT>::updateCell(size_t index, const View& view) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    if (index >= cells.size()) {
+        ERROR("Grid cell " << index << " out of range (" << cells.size() << " cells)");
+        return false;
+    }
+
+    Cell& cell = cells[index];
+    const size_t count = view.size();
+    cell.operations.resize(count);
+    cell.machines.resize(count);
+    cell.minTime = cell.maxTime = TimeT();
+    for (size_t i = 0; i < count; ++i) {
+        const Operation op = view[i];
+        cell.operations[i] = op;
+        cell.machines[i] = op.machine_id;
+        if (i == 0 || op.start_time < cell.minTime) cell.minTime = op.start_time;
+        if (i == 0 || op.end_time > cell.maxTime) cell.maxTime = op.end_time;
+    }
+    std::sort(cell.machines.begin(), cell.machines.end());
+    cell.machines.erase(std::unique(cell.machines.begin(), cell.machines.end()), cell.machines.end());
+    formatHeader(index);
+    cell.dirty = true;
+    return true;
+}
+
+template<typename TimeT>
+void BasicGanttGrid<TimeT>::setCellTitle(size_t index, const std::string& title) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    if (index >= cells.size()) return;
+    cells[index].title = title;
+    formatHeader(index);
+    frameDirty = true;
+}
+
+template<typename TimeT>
+void BasicGanttGrid<TimeT>::formatHeader(size_t index) {
+    Cell& cell = cells[index];
+    if (cell.operations.empty()) {
+        std::snprintf(cell.header, sizeof(cell.header), "#%zu  (empty)  %s", index, cell.title.c_str());
+    }
+    else {
+        std::snprintf(cell.header, sizeof(cell.header), "#%zu  Cmax %.10g  %s", index,
+            static_cast<double>(cell.maxTime), cell.title.c_str());
+    }
+}
+
+// 按窗口宽高比选择列数，使单元格接近 16:9；布局变化后整个图集重新填充
+template<typename TimeT>
+void BasicGanttGrid<TimeT>::updateLayout() {
+    using Grid = GanttConfig::GridConfig;
+    layoutSize = window.getSize();
+    layoutDirty = false;
+    frameDirty = true;
+    layout.clear();
+    frameBatch.clear();
+
+    const int width = static_cast<int>(layoutSize.x);
+    const int height = static_cast<int>(layoutSize.y);
+    if (width <= 0 || height <= 0) return;
+
+    atlas.create(layoutSize.x, layoutSize.y);
+    pixels.assign(static_cast<size_t>(width) * height * 4, 255);
+    atlas.update(pixels.data(), layoutSize.x, layoutSize.y, 0, 0);
+
+    const int count = static_cast<int>(cells.size());
+    if (count == 0) return;
+
+    int columns = requestedColumns;
+    if (columns <= 0) {
+        const double aspect = static_cast<double>(width) / height;
+        columns = static_cast<int>(std::lround(std::sqrt(count * aspect / (16.0 / 9.0))));
+    }
+    columns = std::max(1, std::min(columns, count));
+    const int rows = (count + columns - 1) / columns;
+    const int pad = Grid::CELL_PADDING;
+    const int cellWidth = std::max(1, (width - pad * (columns + 1)) / columns);
+    const int cellHeight = std::max(1, (height - pad * (rows + 1)) / rows);
+
+    layout.reserve(cells.size());
+    for (int i = 0; i < count; ++i) {
+        CellRect rect;
+        rect.x = pad + (i % columns) * (cellWidth + pad);
+        rect.y = pad + (i / columns) * (cellHeight + pad);
+        rect.width = cellWidth;
+        rect.height = cellHeight;
+        layout.push_back(rect);
+
+        const float x = static_cast<float>(rect.x), y = static_cast<float>(rect.y);
+        const float w = static_cast<float>(rect.width), h = static_cast<float>(rect.height);
+        appendQuad(frameBatch, x, y, w, std::min<float>(h, Grid::TITLE_HEIGHT), TITLE_BACKGROUND);
+        appendQuad(frameBatch, x - 1, y - 1, w + 2, 1, FRAME_COLOR);
+        appendQuad(frameBatch, x - 1, y + h, w + 2, 1, FRAME_COLOR);
+        appendQuad(frameBatch, x - 1, y, 1, h, FRAME_COLOR);
+        appendQuad(frameBatch, x + w, y, 1, h, FRAME_COLOR);
+    }
+
+    for (Cell& cell : cells) {
+        cell.dirty = true;
+    }
+}
+
+// 共享时间范围变化（例如出现了更长的完工时间）时所有单元格都要重绘
+template<typename TimeT>
+void BasicGanttGrid<TimeT>::updateTimeRange() {
+    if (!sharedTimeScale) return;
+
+    bool any = false;
+    TimeT lowest = TimeT(), highest = TimeT();
+    for (const Cell& cell : cells) {
+        if (cell.operations.empty()) continue;
+        if (!any || cell.minTime < lowest) lowest = cell.minTime;
+        if (!any || cell.maxTime > highest) highest = cell.maxTime;
+        any = true;
+    }
+    if (lowest == sharedMinTime && highest == sharedMaxTime) return;
+
+    sharedMinTime = lowest;
+    sharedMaxTime = highest;
+    for (Cell& cell : cells) {
+        if (!cell.operations.empty()) cell.dirty = true;
+    }
+}
+
+template<typename TimeT>
+std::uint32_t BasicGanttGrid<TimeT>::colorForJob(int jobId) {
+    const auto found = jobColors.find(jobId);
+    if (found != jobColors.end()) return found->second;
+
+    const float hue = std::fmod(jobColors.size() * GanttConfig::GridConfig::JOB_HUE_STEP, 360.0f);
+    const std::uint32_t color = packColor(hsvToColor(hue,
+        GanttConfig::ColorConfig::JOB_COLOR_SATURATION, GanttConfig::ColorConfig::JOB_COLOR_VALUE));
+    jobColors.emplace(jobId, color);
+    return color;
+}
+
+/**
+ * @brief 把一个单元格光栅化到绘图区大小的像素缓冲区并上传到图集
+ *
+ * 每个操作至少占一个像素宽；机器行多于像素行时多行共用像素行。
+ * 代价为 O(操作数 + 像素数)，与缩略图中能看清的细节相当，不受操作数量影响绘制调用次数。
+ */
+template<typename TimeT>
+void BasicGanttGrid<TimeT>::rasterizeCell(size_t index) {
+    using Grid = GanttConfig::GridConfig;
+    Cell& cell = cells[index];
+    cell.dirty = false;
+    if (index >= layout.size()) return;
+
+    const CellRect& rect = layout[index];
+    const int plotTop = rect.y + std::min(rect.height, Grid::TITLE_HEIGHT);
+    const int width = rect.width;
+    const int height = rect.y + rect.height - plotTop;
+    if (width <= 0 || height <= 0) return;
+
+    pixels.assign(static_cast<size_t>(width) * height * 4, 255);
+
+    const int rows = static_cast<int>(cell.machines.size());
+    if (rows > 0) {
+        const double t0 = sharedTimeScale ? static_cast<double>(sharedMinTime) : static_cast<double>(cell.minTime);
+        const double t1 = sharedTimeScale ? static_cast<double>(sharedMaxTime) : static_cast<double>(cell.maxTime);
+        const double scale = width / std::max(t1 - t0, 1e-9);
+        const std::uint32_t critical = packColor(sf::Color::Red);
+
+        for (const Operation& op : cell.operations) {
+            const int row = static_cast<int>(std::lower_bound(cell.machines.begin(), cell.machines.end(), op.machine_id)
+                - cell.machines.begin());
+            const int top = std::min(height - 1, static_cast<int>(static_cast<long long>(row) * height / rows));
+            int bottom = std::max(top + 1, static_cast<int>(static_cast<long long>(row + 1) * height / rows));
+            const int rowHeight = bottom - top;
+            if (rowHeight >= Grid::MIN_ROW_HEIGHT_FOR_GAP) --bottom;
+
+            int x0 = static_cast<int>(std::floor((static_cast<double>(op.start_time) - t0) * scale));
+            int x1 = static_cast<int>(std::ceil((static_cast<double>(op.end_time) - t0) * scale));
+            x0 = std::max(0, std::min(width - 1, x0));
+            x1 = std::max(x0 + 1, std::min(width, x1));
+
+            fillPixels(pixels, width, x0, top, x1, bottom, colorForJob(op.job_id));
+            if (op.is_critical && rowHeight >= Grid::MIN_ROW_HEIGHT_FOR_CRITICAL) {
+                fillPixels(pixels, width, x0, top, x1, top + 1, critical);
+            }
+        }
+    }
+
+    atlas.update(pixels.data(), static_cast<unsigned>(width), static_cast<unsigned>(height),
+        static_cast<unsigned>(rect.x), static_cast<unsigned>(plotTop));
+}
+
+template<typename TimeT>
+bool BasicGanttGrid<TimeT>::draw(bool force) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    if (!isInitialized) {
+        ERROR("GanttGrid not initialized. Call init() first.");
+        return false;
+    }
+
+    const sf::Vector2u size = window.getSize();
+    if (size.x != layoutSize.x || size.y != layoutSize.y) {
+        layoutDirty = true;
+    }
+    if (layoutDirty) {
+        updateLayout();
+    }
+    updateTimeRange();
+
+    lastRedrawn = 0;
+    for (size_t i = 0; i < cells.size(); ++i) {
+        if (cells[i].dirty) {
+            rasterizeCell(i);
+            ++lastRedrawn;
+        }
+    }
+    if (lastRedrawn > 0) {
+        frameDirty = true;
+    }
+    if (!frameDirty && !force) {
+        return false;
+    }
+
+    try {
+        window.clear(GRID_BACKGROUND);
+        if (!layout.empty()) {
+            window.draw(sf::Sprite(atlas));
+            window.draw(frameBatch);
+            for (size_t i = 0; i < layout.size(); ++i) {
+                labelCache.appendText(cells[i].header, std::strlen(cells[i].header), GanttConfig::GridConfig::TITLE_FONT_SIZE,
+                    layout[i].x + 3.0f, static_cast<float>(layout[i].y), sf::Color::Black);
+            }
+            labelCache.flush(window);
+        }
+        window.display();
+    }
+    catch (const std::exception& e) {
+        ERROR("Error during grid drawing: " << e.what());
+    }
+
+    frameDirty = false;
+    return true;
+}
+
+template<typename TimeT>
+void BasicGanttGrid<TimeT>::handleEvent(const sf::Event& event) {
+    if (event.type == sf::Event::Resized) {
+        // 保持一像素对应一个坐标单位，否则图集会被拉伸
+        window.setView(sf::View(sf::FloatRect(0.0f, 0.0f,
+            static_cast<float>(event.size.width), static_cast<float>(event.size.height))));
+        std::lock_guard<std::mutex> lock(dataMutex);
+        layoutDirty = true;
+    }
+}
+
+template<typename TimeT>
+int BasicGanttGrid<TimeT>::getCellAt(float x, float y) const {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    for (size_t i = 0; i < layout.size(); ++i) {
+        const CellRect& rect = layout[i];
+        if (x >= rect.x && x < rect.x + rect.width && y >= rect.y && y < rect.y + rect.height) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+template<typename TimeT>
+size_t BasicGanttGrid<TimeT>::getLastRedrawnCount() const {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    return lastRedrawn;
+}
+
+template class BasicGanttGrid<int>;
+template class BasicGanttGrid<long long>;
+template class BasicGanttGrid<double>;
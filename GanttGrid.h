@@ -0,0 +1,134 @@
+//
+// 小图网格：在一个窗口中以缩略图同时显示多个调度（例如遗传算法的整个种群）
+// 所有单元格共享一个字体、一套作业颜色与一个标签缓存；每个单元格按像素光栅化（多个操作落在同一像素时只保留一个），
+// 结果写入共享的图集纹理，只有调度变化的单元格才重新光栅化与上传，每帧绘制图集只需一次绘制调用。
+//
+#ifndef GANTT_GRID_H
+#define GANTT_GRID_H
+
+#include "GanttChart.h"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+template<typename TimeT>
+class BasicGanttGrid {
+public:
+    using Operation = qm::BasicOperation<TimeT>;
+    using View = qm::OperationView<TimeT>;
+
+    explicit BasicGanttGrid(sf::RenderWindow& win);
+
+    /**
+     * @brief 加载共享字体并预热字形缓存
+     */
+    bool init(const std::string& fontPath = "");
+
+    /**
+     * @brief 设置单元格数量；新增的单元格为空，多出的单元格被丢弃
+     */
+    void setCellCount(size_t count);
+    size_t getCellCount() const;
+
+    /**
+     * @brief 设置列数，0 表示按窗口宽高比自动选择
+     */
+    void setColumns(int columns);
+
+    /**
+     * @brief 所有单元格使用同一时间范围（默认），否则各自按自己的范围缩放
+     */
+    void setSharedTimeScale(bool shared);
+
+    /**
+     * @brief 替换一个单元格的调度，下一次 draw 时只重绘该单元格
+     * @return 单元格不存在时返回false
+     */
+    bool updateCell(size_t cell, const View& view);
+    bool updateCell(size_t cell, const std::vector<Operation>& operations) {
+        return updateCell(cell, View::fromRecords(operations));
+    }
+
+    /**
+     * @brief 设置单元格标题（显示在序号与完工时间之后，例如适应度）
+     */
+    void setCellTitle(size_t cell, const std::string& title);
+
+    /**
+     * @brief 重绘有变化的单元格并显示
+     * @param force 没有变化时也重新提交一帧
+     * @return 提交了新的一帧时返回true
+     */
+    bool draw(bool force = false);
+
+    /**
+     * @brief 处理窗口大小变化
+     */
+    void handleEvent(const sf::Event& event);
+
+    /**
+     * @brief 查找窗口坐标所在的单元格，不在任何单元格内时返回-1
+     */
+    int getCellAt(float x, float y) const;
+
+    // 上一次 draw 重新光栅化的单元格数
+    size_t getLastRedrawnCount() const;
+
+private:
+    struct Cell {
+        std::vector<Operation> operations;
+        std::vector<int> machines;    // 行号 -> 机器ID（升序）
+        TimeT minTime = TimeT();
+        TimeT maxTime = TimeT();
+        std::string title;
+        char header[96] = { 0 };      // 预先格式化的标题栏文本
+        bool dirty = true;
+    };
+
+    struct CellRect {
+        int x, y, width, height;      // 整个单元格（含标题栏）
+    };
+
+    void updateLayout();
+    void updateTimeRange();
+    void formatHeader(size_t index);
+    void rasterizeCell(size_t index);
+    std::uint32_t colorForJob(int jobId);
+
+    sf::RenderWindow& window;
+    sf::Font font;
+    LabelCache labelCache;
+    sf::Texture atlas;                // 所有单元格的光栅结果，与窗口同尺寸
+    sf::VertexArray frameBatch;       // 单元格边框
+    std::vector<sf::Uint8> pixels;    // 光栅化缓冲区（RGBA），跨单元格复用
+
+    // 作业颜色：所有单元格共享，按作业首次出现的顺序分配
+    std::unordered_map<int, std::uint32_t> jobColors;
+
+    std::vector<Cell> cells;
+    std::vector<CellRect> layout;
+    int requestedColumns = 0;
+    bool sharedTimeScale = GanttConfig::GridConfig::SHARED_TIME_SCALE;
+    TimeT sharedMinTime = TimeT();
+    TimeT sharedMaxTime = TimeT();
+    sf::Vector2u layoutSize;
+    bool layoutDirty = true;
+    bool frameDirty = true;
+    size_t lastRedrawn = 0;
+    bool isInitialized = false;
+
+    mutable std::mutex dataMutex;
+};
+
+using GanttGrid = BasicGanttGrid<int>;
+using GanttGrid64 = BasicGanttGrid<long long>;
+using GanttGridF = BasicGanttGrid<double>;
+
+extern template class BasicGanttGrid<int>;
+extern template class BasicGanttGrid<long long>;
+extern template class BasicGanttGrid<double>;
+
+#endif // GANTT_GRID_H
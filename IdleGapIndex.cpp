@@ -0,0 +1,351 @@
+#include "IdleGapIndex.h"
+#include <algorithm>
+#include <numeric>
+
+template<typename TimeT>
+void BasicIdleGapIndex<TimeT>::clear() {
+    machineIds.clear();
+    machines.clear();
+    keyIndex.clear();
+    uniqueKeys = true;
+}
+
+template<typename TimeT>
+void BasicIdleGapIndex<TimeT>::build(const View& view) {
+    std::vector<int> order(view.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&view](int a, int b) {
+        if (view.machineId[a] != view.machineId[b]) return view.machineId[a] < view.machineId[b];
+        return view.startTime[a] < view.startTime[b];
+    });
+
+    std::vector<int> offsets;
+    offsets.reserve(64);
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i == 0 || view.machineId[order[i]] != view.machineId[order[i - 1]]) {
+            offsets.push_back(static_cast<int>(i));
+        }
+    }
+    offsets.push_back(static_cast<int>(order.size()));
+    build(view, offsets, order);
+}
+
+template<typename TimeT>
+void BasicIdleGapIndex<TimeT>::build(const View& view, const std::vector<int>& rowOffsets,
+    const std::vector<int>& rowOperations) {
+    clear();
+    keyIndex.reserve(view.size());
+    machineIds.reserve(rowOffsets.size());
+    machines.reserve(rowOffsets.size());
+
+    for (size_t row = 0; row + 1 < rowOffsets.size(); ++row) {
+        if (rowOffsets[row] == rowOffsets[row + 1]) continue;
+        const int machineId = view.machineId[rowOperations[rowOffsets[row]]];
+        machineIds.push_back(machineId);
+        machines.emplace_back();
+        Machine& machine = machines.back();
+
+        machine.busy.reserve(rowOffsets[row + 1] - rowOffsets[row]);
+        for (int k = rowOffsets[row]; k < rowOffsets[row + 1]; ++k) {
+            const int i = rowOperations[k];
+            const Interval interval = { view.startTime[i], view.endTime[i] };
+            machine.busy.push_back(interval);
+            if (!keyIndex.emplace(qm::packKey(view.jobId[i], view.stage[i]), Placement{ machineId, interval }).second) {
+                uniqueKeys = false;
+            }
+        }
+        rebuildGaps(machine);
+    }
+}
+
+// 从按开始时间排序的操作区间得到空闲区间（重叠的操作合并），再建立最大值线段树
+template<typename TimeT>
+void BasicIdleGapIndex<TimeT>::rebuildGaps(Machine& machine) const {
+    machine.gapStarts.clear();
+    machine.gapEnds.clear();
+
+    TimeT cursor = horizonStart;
+    for (const Interval& interval : machine.busy) {
+        if (!(interval.start < interval.end)) continue;
+        if (cursor < interval.start) {
+            machine.gapStarts.push_back(cursor);
+            machine.gapEnds.push_back(interval.start);
+        }
+        if (cursor < interval.end) {
+            cursor = interval.end;
+        }
+    }
+    machine.tail = cursor;
+
+    const size_t count = machine.gapStarts.size();
+    machine.leafCount = 1;
+    while (machine.leafCount < count) {
+        machine.leafCount <<= 1;
+    }
+    machine.maxTree.assign(machine.leafCount * 2, TimeT());
+    for (size_t i = 0; i < count; ++i) {
+        machine.maxTree[machine.leafCount + i] = machine.gapEnds[i] - machine.gapStarts[i];
+    }
+    for (size_t node = machine.leafCount - 1; node >= 1; --node) {
+        machine.maxTree[node] = std::max(machine.maxTree[node * 2], machine.maxTree[node * 2 + 1]);
+    }
+}
+
+// [first, last] 内第一个长度不小于 duration 的空闲区间；只进入最大值足够的子树
+template<typename TimeT>
+int BasicIdleGapIndex<TimeT>::findFirst(const Machine& machine, size_t node, size_t nodeFirst, size_t nodeLast,
+    size_t first, size_t last, TimeT duration) const {
+    if (nodeLast < first || nodeFirst > last || machine.maxTree[node] < duration) return -1;
+    if (nodeFirst == nodeLast) return static_cast<int>(nodeFirst);
+
+    const size_t middle = nodeFirst + (nodeLast - nodeFirst) / 2;
+    const int found = findFirst(machine, node * 2, nodeFirst, middle, first, last, duration);
+    return found >= 0 ? found : findFirst(machine, node * 2 + 1, middle + 1, nodeLast, first, last, duration);
+}
+
+template<typename TimeT>
+const typename BasicIdleGapIndex<TimeT>::Machine* BasicIdleGapIndex<TimeT>::findMachine(int machineId) const {
+    const auto it = std::lower_bound(machineIds.begin(), machineIds.end(), machineId);
+    if (it == machineIds.end() || *it != machineId) return nullptr;
+    return &machines[it - machineIds.begin()];
+}
+
+template<typename TimeT>
+typename BasicIdleGapIndex<TimeT>::Machine& BasicIdleGapIndex<TimeT>::obtainMachine(int machineId) {
+    const auto it = std::lower_bound(machineIds.begin(), machineIds.end(), machineId);
+    const size_t position = static_cast<size_t>(it - machineIds.begin());
+    if (it == machineIds.end() || *it != machineId) {
+        machineIds.insert(it, machineId);
+        machines.insert(machines.begin() + position, Machine());
+    }
+    return machines[position];
+}
+
+// 一次性应用一台机器的全部变化：按开始时间二分标记删除的区间（开始时间相同时比较结束时间），
+// 再与按开始时间排序的新区间归并，O(操作数 + 变化数 × log 操作数)
+template<typename TimeT>
+void BasicIdleGapIndex<TimeT>::applyChanges(Machine& machine, MachineChanges& changes) const {
+    std::vector<Interval>& busy = machine.busy;
+    std::vector<char> erased(busy.size(), 0);
+    for (const Interval& interval : changes.removed) {
+        size_t position = static_cast<size_t>(std::lower_bound(busy.begin(), busy.end(), interval.start,
+            [](const Interval& a, TimeT t) { return a.start < t; }) - busy.begin());
+        for (; position < busy.size() && !(interval.start < busy[position].start); ++position) {
+            if (!erased[position] && !(busy[position].end < interval.end) && !(interval.end < busy[position].end)) {
+                erased[position] = 1;
+                break;
+            }
+        }
+    }
+
+    // 新区间排在开始时间相同的已有区间之后
+    std::stable_sort(changes.added.begin(), changes.added.end(),
+        [](const Interval& a, const Interval& b) { return a.start < b.start; });
+    std::vector<Interval> merged;
+    merged.reserve(busy.size() + changes.added.size());
+    size_t j = 0;
+    for (size_t i = 0; i < busy.size(); ++i) {
+        if (erased[i]) continue;
+        for (; j < changes.added.size() && changes.added[j].start < busy[i].start; ++j) {
+            merged.push_back(changes.added[j]);
+        }
+        merged.push_back(busy[i]);
+    }
+    merged.insert(merged.end(), changes.added.begin() + j, changes.added.end());
+    busy.swap(merged);
+}
+
+template<typename TimeT>
+bool BasicIdleGapIndex<TimeT>::applyDelta(const Delta& delta) {
+    if (!uniqueKeys) return false;
+    if (delta.empty()) return true;
+
+    // 先按机器收集变化；删除的区间总是增量之前的状态（同键的删除先于修改处理，修改已按键去重）
+    std::unordered_map<int, MachineChanges> changes;
+    for (const qm::OperationKey& key : delta.removals) {
+        const auto it = keyIndex.find(qm::packKey(key));
+        if (it == keyIndex.end()) continue;
+        changes[it->second.machineId].removed.push_back(it->second.interval);
+        keyIndex.erase(it);
+    }
+
+    // 同键多次修改时最后一个生效
+    std::unordered_map<std::uint64_t, size_t, qm::KeyHash> lastUpsert;
+    lastUpsert.reserve(delta.upserts.size());
+    for (size_t i = 0; i < delta.upserts.size(); ++i) {
+        lastUpsert[qm::packKey(delta.upserts[i])] = i;
+    }
+    for (size_t i = 0; i < delta.upserts.size(); ++i) {
+        const auto& op = delta.upserts[i];
+        const std::uint64_t key = qm::packKey(op);
+        if (lastUpsert[key] != i) continue;
+
+        auto it = keyIndex.find(key);
+        if (it != keyIndex.end()) {
+            changes[it->second.machineId].removed.push_back(it->second.interval);
+        }
+        const Interval interval = { op.start_time, op.end_time };
+        changes[op.machine_id].added.push_back(interval);
+        keyIndex[key] = Placement{ op.machine_id, interval };
+    }
+
+    // 每台涉及的机器合并一次并重建空闲区间；不再有操作的机器与 build 一致地删除
+    std::vector<int> touched;
+    touched.reserve(changes.size());
+    for (const auto& entry : changes) {
+        touched.push_back(entry.first);
+    }
+    std::sort(touched.begin(), touched.end());
+    for (int machineId : touched) {
+        MachineChanges& change = changes[machineId];
+        auto it = std::lower_bound(machineIds.begin(), machineIds.end(), machineId);
+        if (it == machineIds.end() || *it != machineId) {
+            if (change.added.empty()) continue;
+            obtainMachine(machineId);
+            it = std::lower_bound(machineIds.begin(), machineIds.end(), machineId);
+        }
+        const size_t position = static_cast<size_t>(it - machineIds.begin());
+        applyChanges(machines[position], change);
+        if (machines[position].busy.empty()) {
+            machineIds.erase(it);
+            machines.erase(machines.begin() + position);
+        }
+        else {
+            rebuildGaps(machines[position]);
+        }
+    }
+    return true;
+}
+
+template<typename TimeT>
+void BasicIdleGapIndex<TimeT>::setHorizonStart(TimeT start) {
+    horizonStart = start;
+    for (Machine& machine : machines) {
+        rebuildGaps(machine);
+    }
+}
+
+template<typename TimeT>
+bool BasicIdleGapIndex<TimeT>::firstFit(int machineId, TimeT duration, TimeT t0, TimeT t1, Fit& fit) const {
+    const Machine* machine = findMachine(machineId);
+    if (!machine || !(TimeT() < duration) || t1 < t0 || t1 - t0 < duration) return false;
+
+    // 与窗口相交的空闲区间为 [i0, i1)：结束晚于 t0 且开始早于 t1
+    const size_t i0 = static_cast<size_t>(
+        std::upper_bound(machine->gapEnds.begin(), machine->gapEnds.end(), t0) - machine->gapEnds.begin());
+    const size_t i1 = static_cast<size_t>(
+        std::lower_bound(machine->gapStarts.begin(), machine->gapStarts.end(), t1) - machine->gapStarts.begin());
+
+    auto accept = [&](size_t i, TimeT start) {
+        fit.machineId = machineId;
+        fit.start = start;
+        fit.gapStart = machine->gapStarts[i];
+        fit.gapEnd = machine->gapEnds[i];
+        fit.openEnded = false;
+        return true;
+    };
+    // 首尾两个空闲区间可能被窗口截断
+    auto fitsClipped = [&](size_t i) {
+        const TimeT start = std::max(machine->gapStarts[i], t0);
+        const TimeT end = std::min(machine->gapEnds[i], t1);
+        return !(end - start < duration);
+    };
+
+    if (i0 < i1) {
+        if (fitsClipped(i0)) return accept(i0, std::max(machine->gapStarts[i0], t0));
+        if (i1 - i0 > 2) {
+            const int found = findFirst(*machine, 1, 0, machine->leafCount - 1, i0 + 1, i1 - 2, duration);
+            if (found >= 0) return accept(static_cast<size_t>(found), machine->gapStarts[found]);
+        }
+        if (i1 - 1 > i0 && fitsClipped(i1 - 1)) return accept(i1 - 1, machine->gapStarts[i1 - 1]);
+    }
+
+    const TimeT start = std::max(machine->tail, t0);
+    if (t1 < start || t1 - start < duration) return false;
+    fit.machineId = machineId;
+    fit.start = start;
+    fit.gapStart = machine->tail;
+    fit.gapEnd = machine->tail;
+    fit.openEnded = true;
+    return true;
+}
+
+template<typename TimeT>
+bool BasicIdleGapIndex<TimeT>::firstFit(TimeT duration, TimeT t0, TimeT t1, Fit& fit) const {
+    bool found = false;
+    Fit candidate;
+    for (int machineId : machineIds) {
+        if (!firstFit(machineId, duration, t0, t1, candidate)) continue;
+        if (!found || candidate.start < fit.start) {
+            fit = candidate;
+            found = true;
+            if (!(t0 < fit.start)) break;   // 不可能更早
+        }
+    }
+    return found;
+}
+
+template<typename TimeT>
+bool BasicIdleGapIndex<TimeT>::bestFit(TimeT duration, TimeT t0, TimeT t1, Fit& fit) const {
+    bool found = false;
+    Fit candidate;
+    for (int machineId : machineIds) {
+        if (!firstFit(machineId, duration, t0, t1, candidate)) continue;
+        bool better;
+        if (!found) {
+            better = true;
+        }
+        else if (candidate.openEnded != fit.openEnded) {
+            better = fit.openEnded;
+        }
+        else if (candidate.openEnded) {
+            better = candidate.start < fit.start;
+        }
+        else {
+            const TimeT slack = candidate.gapEnd - candidate.gapStart;
+            const TimeT bestSlack = fit.gapEnd - fit.gapStart;
+            better = slack < bestSlack || (!(bestSlack < slack) && candidate.start < fit.start);
+        }
+        if (better) {
+            fit = candidate;
+            found = true;
+        }
+    }
+    return found;
+}
+
+template<typename TimeT>
+void BasicIdleGapIndex<TimeT>::getGaps(int machineId, double from, double to,
+    std::vector<std::pair<TimeT, TimeT>>& gaps) const {
+    gaps.clear();
+    const Machine* machine = findMachine(machineId);
+    if (!machine) return;
+
+    const auto first = std::upper_bound(machine->gapEnds.begin(), machine->gapEnds.end(), from,
+        [](double t, TimeT end) { return t < end; });
+    for (size_t i = static_cast<size_t>(first - machine->gapEnds.begin());
+        i < machine->gapStarts.size() && machine->gapStarts[i] < to; ++i) {
+        gaps.emplace_back(machine->gapStarts[i], machine->gapEnds[i]);
+    }
+}
+
+template<typename TimeT>
+bool BasicIdleGapIndex<TimeT>::getTail(int machineId, TimeT& tail) const {
+    const Machine* machine = findMachine(machineId);
+    if (!machine) return false;
+    tail = machine->tail;
+    return true;
+}
+
+template<typename TimeT>
+size_t BasicIdleGapIndex<TimeT>::getGapCount() const {
+    size_t count = 0;
+    for (const Machine& machine : machines) {
+        count += machine.gapStarts.size();
+    }
+    return count;
+}
+
+template class BasicIdleGapIndex<int>;
+template class BasicIdleGapIndex<long long>;
+template class BasicIdleGapIndex<double>;
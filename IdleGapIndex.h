@@ -0,0 +1,141 @@
+//
+// 机器空闲区间索引：供插入/修复启发式查询"哪台机器在 [t0, t1] 内有长度不小于 d 的空闲"
+// 每台机器保存按开始时间排序的操作区间，由此得到按开始时间排序的空闲区间（互不重叠，因此也按结束时间排序），
+// 以及空闲长度的最大值线段树。查询时两次二分找到与窗口相交的空闲区间，首尾两个按窗口截断后单独检查，
+// 中间完整的空闲区间在线段树上下降找到第一个足够长的，单台机器 O(log 空闲数)。
+// 最后一个操作结束之后的空闲没有终点，单独保存。
+// 增量按 (job_id, stage) 键应用：查询是对数的，但增量不是——每台涉及的机器把本次的变化与操作区间归并一次，
+// 再重建其空闲区间与线段树，代价为 O(该机器的操作数 + 变化数 × log 操作数)，与未涉及的机器无关。
+//
+#ifndef IDLE_GAP_INDEX_H
+#define IDLE_GAP_INDEX_H
+
+#include "OperationView.h"
+#include "ScheduleDelta.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+template<typename TimeT>
+class BasicIdleGapIndex {
+public:
+    using View = qm::OperationView<TimeT>;
+    using Delta = qm::BasicScheduleDelta<TimeT>;
+
+    // 查询结果
+    struct Fit {
+        int machineId = 0;
+        TimeT start = TimeT();      // 可以放入的最早时刻（不早于 t0）
+        TimeT gapStart = TimeT();   // 所在空闲区间
+        TimeT gapEnd = TimeT();     // openEnded 时无意义
+        bool openEnded = false;     // 位于最后一个操作之后
+    };
+
+    /**
+     * @brief 扫描调度建立索引，先按机器与开始时间排序
+     */
+    void build(const View& view);
+
+    /**
+     * @brief 使用已有的行索引建立索引，省去排序
+     * @param rowOffsets CSR 行起始位置（长度为行数+1），每行对应一台机器
+     * @param rowOperations 按行分组、行内按开始时间排序的操作下标
+     */
+    void build(const View& view, const std::vector<int>& rowOffsets, const std::vector<int>& rowOperations);
+
+    /**
+     * @brief 应用增量（与 qm::applyScheduleDelta 语义相同：先删除后按键覆盖），只重建涉及的机器，
+     *        每台机器的代价与其操作数成线性
+     * @return 调度中有重复的键时无法按键跟踪，返回false且不修改索引，需要重新 build
+     */
+    bool applyDelta(const Delta& delta);
+
+    void clear();
+
+    /**
+     * @brief 设置时间原点：此前的时间不算空闲（默认 0），会重建所有机器的空闲区间
+     */
+    void setHorizonStart(TimeT start);
+    TimeT getHorizonStart() const { return horizonStart; }
+
+    /**
+     * @brief 首次适应：机器上最早的 s，使 [s, s + duration) 位于 [t0, t1] 内且完全空闲
+     * @return 机器不存在、duration 不大于 0 或没有足够的空闲时返回false
+     */
+    bool firstFit(int machineId, TimeT duration, TimeT t0, TimeT t1, Fit& fit) const;
+
+    /**
+     * @brief 所有机器中开始时间最早的首次适应结果（相同时取机器ID较小者），O(机器数 × log 空闲数)
+     */
+    bool firstFit(TimeT duration, TimeT t0, TimeT t1, Fit& fit) const;
+
+    /**
+     * @brief 最佳适应：比较各机器的首次适应结果，取所在空闲区间剩余最少的一个（相同时取开始较早者），
+     *        最后一个操作之后的空闲视为无限长，只在没有其他结果时使用
+     */
+    bool bestFit(TimeT duration, TimeT t0, TimeT t1, Fit& fit) const;
+
+    /**
+     * @brief 与 [from, to) 相交的空闲区间，按开始时间排序（不截断）；最后一个操作之后的空闲不包括在内
+     */
+    void getGaps(int machineId, double from, double to, std::vector<std::pair<TimeT, TimeT>>& gaps) const;
+
+    /**
+     * @brief 最后一个操作的结束时间（此后一直空闲）；机器不存在时返回false
+     */
+    bool getTail(int machineId, TimeT& tail) const;
+
+    const std::vector<int>& getMachines() const { return machineIds; }
+    size_t getGapCount() const;
+
+private:
+    struct Interval {
+        TimeT start;
+        TimeT end;
+    };
+
+    struct Placement {
+        int machineId;
+        Interval interval;
+    };
+
+    // 一次增量中一台机器上删除与新增的区间
+    struct MachineChanges {
+        std::vector<Interval> removed;
+        std::vector<Interval> added;
+    };
+
+    struct Machine {
+        std::vector<Interval> busy;       // 按开始时间排序的操作区间
+        std::vector<TimeT> gapStarts;     // 空闲区间，按开始时间排序
+        std::vector<TimeT> gapEnds;
+        std::vector<TimeT> maxTree;       // 空闲长度的最大值线段树（1 为根，叶子从 leafCount 开始）
+        size_t leafCount = 0;
+        TimeT tail = TimeT();
+    };
+
+    void rebuildGaps(Machine& machine) const;
+    int findFirst(const Machine& machine, size_t node, size_t nodeFirst, size_t nodeLast,
+        size_t first, size_t last, TimeT duration) const;
+    const Machine* findMachine(int machineId) const;
+    Machine& obtainMachine(int machineId);
+    void applyChanges(Machine& machine, MachineChanges& changes) const;
+
+    TimeT horizonStart = TimeT();
+    std::vector<int> machineIds;          // 升序
+    std::vector<Machine> machines;        // 与 machineIds 对齐
+    std::unordered_map<std::uint64_t, Placement, qm::KeyHash> keyIndex;
+    bool uniqueKeys = true;
+};
+
+using IdleGapIndex = BasicIdleGapIndex<int>;
+using IdleGapIndex64 = BasicIdleGapIndex<long long>;
+using IdleGapIndexF = BasicIdleGapIndex<double>;
+
+extern template class BasicIdleGapIndex<int>;
+extern template class BasicIdleGapIndex<long long>;
+extern template class BasicIdleGapIndex<double>;
+
+#endif // IDLE_GAP_INDEX_H
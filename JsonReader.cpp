@@ -0,0 +1,664 @@
+#include "JsonReader.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <thread>
+#include <type_traits>
+
+namespace {
+    // 字段名规范化：小写，去掉下划线、连字符与空格
+    size_t normalizeKey(const char* text, size_t length, char* out) {
+        size_t n = 0;
+        for (size_t i = 0; i < length; ++i) {
+            char c = text[i];
+            if (c == '_' || c == '-' || c == ' ') continue;
+            out[n++] = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+        out[n] = '\0';
+        return n;
+    }
+
+    struct KeyAlias {
+        const char* name;
+        signed char field;
+    };
+
+    // 字段顺序与 BasicJsonOperationReader::Field 一致
+    const KeyAlias KEY_ALIASES[] = {
+        { "jobid", 0 }, { "job", 0 },
+        { "stage", 1 }, { "operation", 1 }, { "op", 1 }, { "step", 1 },
+        { "machineid", 2 }, { "machine", 2 }, { "resource", 2 },
+        { "starttime", 3 }, { "start", 3 }, { "begin", 3 },
+        { "endtime", 4 }, { "end", 4 }, { "finish", 4 },
+        { "duration", 5 }, { "dur", 5 },
+        { "iscritical", 6 }, { "critical", 6 },
+    };
+
+    signed char lookupField(const char* text, size_t length) {
+        char key[GanttConfig::InputConfig::JSON_MAX_TOKEN_LENGTH + 1];
+        normalizeKey(text, length, key);
+        for (const KeyAlias& alias : KEY_ALIASES) {
+            if (std::strcmp(alias.name, key) == 0) return alias.field;
+        }
+        return -1;
+    }
+
+    bool isDelimiter(char c) {
+        return c == ',' || c == '}' || c == ']' || c == ':' || c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    // 数值转换为 T，超出范围或非有限值时返回false
+    template<typename T>
+    bool convertValue(long long integer, double real, bool isReal, T& result) {
+        if (std::is_floating_point<T>::value) {
+            const double value = isReal ? real : static_cast<double>(integer);
+            if (!std::isfinite(value)) return false;
+            result = static_cast<T>(value);
+            return true;
+        }
+        if (isReal) {
+            // 先按 double 比较范围再转换，越界或 NaN 的转换是未定义行为
+            const double lowest = static_cast<double>(std::numeric_limits<T>::min());
+            const double limit = -lowest;  // 2^(位数-1)，最大值加一
+            if (!(real >= lowest && real < limit)) return false;
+            result = static_cast<T>(real);
+            return true;
+        }
+        if (integer < static_cast<long long>(std::numeric_limits<T>::min()) ||
+            integer > static_cast<long long>(std::numeric_limits<T>::max())) {
+            return false;
+        }
+        result = static_cast<T>(integer);
+        return true;
+    }
+}
+
+template<typename TimeT>
+BasicJsonOperationReader<TimeT>::BasicJsonOperationReader() {
+    reset();
+}
+
+template<typename TimeT>
+void BasicJsonOperationReader<TimeT>::reset() {
+    state = State::Value;
+    depth = 0;
+    stringIsKey = false;
+    capturing = false;
+    tokenLength = 0;
+    errorCount = 0;
+    lineNumber = 1;
+    keyCacheCount = 0;
+    keyCacheHint = 0;
+}
+
+template<typename TimeT>
+void BasicJsonOperationReader<TimeT>::feed(const char* data, size_t size, std::vector<Operation>& out) {
+    const char* p = data;
+    const char* end = data + size;
+
+    while (p < end) {
+        switch (state) {
+        case State::Value: {
+            const char c = *p++;
+            if (c == ':' || c == ' ') break;  // 最常见的无状态字符
+            processStructural(c, out);
+            break;
+        }
+
+        case State::String: {
+            // 快速跳到下一个引号或转义符
+            const char* stop = p;
+            while (stop < end && *stop != '"' && *stop != '\\' && *stop != '\n') ++stop;
+            if (capturing) {
+                size_t n = static_cast<size_t>(stop - p);
+                if (tokenLength + n <= static_cast<size_t>(MAX_TOKEN)) {
+                    std::memcpy(token + tokenLength, p, n);
+                    tokenLength += n;
+                }
+                else {
+                    capturing = false;  // 过长的键或值不可能匹配
+                }
+            }
+            p = stop;
+            if (p == end) break;
+            if (*p == '"') {
+                ++p;
+                finishString();
+                state = State::Value;
+            }
+            else if (*p == '\\') {
+                ++p;
+                state = State::Escape;
+            }
+            else {
+                syntaxError("unterminated string");
+            }
+            break;
+        }
+
+        case State::Escape:
+            // 转义字符原样保留（\uXXXX 的十六进制位作为普通字符），只影响匹配，不影响结构
+            if (capturing) {
+                if (tokenLength < static_cast<size_t>(MAX_TOKEN)) {
+                    token[tokenLength++] = *p;
+                }
+                else {
+                    capturing = false;  // 与普通字符一样，过长的键或值不参与匹配，不能截断后按前缀匹配
+                }
+            }
+            ++p;
+            state = State::String;
+            break;
+
+        case State::Token:
+            while (p < end && !isDelimiter(*p)) {
+                if (tokenLength < static_cast<size_t>(MAX_TOKEN)) {
+                    token[tokenLength++] = *p;
+                }
+                else {
+                    capturing = false;  // 过长的字面量：截断后的数值不可信
+                }
+                ++p;
+            }
+            if (p < end) {
+                // 分隔符留给下一轮处理；非法字面量会切换到 SkipLine，此时换行符不能被提前消耗
+                state = State::Value;
+                finishToken();
+            }
+            break;
+
+        case State::SkipLine: {
+            const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            if (!newline) {
+                p = end;
+                break;
+            }
+            p = newline + 1;
+            ++lineNumber;
+            state = State::Value;
+            break;
+        }
+        }
+    }
+}
+
+template<typename TimeT>
+void BasicJsonOperationReader<TimeT>::finish() {
+    if (state == State::Token) {
+        state = State::Value;
+        finishToken();
+    }
+    if (state == State::String || state == State::Escape || depth != 0) {
+        syntaxError("unexpected end of input");
+    }
+    state = State::Value;
+    depth = 0;
+}
+
+template<typename TimeT>
+void BasicJsonOperationReader<TimeT>::processStructural(char c, std::vector<Operation>& out) {
+    Frame* frame = currentFrame();
+
+    switch (c) {
+    case ' ': case '\t': case '\r':
+        return;
+    case '\n':
+        ++lineNumber;
+        return;
+
+    case '{':
+    case '[':
+        ++depth;
+        if (Frame* child = currentFrame()) {
+            child->isObject = (c == '{');
+            child->expectKey = child->isObject;
+            child->field = NoField;
+            child->mask = 0;
+            child->realMask = 0;
+        }
+        return;
+
+    case '}':
+    case ']':
+        closeFrame(c, out);
+        return;
+
+    case ':':
+        return;
+
+    case ',':
+        if (frame && frame->isObject) {
+            frame->expectKey = true;
+            frame->field = NoField;
+        }
+        return;
+
+    case '"':
+        stringIsKey = frame && frame->isObject && frame->expectKey;
+        capturing = stringIsKey || (frame && frame->isObject && frame->field != NoField);
+        tokenLength = 0;
+        state = State::String;
+        return;
+
+    default:
+        if (c == '-' || (c >= '0' && c <= '9') || c == 't' || c == 'f' || c == 'n') {
+            token[0] = c;
+            tokenLength = 1;
+            capturing = true;
+            state = State::Token;
+            return;
+        }
+        if (depth == 0 && static_cast<unsigned char>(c) >= 0x80) {
+            return;  // 顶层的非 ASCII 字节（UTF-8 BOM）
+        }
+        syntaxError("unexpected character");
+        return;
+    }
+}
+
+template<typename TimeT>
+void BasicJsonOperationReader<TimeT>::closeFrame(char c, std::vector<Operation>& out) {
+    if (depth == 0) {
+        syntaxError("unbalanced closing bracket");
+        return;
+    }
+
+    if (Frame* frame = currentFrame()) {
+        if (frame->isObject != (c == '}')) {
+            syntaxError("mismatched closing bracket");
+            return;
+        }
+        if (frame->isObject) {
+            emit(*frame, out);
+        }
+    }
+    --depth;
+
+    // 嵌套的对象或数组作为父对象字段的值时，该字段不被赋值
+    if (Frame* parent = currentFrame()) {
+        parent->field = NoField;
+    }
+}
+
+template<typename TimeT>
+void BasicJsonOperationReader<TimeT>::finishString() {
+    Frame* frame = currentFrame();
+    if (!frame) return;
+
+    if (stringIsKey) {
+        frame->field = capturing ? resolveKey(token, tokenLength) : static_cast<signed char>(NoField);
+        frame->expectKey = false;
+    }
+    else if (capturing) {
+        storeValue(token, tokenLength, true);
+    }
+}
+
+template<typename TimeT>
+signed char BasicJsonOperationReader<TimeT>::resolveKey(const char* text, size_t length) {
+    for (int i = 0; i < keyCacheCount; ++i) {
+        const int index = (keyCacheHint + i) % keyCacheCount;
+        const KeyCacheEntry& entry = keyCache[index];
+        if (entry.length == length && std::memcmp(entry.text, text, length) == 0) {
+            keyCacheHint = (index + 1) % keyCacheCount;
+            return entry.field;
+        }
+    }
+
+    const signed char field = lookupField(text, length);
+    if (keyCacheCount < KEY_CACHE_SIZE) {
+        KeyCacheEntry& entry = keyCache[keyCacheCount++];
+        entry.length = static_cast<unsigned char>(length);
+        entry.field = field;
+        std::memcpy(entry.text, text, length);
+    }
+    return field;
+}
+
+template<typename TimeT>
+void BasicJsonOperationReader<TimeT>::finishToken() {
+    Frame* frame = currentFrame();
+    if (frame && frame->isObject && !frame->expectKey && frame->field != NoField) {
+        if (!capturing) {
+            frame->field = NoField;
+            valueError("literal too long");
+            return;
+        }
+        storeValue(token, tokenLength, false);
+    }
+}
+
+template<typename TimeT>
+void BasicJsonOperationReader<TimeT>::storeValue(const char* text, size_t length, bool isString) {
+    Frame* frame = currentFrame();
+    const int field = frame->field;
+    frame->field = NoField;
+
+    long long integer = 0;
+    double real = 0.0;
+    bool isReal = false;
+
+    // 常见情况：不超过18位的非负整数，直接累加
+    size_t digits = 0;
+    while (digits < length && digits < 18 && text[digits] >= '0' && text[digits] <= '9') {
+        integer = integer * 10 + (text[digits] - '0');
+        ++digits;
+    }
+    if (digits == length && length > 0) {
+        storeField(*frame, field, integer, 0.0, false);
+        return;
+    }
+    integer = 0;
+
+    char buffer[MAX_TOKEN + 1];
+    std::memcpy(buffer, text, length);
+    buffer[length] = '\0';
+
+    if (std::strcmp(buffer, "true") == 0) {
+        integer = 1;
+    }
+    else if (std::strcmp(buffer, "false") == 0) {
+        integer = 0;
+    }
+    else if (std::strcmp(buffer, "null") == 0 || length == 0) {
+        return;  // 空值视为缺失
+    }
+    else {
+        char* parseEnd = nullptr;
+        const bool looksReal = std::strpbrk(buffer, ".eE") != nullptr;
+        if (!looksReal) {
+            errno = 0;
+            integer = std::strtoll(buffer, &parseEnd, 10);
+            if (errno == ERANGE) {
+                parseEnd = nullptr;
+            }
+        }
+        if (looksReal || !parseEnd) {
+            real = std::strtod(buffer, &parseEnd);
+            isReal = true;
+        }
+        if (parseEnd == buffer || *parseEnd != '\0') {
+            if (!isString) {
+                syntaxError("invalid literal");
+            }
+            return;  // 非数字字符串：忽略该字段
+        }
+    }
+
+    storeField(*frame, field, integer, real, isReal);
+}
+
+template<typename TimeT>
+void BasicJsonOperationReader<TimeT>::storeField(Frame& frame, int field, long long integer, double real, bool isReal) {
+    frame.integers[field] = integer;
+    frame.reals[field] = real;
+    frame.mask |= static_cast<unsigned char>(1u << field);
+    if (isReal) {
+        frame.realMask |= static_cast<unsigned char>(1u << field);
+    }
+    else {
+        frame.realMask &= static_cast<unsigned char>(~(1u << field));
+    }
+}
+
+template<typename TimeT>
+void BasicJsonOperationReader<TimeT>::emit(const Frame& frame, std::vector<Operation>& out) {
+    const unsigned required = (1u << JobField) | (1u << MachineField) | (1u << StartField);
+    if ((frame.mask & required) != required) return;
+    if (!(frame.mask & ((1u << EndField) | (1u << DurationField)))) return;
+
+    // 缺失的字段为 0；超出 int / TimeT 范围的值使整条记录被丢弃
+    auto convert = [&](int field, auto& result) {
+        if (!(frame.mask & (1u << field))) {
+            result = 0;
+            return true;
+        }
+        return convertValue(frame.integers[field], frame.reals[field], (frame.realMask & (1u << field)) != 0, result);
+    };
+
+    Operation op;
+    TimeT duration = TimeT();
+    const bool hasEnd = (frame.mask & (1u << EndField)) != 0;
+    if (!convert(JobField, op.job_id) || !convert(StageField, op.stage) || !convert(MachineField, op.machine_id) ||
+        !convert(StartField, op.start_time) || !(hasEnd ? convert(EndField, op.end_time) : convert(DurationField, duration))) {
+        valueError("value out of range");
+        return;
+    }
+    if (!hasEnd) {
+        op.end_time = op.start_time + duration;
+    }
+    op.is_critical = (frame.mask & (1u << CriticalField)) != 0
+        && ((frame.realMask & (1u << CriticalField)) ? frame.reals[CriticalField] != 0.0 : frame.integers[CriticalField] != 0);
+    out.push_back(op);
+}
+
+// 数值错误只丢弃所在的字段或记录，不影响解析状态
+template<typename TimeT>
+void BasicJsonOperationReader<TimeT>::valueError(const char* message) {
+    ++errorCount;
+    if (errorCount <= static_cast<size_t>(GanttConfig::InputConfig::JSON_MAX_REPORTED_ERRORS)) {
+        GANTT_LOG(LogLevel::Warning, "JSON value error at line " << lineNumber << ": " << message);
+    }
+}
+
+template<typename TimeT>
+void BasicJsonOperationReader<TimeT>::syntaxError(const char* message) {
+    ++errorCount;
+    if (errorCount <= static_cast<size_t>(GanttConfig::InputConfig::JSON_MAX_REPORTED_ERRORS)) {
+        GANTT_LOG(LogLevel::Warning, "JSON syntax error at line " << lineNumber << ": " << message
+            << ", skipping to next line");
+    }
+    // 丢弃未完成的记录，从下一行重新开始
+    depth = 0;
+    state = State::SkipLine;
+}
+
+namespace {
+    // 解析文件中 [begin, end) 内开始的所有行；begin 不在行首时跳过该行（属于前一块）
+    template<typename TimeT>
+    size_t parseFileRange(const std::string& filename, long long begin, long long end,
+        std::vector<qm::BasicOperation<TimeT>>& out) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            GANTT_LOG(LogLevel::Error, "Could not open file " << filename);
+            return 0;
+        }
+
+        std::vector<char> block(GanttConfig::InputConfig::JSON_READ_BLOCK_SIZE);
+        BasicJsonOperationReader<TimeT> reader;
+
+        long long position = begin > 0 ? begin - 1 : 0;
+        file.seekg(position);
+        bool skipping = begin > 0;   // 从 begin-1 开始读，若它是换行符则 begin 恰为行首
+        long long lineStart = begin;
+
+        while (lineStart < end && file) {
+            file.read(block.data(), static_cast<std::streamsize>(block.size()));
+            const size_t got = static_cast<size_t>(file.gcount());
+            if (got == 0) break;
+
+            const char* p = block.data();
+            const char* blockEnd = p + got;
+            while (p < blockEnd) {
+                const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(blockEnd - p)));
+                const char* stop = newline ? newline + 1 : blockEnd;
+                if (skipping) {
+                    if (newline) {
+                        skipping = false;
+                        lineStart = position + (stop - block.data());
+                    }
+                }
+                else {
+                    if (lineStart >= end) break;
+                    reader.feed(p, static_cast<size_t>(stop - p), out);
+                    if (newline) {
+                        lineStart = position + (stop - block.data());
+                    }
+                }
+                p = stop;
+            }
+            position += static_cast<long long>(got);
+        }
+
+        reader.finish();
+        return reader.getErrorCount();
+    }
+
+    // 文件开头是否为 NDJSON：第一行是一个完整的顶层对象
+    template<typename TimeT>
+    bool detectNdjson(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        std::vector<char> block(GanttConfig::InputConfig::JSON_READ_BLOCK_SIZE);
+        file.read(block.data(), static_cast<std::streamsize>(block.size()));
+        const size_t got = static_cast<size_t>(file.gcount());
+
+        size_t first = 0;
+        while (first < got && (std::strchr(" \t\r\n", block[first]) || static_cast<unsigned char>(block[first]) >= 0x80)) {
+            ++first;
+        }
+        if (first == got || block[first] != '{') return false;
+
+        const void* newline = std::memchr(block.data() + first, '\n', got - first);
+        if (!newline) return false;
+
+        BasicJsonOperationReader<TimeT> probe;
+        std::vector<qm::BasicOperation<TimeT>> ignored;
+        probe.feed(block.data() + first, static_cast<size_t>(static_cast<const char*>(newline) - (block.data() + first)), ignored);
+        return probe.isAtTopLevel() && probe.getErrorCount() == 0;
+    }
+}
+
+template<typename TimeT>
+std::vector<qm::BasicOperation<TimeT>> loadBasicOperationsFromJSON(const std::string& filename, int threadCount) {
+    std::vector<qm::BasicOperation<TimeT>> operations;
+
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        GANTT_LOG(LogLevel::Error, "Could not open file " << filename);
+        return operations;
+    }
+    const long long fileSize = static_cast<long long>(file.tellg());
+    file.close();
+
+    int threads = threadCount > 0 ? threadCount : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const bool ndjson = detectNdjson<TimeT>(filename);
+    if (!ndjson || fileSize < GanttConfig::InputConfig::JSON_PARALLEL_MIN_BYTES) {
+        threads = 1;
+    }
+
+    size_t errors = 0;
+    if (threads <= 1) {
+        errors = parseFileRange<TimeT>(filename, 0, fileSize, operations);
+    }
+    else {
+        // 按字节均分，各块从自己范围内的第一个行首开始，结果按块顺序拼接
+        std::vector<std::vector<qm::BasicOperation<TimeT>>> parts(threads);
+        std::vector<size_t> partErrors(threads, 0);
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; ++t) {
+            const long long begin = fileSize * t / threads;
+            const long long end = fileSize * (t + 1) / threads;
+            pool.emplace_back([&, t, begin, end]() {
+                partErrors[t] = parseFileRange<TimeT>(filename, begin, end, parts[t]);
+            });
+        }
+        size_t total = 0;
+        for (int t = 0; t < threads; ++t) {
+            pool[t].join();
+            total += parts[t].size();
+            errors += partErrors[t];
+        }
+        operations.reserve(total);
+        for (auto& part : parts) {
+            operations.insert(operations.end(), part.begin(), part.end());
+            std::vector<qm::BasicOperation<TimeT>>().swap(part);
+        }
+    }
+
+    if (errors > 0) {
+        GANTT_LOG(LogLevel::Warning, "JSON input had " << errors << " syntax errors in " << filename);
+    }
+    GANTT_LOG(LogLevel::Info, "Valid operations loaded: " << operations.size() << " from "
+        << (ndjson ? "NDJSON" : "JSON") << " file " << filename << " (" << threads << " threads)");
+    return operations;
+}
+
+std::vector<qm::Operation> loadOperationsFromJSON(const std::string& filename) {
+    return loadBasicOperationsFromJSON<int>(filename);
+}
+
+template<typename TimeT>
+size_t readBasicOperationsFromStream(std::istream& in,
+    const std::function<bool(std::vector<qm::BasicOperation<TimeT>>&)>& onBatch) {
+    using FlushClock = std::chrono::steady_clock;
+    const size_t batchSize = static_cast<size_t>(GanttConfig::InputConfig::JSON_STREAM_BATCH_SIZE);
+    const auto flushInterval = std::chrono::milliseconds(GanttConfig::InputConfig::JSON_STREAM_FLUSH_MS);
+    FlushClock::time_point lastFlush = FlushClock::now();
+    std::vector<char> block(GanttConfig::InputConfig::JSON_READ_BLOCK_SIZE);
+    std::vector<qm::BasicOperation<TimeT>> batch;
+    BasicJsonOperationReader<TimeT> reader;
+    size_t total = 0;
+
+    // 按行读取（超长行按块读取），每行到达后立即解析，不等待缓冲区填满
+    for (;;) {
+        in.getline(block.data(), static_cast<std::streamsize>(block.size()));
+        const size_t got = static_cast<size_t>(in.gcount());
+        const bool partial = in.fail() && !in.eof() && got > 0;  // 缓冲区已满，该行尚未结束
+        const bool hasNewline = !in.fail() && !in.eof();
+        if (got == 0 && !in) break;
+        if (partial) {
+            in.clear();
+        }
+
+        const size_t stored = hasNewline ? got - 1 : got;
+        reader.feed(block.data(), stored, batch);
+        if (hasNewline) {
+            reader.feed("\n", 1, batch);
+        }
+
+        // 批次已满、距上一批已超过时间间隔，或遇到空行（生产者标记一批结束）时交出数据；
+        // 流缓冲区的 in_avail 在与 stdio 同步的 std::cin 上总是 0，不能用来判断输入是否暂停
+        if (!batch.empty()) {
+            const bool blankLine = hasNewline && stored == 0 && reader.isAtTopLevel();
+            const FlushClock::time_point now = FlushClock::now();
+            if (batch.size() >= batchSize || blankLine || now - lastFlush >= flushInterval) {
+                total += batch.size();
+                if (!onBatch(batch)) return total;
+                batch.clear();
+                lastFlush = now;
+            }
+        }
+        if (in.eof()) break;
+    }
+
+    reader.finish();
+    if (!batch.empty()) {
+        total += batch.size();
+        onBatch(batch);
+    }
+    if (reader.getErrorCount() > 0) {
+        GANTT_LOG(LogLevel::Warning, "JSON input had " << reader.getErrorCount() << " syntax errors");
+    }
+    return total;
+}
+
+template class BasicJsonOperationReader<int>;
+template class BasicJsonOperationReader<long long>;
+template class BasicJsonOperationReader<double>;
+
+template std::vector<qm::BasicOperation<int>> loadBasicOperationsFromJSON<int>(const std::string&, int);
+template std::vector<qm::BasicOperation<long long>> loadBasicOperationsFromJSON<long long>(const std::string&, int);
+template std::vector<qm::BasicOperation<double>> loadBasicOperationsFromJSON<double>(const std::string&, int);
+
+template size_t readBasicOperationsFromStream<int>(std::istream&,
+    const std::function<bool(std::vector<qm::BasicOperation<int>>&)>&);
+template size_t readBasicOperationsFromStream<long long>(std::istream&,
+    const std::function<bool(std::vector<qm::BasicOperation<long long>>&)>&);
+template size_t readBasicOperationsFromStream<double>(std::istream&,
+    const std::function<bool(std::vector<qm::BasicOperation<double>>&)>&);
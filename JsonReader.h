@@ -0,0 +1,138 @@
+//
+// JSON / NDJSON 调度数据读取
+// 不建立 DOM，逐字节的状态机只保存嵌套栈中每层的少量字段，内存占用固定；
+// 数据可以按任意边界分块送入，因此同样适用于管道和标准输入
+//
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include "data.h"
+#include "GanttConfig.h"
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 增量 JSON 操作解析器
+ *
+ * 任意层级中的对象只要包含作业、机器、开始时间以及结束时间（或时长）字段即被视为一个操作，
+ * 因此可以直接读取对象数组、NDJSON 事件行以及 {"operations": [...]} 等包装格式。
+ * 字段名不区分大小写并忽略下划线与连字符，可识别的名称：
+ *   job_id/job、stage/operation/op/step、machine_id/machine/resource、
+ *   start_time/start/begin、end_time/end/finish、duration/dur、is_critical/critical
+ * 数值可以是数字或数字字符串；语法错误时跳到下一行继续（适用于 NDJSON）。
+ * 超过 JSON_MAX_TOKEN_LENGTH 的键不匹配任何字段；超长的数值、超出 int（编号）或 TimeT（时间）范围的值
+ * 以及非有限值计为错误，所在的字段或记录被丢弃。
+ */
+template<typename TimeT>
+class BasicJsonOperationReader {
+public:
+    using Operation = qm::BasicOperation<TimeT>;
+
+    BasicJsonOperationReader();
+
+    /**
+     * @brief 解析一块数据，完整的操作追加到 out
+     */
+    void feed(const char* data, size_t size, std::vector<Operation>& out);
+
+    /**
+     * @brief 输入结束，处理末尾未结束的数值并检查未闭合的结构
+     */
+    void finish();
+
+    void reset();
+
+    // 是否位于顶层（不在任何对象、数组或字符串之内）
+    bool isAtTopLevel() const { return depth == 0 && state == State::Value; }
+
+    size_t getErrorCount() const { return errorCount; }
+    long long getLineNumber() const { return lineNumber; }
+
+private:
+    enum class State : unsigned char { Value, String, Escape, Token, SkipLine };
+
+    // 可识别的字段
+    enum Field : signed char {
+        NoField = -1, JobField, StageField, MachineField, StartField, EndField, DurationField, CriticalField, FieldCount
+    };
+
+    static const int MAX_DEPTH = GanttConfig::InputConfig::JSON_MAX_DEPTH;
+    static const int MAX_TOKEN = GanttConfig::InputConfig::JSON_MAX_TOKEN_LENGTH;
+    static const int KEY_CACHE_SIZE = 16;
+
+    struct Frame {
+        bool isObject;
+        bool expectKey;
+        signed char field;          // 当前键对应的字段
+        unsigned char mask;         // 已读取的字段
+        unsigned char realMask;     // 以浮点形式读取的字段
+        long long integers[FieldCount];
+        double reals[FieldCount];
+    };
+
+    void processStructural(char c, std::vector<Operation>& out);
+    void finishToken();
+    void finishString();
+    signed char resolveKey(const char* text, size_t length);
+    void storeValue(const char* text, size_t length, bool isString);
+    void storeField(Frame& frame, int field, long long integer, double real, bool isReal);
+    void closeFrame(char c, std::vector<Operation>& out);
+    void emit(const Frame& frame, std::vector<Operation>& out);
+    void syntaxError(const char* message);
+    void valueError(const char* message);
+    Frame* currentFrame() { return depth > 0 && depth <= MAX_DEPTH ? &frames[depth - 1] : nullptr; }
+
+    State state;
+    int depth;
+    bool stringIsKey;
+    bool capturing;
+    size_t tokenLength;
+    char token[MAX_TOKEN + 1];
+    Frame frames[MAX_DEPTH];
+
+    // 原始键名 -> 字段的缓存；记录的键通常以相同顺序重复出现，从上次命中的下一项开始查找
+    struct KeyCacheEntry {
+        unsigned char length;
+        signed char field;
+        char text[MAX_TOKEN];
+    };
+    KeyCacheEntry keyCache[KEY_CACHE_SIZE];
+    int keyCacheCount;
+    int keyCacheHint;
+    size_t errorCount;
+    long long lineNumber;
+};
+
+using JsonOperationReader = BasicJsonOperationReader<int>;
+using JsonOperationReader64 = BasicJsonOperationReader<long long>;
+using JsonOperationReaderF = BasicJsonOperationReader<double>;
+
+/**
+ * @brief 从 JSON 或 NDJSON 文件加载操作数据
+ * @param threadCount 并行线程数，0 表示使用硬件线程数；只有较大的 NDJSON 文件会分块并行解析
+ * @return 按文件顺序排列的操作，失败时为空
+ */
+template<typename TimeT>
+std::vector<qm::BasicOperation<TimeT>> loadBasicOperationsFromJSON(const std::string& filename, int threadCount = 0);
+
+std::vector<qm::Operation> loadOperationsFromJSON(const std::string& filename);
+
+/**
+ * @brief 从流（例如 std::cin）增量读取，操作分批交给回调
+ * @param onBatch 读取到 JSON_STREAM_BATCH_SIZE 个操作、距上一批超过 JSON_STREAM_FLUSH_MS 毫秒、
+ *                遇到空行或输入结束时调用；返回 false 停止读取。回调可以移走向量中的数据
+ * @note 读取会阻塞，未满的批次在下一行到达时才按时间交出；生产者在一批数据之后输出一个空行可立即交出
+ * @return 读取到的操作总数
+ */
+template<typename TimeT>
+size_t readBasicOperationsFromStream(std::istream& in,
+    const std::function<bool(std::vector<qm::BasicOperation<TimeT>>&)>& onBatch);
+
+extern template class BasicJsonOperationReader<int>;
+extern template class BasicJsonOperationReader<long long>;
+extern template class BasicJsonOperationReader<double>;
+
+#endif // JSON_READER_H
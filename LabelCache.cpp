@@ -0,0 +1,231 @@
+#include "LabelCache.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+    // 与 sf::Text 相同的字形四边形外扩量
+    const float GLYPH_PADDING = 1.0f;
+
+    std::size_t hashKey(long long a, int b, unsigned short kind, unsigned short size) {
+        unsigned long long h = static_cast<unsigned long long>(a) * 0x9E3779B97F4A7C15ULL;
+        h ^= (static_cast<unsigned long long>(static_cast<unsigned int>(b)) << 20)
+            ^ (static_cast<unsigned long long>(kind) << 8) ^ size;
+        h ^= h >> 31;
+        h *= 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 29;
+        return static_cast<std::size_t>(h);
+    }
+}
+
+LabelCache::LabelCache() {
+    for (auto& batch : batches) {
+        batch.vertices.setPrimitiveType(sf::Triangles);
+        std::fill(std::begin(batch.glyphs), std::end(batch.glyphs), GlyphQuad{ 0, 0, 0, 0, 0, 0, 0, 0, 0 });
+    }
+    entries.resize(GanttConfig::FontConfig::LABEL_CACHE_CAPACITY);
+    clearLabels();
+}
+
+void LabelCache::setFont(const sf::Font& newFont) {
+    font = &newFont;
+
+    for (int i = 0; i < SIZE_COUNT; ++i) {
+        loadGlyphs(batches[i], static_cast<unsigned>(GanttConfig::FontConfig::MIN_FONT_SIZE + i));
+    }
+    // 范围之外的字号按新字体重新加载
+    for (auto& extra : extraBatches) {
+        loadGlyphs(*extra.batch, extra.size);
+    }
+
+    // 字体变化后旧的排版结果失效
+    clearLabels();
+}
+
+void LabelCache::loadGlyphs(SizeBatch& batch, unsigned size) const {
+    if (!font) return;
+    for (int c = FIRST_CHAR; c <= LAST_CHAR; ++c) {
+        const sf::Glyph& glyph = font->getGlyph(static_cast<sf::Uint32>(c), size, false);
+        GlyphQuad& quad = batch.glyphs[c - FIRST_CHAR];
+
+        quad.advance = glyph.advance;
+        quad.left = glyph.bounds.left - GLYPH_PADDING;
+        quad.top = glyph.bounds.top - GLYPH_PADDING;
+        quad.right = glyph.bounds.left + glyph.bounds.width + GLYPH_PADDING;
+        quad.bottom = glyph.bounds.top + glyph.bounds.height + GLYPH_PADDING;
+        quad.u0 = static_cast<float>(glyph.textureRect.left) - GLYPH_PADDING;
+        quad.v0 = static_cast<float>(glyph.textureRect.top) - GLYPH_PADDING;
+        quad.u1 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + GLYPH_PADDING;
+        quad.v1 = static_cast<float>(glyph.textureRect.top + glyph.textureRect.height) + GLYPH_PADDING;
+
+        // 空白字符不生成四边形
+        if (glyph.bounds.width <= 0 || glyph.bounds.height <= 0) {
+            quad.right = quad.left;
+        }
+    }
+}
+
+LabelCache::SizeBatch& LabelCache::batchFor(unsigned size) {
+    int index = static_cast<int>(size) - GanttConfig::FontConfig::MIN_FONT_SIZE;
+    return index >= 0 && index < SIZE_COUNT ? batches[index] : extraBatchFor(size);
+}
+
+const LabelCache::SizeBatch& LabelCache::batchFor(unsigned size) const {
+    int index = static_cast<int>(size) - GanttConfig::FontConfig::MIN_FONT_SIZE;
+    return index >= 0 && index < SIZE_COUNT ? batches[index] : extraBatchFor(size);
+}
+
+// 预热范围之外的字号按字号查找，没有时加载；不能借用相邻字号，否则字形度量与纹理页都不对
+LabelCache::SizeBatch& LabelCache::extraBatchFor(unsigned size) const {
+    for (auto& extra : extraBatches) {
+        if (extra.size == size) return *extra.batch;
+    }
+    std::unique_ptr<SizeBatch> batch(new SizeBatch());
+    batch->vertices.setPrimitiveType(sf::Triangles);
+    std::fill(std::begin(batch->glyphs), std::end(batch->glyphs), GlyphQuad{ 0, 0, 0, 0, 0, 0, 0, 0, 0 });
+    loadGlyphs(*batch, size);
+    extraBatches.push_back(ExtraBatch{ size, std::move(batch) });
+    return *extraBatches.back().batch;
+}
+
+void LabelCache::clearLabels() {
+    for (auto& entry : entries) {
+        entry.used = false;
+    }
+    usedCount = 0;
+}
+
+const CachedLabel& LabelCache::get(LabelKind kind, long long a, int b, unsigned size) {
+    const unsigned short kindKey = static_cast<unsigned short>(kind);
+    const unsigned short sizeKey = static_cast<unsigned short>(size);
+    const std::size_t mask = entries.size() - 1;
+
+    std::size_t slot = hashKey(a, b, kindKey, sizeKey) & mask;
+    while (entries[slot].used) {
+        const Entry& e = entries[slot];
+        if (e.a == a && e.b == b && e.kind == kindKey && e.size == sizeKey) {
+            return e.label;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    // 装载率超过3/4时整体清空，保持探测长度有界且不分配内存
+    if (usedCount + 1 > entries.size() * 3 / 4) {
+        clearLabels();
+        slot = hashKey(a, b, kindKey, sizeKey) & mask;
+    }
+
+    Entry& entry = entries[slot];
+    entry.a = a;
+    entry.b = b;
+    entry.kind = kindKey;
+    entry.size = sizeKey;
+    entry.used = true;
+    ++usedCount;
+
+    int written = 0;
+    switch (kind) {
+    case LabelKind::Operation:
+        written = std::snprintf(entry.label.text, sizeof(entry.label.text), "J%lld-%d", a, b);
+        break;
+    case LabelKind::Machine:
+        written = std::snprintf(entry.label.text, sizeof(entry.label.text), "M%lld", a);
+        break;
+    case LabelKind::TimeTick:
+        written = std::snprintf(entry.label.text, sizeof(entry.label.text), "%lld", a);
+        break;
+    }
+    entry.label.length = static_cast<unsigned char>(
+        std::max(0, std::min(written, static_cast<int>(sizeof(entry.label.text)) - 1)));
+    measure(entry.label.text, entry.label.length, size, entry.label.width, entry.label.height);
+
+    return entry.label;
+}
+
+void LabelCache::measure(const char* text, std::size_t length, unsigned size, float& width, float& height) const {
+    const SizeBatch& batch = batchFor(size);
+
+    float penX = 0.0f;
+    float minX = 0.0f, maxX = 0.0f, minY = 0.0f, maxY = 0.0f;
+    bool any = false;
+
+    for (std::size_t i = 0; i < length; ++i) {
+        int c = static_cast<unsigned char>(text[i]);
+        if (c < FIRST_CHAR || c > LAST_CHAR) c = '?';
+        const GlyphQuad& g = batch.glyphs[c - FIRST_CHAR];
+
+        if (g.right > g.left) {
+            float left = penX + g.left + GLYPH_PADDING;
+            float right = penX + g.right - GLYPH_PADDING;
+            float top = g.top + GLYPH_PADDING;
+            float bottom = g.bottom - GLYPH_PADDING;
+            if (!any) {
+                minX = left; maxX = right; minY = top; maxY = bottom;
+                any = true;
+            }
+            else {
+                minX = std::min(minX, left);
+                maxX = std::max(maxX, right);
+                minY = std::min(minY, top);
+                maxY = std::max(maxY, bottom);
+            }
+        }
+        penX += g.advance;
+    }
+
+    width = any ? maxX - minX : 0.0f;
+    height = any ? maxY - minY : 0.0f;
+}
+
+void LabelCache::appendText(const char* text, std::size_t length, unsigned size,
+    float x, float y, const sf::Color& color) {
+    SizeBatch& batch = batchFor(size);
+
+    // 与 sf::Text 一致：基线位于 y + 字号
+    float penX = x;
+    const float baseline = y + static_cast<float>(size);
+
+    for (std::size_t i = 0; i < length; ++i) {
+        int c = static_cast<unsigned char>(text[i]);
+        if (c < FIRST_CHAR || c > LAST_CHAR) c = '?';
+        const GlyphQuad& g = batch.glyphs[c - FIRST_CHAR];
+
+        if (g.right > g.left) {
+            const float l = penX + g.left, r = penX + g.right;
+            const float t = baseline + g.top, b = baseline + g.bottom;
+
+            batch.vertices.append(sf::Vertex(sf::Vector2f(l, t), color, sf::Vector2f(g.u0, g.v0)));
+            batch.vertices.append(sf::Vertex(sf::Vector2f(r, t), color, sf::Vector2f(g.u1, g.v0)));
+            batch.vertices.append(sf::Vertex(sf::Vector2f(l, b), color, sf::Vector2f(g.u0, g.v1)));
+            batch.vertices.append(sf::Vertex(sf::Vector2f(l, b), color, sf::Vector2f(g.u0, g.v1)));
+            batch.vertices.append(sf::Vertex(sf::Vector2f(r, t), color, sf::Vector2f(g.u1, g.v0)));
+            batch.vertices.append(sf::Vertex(sf::Vector2f(r, b), color, sf::Vector2f(g.u1, g.v1)));
+        }
+        penX += g.advance;
+    }
+}
+
+void LabelCache::appendLabel(const CachedLabel& label, unsigned size, float x, float y, const sf::Color& color) {
+    appendText(label.text, label.length, size, x, y, color);
+}
+
+void LabelCache::flush(sf::RenderTarget& target) {
+    for (int i = 0; i < SIZE_COUNT; ++i) {
+        SizeBatch& batch = batches[i];
+        if (batch.vertices.getVertexCount() == 0) continue;
+
+        if (font) {
+            sf::RenderStates states(&font->getTexture(
+                static_cast<unsigned>(GanttConfig::FontConfig::MIN_FONT_SIZE + i)));
+            target.draw(batch.vertices, states);
+        }
+        // clear() 保留容量，稳态下不再分配
+        batch.vertices.clear();
+    }
+    for (auto& extra : extraBatches) {
+        if (extra.batch->vertices.getVertexCount() == 0) continue;
+        if (font) {
+            target.draw(extra.batch->vertices, sf::RenderStates(&font->getTexture(extra.size)));
+        }
+        extra.batch->vertices.clear();
+    }
+}
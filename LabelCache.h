@@ -0,0 +1,118 @@
+//
+// 标签缓存：预排版的标签文本 + 按字号合批的字形顶点
+// 替代每帧为每个标签构造 std::string / sf::Text 的做法
+//
+#ifndef LABEL_CACHE_H
+#define LABEL_CACHE_H
+
+#include "GanttConfig.h"
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+// 标签种类（与数值一起组成缓存键）
+enum class LabelKind : unsigned short {
+    Operation,  // "J<job>-<stage>"
+    Machine,    // "M<machine>"
+    TimeTick    // "<time>"
+};
+
+// 已排版的标签
+struct CachedLabel {
+    char text[24];
+    unsigned char length;
+    float width;   // 与 sf::Text::getLocalBounds().width 等价
+    float height;  // 与 sf::Text::getLocalBounds().height 等价
+};
+
+class LabelCache {
+public:
+    LabelCache();
+
+    /**
+     * @brief 绑定字体并预热 MIN_FONT_SIZE~MAX_FONT_SIZE 的可打印ASCII字形
+     * @note 预热后这些字号的字形页不再增长；范围之外的字号在首次使用时加载，之后同样缓存
+     */
+    void setFont(const sf::Font& font);
+
+    /**
+     * @brief 获取（必要时生成）指定标签的排版结果
+     * @param kind 标签种类
+     * @param a 主数值（作业ID/机器ID/时间）
+     * @param b 次数值（阶段，其他种类为0）
+     * @param size 字号
+     */
+    const CachedLabel& get(LabelKind kind, long long a, int b, unsigned size);
+
+    /**
+     * @brief 测量任意文本（不进入缓存）
+     */
+    void measure(const char* text, std::size_t length, unsigned size, float& width, float& height) const;
+
+    /**
+     * @brief 将文本的字形四边形追加到对应字号的批次中
+     * @param x, y 与 sf::Text::setPosition 相同的定位方式
+     */
+    void appendText(const char* text, std::size_t length, unsigned size,
+        float x, float y, const sf::Color& color);
+    void appendLabel(const CachedLabel& label, unsigned size, float x, float y, const sf::Color& color);
+
+    /**
+     * @brief 绘制并清空所有非空批次（每个字号一次draw调用）
+     */
+    void flush(sf::RenderTarget& target);
+
+    /**
+     * @brief 丢弃所有缓存的标签（不释放内存）
+     */
+    void clearLabels();
+
+private:
+    static const int FIRST_CHAR = 32;
+    static const int LAST_CHAR = 126;
+    static const int CHAR_COUNT = LAST_CHAR - FIRST_CHAR + 1;
+    static const int SIZE_COUNT = GanttConfig::FontConfig::MAX_FONT_SIZE - GanttConfig::FontConfig::MIN_FONT_SIZE + 1;
+
+    struct GlyphQuad {
+        float advance;
+        float left, top, right, bottom;  // 相对笔位置/基线
+        float u0, v0, u1, v1;            // 纹理坐标（像素）
+    };
+
+    // SFML 2.5 中每个字号使用独立的字形纹理页，因此按字号分批
+    struct SizeBatch {
+        GlyphQuad glyphs[CHAR_COUNT];
+        sf::VertexArray vertices;
+    };
+
+    struct Entry {
+        long long a;
+        int b;
+        unsigned short kind;
+        unsigned short size;
+        bool used;
+        CachedLabel label;
+    };
+
+    // 预热范围之外的字号，首次使用时加载（measure 为 const，因此可变）
+    struct ExtraBatch {
+        unsigned size;
+        std::unique_ptr<SizeBatch> batch;
+    };
+
+    const sf::Font* font = nullptr;
+    SizeBatch batches[SIZE_COUNT];
+    mutable std::vector<ExtraBatch> extraBatches;
+
+    // 固定容量的开放寻址表：初始化后不再分配内存，装满后整体清空重建
+    std::vector<Entry> entries;
+    std::size_t usedCount = 0;
+
+    SizeBatch& batchFor(unsigned size);
+    const SizeBatch& batchFor(unsigned size) const;
+    SizeBatch& extraBatchFor(unsigned size) const;
+    void loadGlyphs(SizeBatch& batch, unsigned size) const;
+};
+
+#endif // LABEL_CACHE_H
@@ -0,0 +1,169 @@
+#include "LoadProfile.h"
+#include <algorithm>
+#include <numeric>
+
+template<typename TimeT>
+void BasicLoadProfile<TimeT>::clear() {
+    times.clear();
+    busyValues.clear();
+    criticalValues.clear();
+    busyIntegrals.clear();
+    criticalIntegrals.clear();
+    peakBusy = peakCritical = 0;
+}
+
+template<typename TimeT>
+void BasicLoadProfile<TimeT>::build(const View& view) {
+    std::vector<int> order(view.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&view](int a, int b) {
+        if (view.machineId[a] != view.machineId[b]) return view.machineId[a] < view.machineId[b];
+        return view.startTime[a] < view.startTime[b];
+    });
+
+    std::vector<int> offsets;
+    offsets.reserve(64);
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i == 0 || view.machineId[order[i]] != view.machineId[order[i - 1]]) {
+            offsets.push_back(static_cast<int>(i));
+        }
+    }
+    offsets.push_back(static_cast<int>(order.size()));
+    build(view, offsets, order);
+}
+
+/**
+ * @brief 每台机器上重叠或首尾相接的操作先合并为忙碌区间（一台机器只计一次），
+ *        关键操作逐个计数；所有事件按时间排序后一次扫描得到分段常数函数
+ */
+template<typename TimeT>
+void BasicLoadProfile<TimeT>::build(const View& view, const std::vector<int>& rowOffsets,
+    const std::vector<int>& rowOperations) {
+    clear();
+    events.clear();
+    events.reserve(view.size() * 2);
+
+    for (size_t row = 0; row + 1 < rowOffsets.size(); ++row) {
+        bool open = false;
+        TimeT busyStart = TimeT(), busyEnd = TimeT();
+        for (int k = rowOffsets[row]; k < rowOffsets[row + 1]; ++k) {
+            const int i = rowOperations[k];
+            const TimeT start = view.startTime[i];
+            const TimeT end = view.endTime[i];
+            if (!(start < end)) continue;
+
+            if (view.critical[i]) {
+                events.push_back({ start, 0, 1 });
+                events.push_back({ end, 0, -1 });
+            }
+            if (open && !(busyEnd < start)) {
+                busyEnd = std::max(busyEnd, end);
+                continue;
+            }
+            if (open) {
+                events.push_back({ busyStart, 1, 0 });
+                events.push_back({ busyEnd, -1, 0 });
+            }
+            busyStart = start;
+            busyEnd = end;
+            open = true;
+        }
+        if (open) {
+            events.push_back({ busyStart, 1, 0 });
+            events.push_back({ busyEnd, -1, 0 });
+        }
+    }
+    if (events.empty()) return;
+
+    std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.time < b.time; });
+
+    std::int32_t busy = 0, critical = 0;
+    for (size_t i = 0; i < events.size();) {
+        const TimeT time = events[i].time;
+        for (; i < events.size() && !(time < events[i].time); ++i) {
+            busy += events[i].busy;
+            critical += events[i].critical;
+        }
+        times.push_back(static_cast<double>(time));
+        busyValues.push_back(busy);
+        criticalValues.push_back(critical);
+        peakBusy = std::max(peakBusy, static_cast<int>(busy));
+        peakCritical = std::max(peakCritical, static_cast<int>(critical));
+    }
+    finish();
+}
+
+// 前缀积分：integrals[k] 为从 times[0] 到 times[k] 的积分
+template<typename TimeT>
+void BasicLoadProfile<TimeT>::finish() {
+    const size_t count = times.size();
+    busyIntegrals.resize(count);
+    criticalIntegrals.resize(count);
+    double busySum = 0.0, criticalSum = 0.0;
+    for (size_t k = 0; k < count; ++k) {
+        if (k > 0) {
+            const double width = times[k] - times[k - 1];
+            busySum += busyValues[k - 1] * width;
+            criticalSum += criticalValues[k - 1] * width;
+        }
+        busyIntegrals[k] = busySum;
+        criticalIntegrals[k] = criticalSum;
+    }
+}
+
+// 从 position（其前的断点都不晚于 t）开始按 1, 2, 4... 的步长向后试探，再在最后一段内二分；
+// 代价为 O(log 跨过的断点数)，像素列不多于断点时为 O(1)
+template<typename TimeT>
+size_t BasicLoadProfile<TimeT>::advance(size_t position, double t) const {
+    const size_t count = times.size();
+    size_t low = position;
+    size_t high = position;
+    size_t step = 1;
+    while (high < count && times[high] <= t) {
+        low = high + 1;
+        high = low + step;
+        step *= 2;
+    }
+    high = std::min(high, count);
+    return static_cast<size_t>(std::upper_bound(times.begin() + low, times.begin() + high, t) - times.begin());
+}
+
+template<typename TimeT>
+double BasicLoadProfile<TimeT>::integralAt(const std::vector<std::int32_t>& values, const std::vector<double>& integrals,
+    size_t position, double t) const {
+    if (position == 0) return 0.0;
+    const size_t k = position - 1;
+    return integrals[k] + values[k] * (t - times[k]);
+}
+
+template<typename TimeT>
+void BasicLoadProfile<TimeT>::resample(double from, double to, size_t pixels, float* busy, float* critical) const {
+    if (pixels == 0) return;
+    const double step = (to - from) / pixels;
+    if (times.empty() || !(step > 0.0)) {
+        std::fill(busy, busy + pixels, 0.0f);
+        if (critical) std::fill(critical, critical + pixels, 0.0f);
+        return;
+    }
+
+    // 采样时刻单调递增，断点位置只向后移动，两条曲线共用
+    size_t position = static_cast<size_t>(std::upper_bound(times.begin(), times.end(), from) - times.begin());
+    double busyPrevious = integralAt(busyValues, busyIntegrals, position, from);
+    double criticalPrevious = critical ? integralAt(criticalValues, criticalIntegrals, position, from) : 0.0;
+    for (size_t i = 0; i < pixels; ++i) {
+        const double t = from + step * (i + 1);
+        position = advance(position, t);
+        const double busyNext = integralAt(busyValues, busyIntegrals, position, t);
+        busy[i] = static_cast<float>((busyNext - busyPrevious) / step);
+        busyPrevious = busyNext;
+        if (critical) {
+            const double criticalNext = integralAt(criticalValues, criticalIntegrals, position, t);
+            critical[i] = static_cast<float>((criticalNext - criticalPrevious) / step);
+            criticalPrevious = criticalNext;
+        }
+    }
+}
+
+template class BasicLoadProfile<int>;
+template class BasicLoadProfile<long long>;
+template class BasicLoadProfile<double>;
@@ -0,0 +1,80 @@
+//
+// 全厂负载曲线：忙碌机器数与进行中的关键操作数随时间的变化
+// 每次更新时对开始/结束事件做一次扫描，得到分段常数函数及其前缀积分；
+// 任意时间窗口重采样为 N 个像素列时，每列的值是该列时间段内的平均值（积分之差除以时长），
+// 因此在任何缩放级别下都与数据一致。采样时刻单调递增，断点位置随之向后试探移动而不是每列二分，
+// 代价为 O(N)（断点远多于像素列时每列 O(log 该列内的断点数)）。
+//
+#ifndef LOAD_PROFILE_H
+#define LOAD_PROFILE_H
+
+#include "OperationView.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+template<typename TimeT>
+class BasicLoadProfile {
+public:
+    using View = qm::OperationView<TimeT>;
+
+    /**
+     * @brief 扫描调度建立负载曲线，先按机器与开始时间排序
+     */
+    void build(const View& view);
+
+    /**
+     * @brief 使用已有的行索引建立负载曲线，省去排序
+     * @param rowOffsets CSR 行起始位置（长度为行数+1），每行对应一台机器
+     * @param rowOperations 按行分组、行内按开始时间排序的操作下标
+     */
+    void build(const View& view, const std::vector<int>& rowOffsets, const std::vector<int>& rowOperations);
+
+    void clear();
+    bool empty() const { return times.empty(); }
+
+    // 同时忙碌的机器数与同时进行的关键操作数的最大值
+    int getPeakBusy() const { return peakBusy; }
+    int getPeakCritical() const { return peakCritical; }
+
+    /**
+     * @brief 把 [from, to) 等分为 pixels 列，输出每列内的平均忙碌机器数与平均关键操作数
+     * @param critical 可以为空
+     */
+    void resample(double from, double to, size_t pixels, float* busy, float* critical) const;
+
+private:
+    // 不晚于 t 的断点数，从已知的 position 向后查找
+    size_t advance(size_t position, double t) const;
+    // 累计到 t 时刻的积分，position 为不晚于 t 的断点数
+    double integralAt(const std::vector<std::int32_t>& values, const std::vector<double>& integrals,
+        size_t position, double t) const;
+    void finish();
+
+    // 分段常数函数：values[k] 为 [times[k], times[k+1]) 内的值，最后一个断点之后为 0
+    std::vector<double> times;
+    std::vector<std::int32_t> busyValues;
+    std::vector<std::int32_t> criticalValues;
+    std::vector<double> busyIntegrals;       // 从第一个断点到 times[k] 的积分
+    std::vector<double> criticalIntegrals;
+    int peakBusy = 0;
+    int peakCritical = 0;
+
+    // 扫描用的事件（时间, 忙碌增量, 关键增量），跨次复用
+    struct Event {
+        TimeT time;
+        std::int32_t busy;
+        std::int32_t critical;
+    };
+    std::vector<Event> events;
+};
+
+using LoadProfile = BasicLoadProfile<int>;
+using LoadProfile64 = BasicLoadProfile<long long>;
+using LoadProfileF = BasicLoadProfile<double>;
+
+extern template class BasicLoadProfile<int>;
+extern template class BasicLoadProfile<long long>;
+extern template class BasicLoadProfile<double>;
+
+#endif // LOAD_PROFILE_H
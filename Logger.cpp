@@ -0,0 +1,210 @@
+#include "Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    const char* levelTag(LogLevel level) {
+        switch (level) {
+        case LogLevel::Trace: return "[TRACE] ";
+        case LogLevel::Debug: return "";          // 调试宏自带 [RANGE] 等分类标签
+        case LogLevel::Info: return "[INFO] ";
+        case LogLevel::Warning: return "[WARNING] ";
+        case LogLevel::Error: return "[ERROR] ";
+        default: return "";
+        }
+    }
+
+    // 写入固定缓冲区的 streambuf，写满后截断
+    class FixedStreamBuf : public std::streambuf {
+    public:
+        FixedStreamBuf(char* begin, size_t size) { setp(begin, begin + size); }
+        void restart() { setp(pbase(), epptr()); }
+        const char* data() const { return pbase(); }
+        size_t size() const { return static_cast<size_t>(pptr() - pbase()); }
+    protected:
+        int_type overflow(int_type) override { return traits_type::eof(); }
+    };
+
+    // 每个线程一个格式化缓冲区与流，构造一次后反复使用
+    struct ThreadLineBuffer {
+        char text[GanttConfig::DebugConfig::LOG_MESSAGE_MAX_LENGTH];
+        FixedStreamBuf buffer;
+        std::ostream stream;
+        std::ios_base::fmtflags defaultFlags;
+
+        ThreadLineBuffer() : buffer(text, sizeof(text)), stream(&buffer), defaultFlags(stream.flags()) {}
+
+        void reset() {
+            buffer.restart();
+            stream.clear();
+            stream.flags(defaultFlags);
+            stream.precision(6);
+            stream.width(0);
+            stream.fill(' ');
+        }
+    };
+
+    ThreadLineBuffer& threadLineBuffer() {
+        thread_local ThreadLineBuffer line;
+        return line;
+    }
+
+    std::int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+// === Logger ===
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger()
+    : slots(new Slot[CAPACITY]),
+    level(std::max(0, std::min(GanttConfig::DebugConfig::DEFAULT_LOG_LEVEL, static_cast<int>(LogLevel::Off)))) {
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    writer = std::thread(&Logger::writerLoop, this);
+}
+
+Logger::~Logger() {
+    running.store(false, std::memory_order_release);
+    if (writer.joinable()) {
+        writer.join();
+    }
+}
+
+void Logger::submit(LogLevel messageLevel, const char* text, size_t length) {
+    length = std::min(length, MAX_LENGTH);
+
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots[pos & (CAPACITY - 1)];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // 队列已满：丢弃，由后台线程报告丢弃数量
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->level = messageLevel;
+    slot->length = static_cast<unsigned short>(length);
+    std::memcpy(slot->text, text, length);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+bool Logger::tryPop(LogLevel& messageLevel, char* text, size_t& length) {
+    Slot& slot = slots[dequeuePos & (CAPACITY - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1) {
+        return false;
+    }
+
+    messageLevel = slot.level;
+    length = slot.length;
+    std::memcpy(text, slot.text, length);
+    slot.sequence.store(dequeuePos + CAPACITY, std::memory_order_release);
+    ++dequeuePos;
+    return true;
+}
+
+void Logger::drain() {
+    char text[MAX_LENGTH];
+    size_t length = 0;
+    LogLevel messageLevel;
+    bool wroteOut = false;
+    size_t count = 0;
+
+    while (tryPop(messageLevel, text, length)) {
+        if (messageLevel >= LogLevel::Error) {
+            // 错误输出到 stderr，先刷新 stdout 保持顺序
+            if (wroteOut) {
+                std::fflush(stdout);
+                wroteOut = false;
+            }
+            std::fprintf(stderr, "%s%.*s\n", levelTag(messageLevel), static_cast<int>(length), text);
+        }
+        else {
+            std::fprintf(stdout, "%s%.*s\n", levelTag(messageLevel), static_cast<int>(length), text);
+            wroteOut = true;
+        }
+        ++count;
+    }
+
+    std::uint64_t droppedNow = dropped.load(std::memory_order_relaxed);
+    if (droppedNow != reportedDropped) {
+        std::fprintf(stdout, "[WARNING] Log queue full, %llu messages dropped\n",
+            static_cast<unsigned long long>(droppedNow - reportedDropped));
+        reportedDropped = droppedNow;
+        wroteOut = true;
+    }
+
+    if (wroteOut) {
+        std::fflush(stdout);
+    }
+    if (count) {
+        written.fetch_add(count, std::memory_order_release);
+    }
+}
+
+void Logger::writerLoop() {
+    const auto idle = std::chrono::milliseconds(GanttConfig::DebugConfig::LOG_FLUSH_INTERVAL_MS);
+    while (running.load(std::memory_order_acquire)) {
+        drain();
+        std::this_thread::sleep_for(idle);
+    }
+    drain();
+}
+
+void Logger::flush() {
+    // 等待到调用时刻为止已入队的消息写出
+    const size_t target = enqueuePos.load(std::memory_order_acquire);
+    while (running.load(std::memory_order_acquire) && written.load(std::memory_order_acquire) < target) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// === LineBuilder ===
+
+Logger::LineBuilder::LineBuilder(LogLevel value)
+    : messageLevel(value), out(threadLineBuffer().stream) {
+    threadLineBuffer().reset();
+}
+
+Logger::LineBuilder::~LineBuilder() {
+    ThreadLineBuffer& line = threadLineBuffer();
+    Logger::instance().submit(messageLevel, line.buffer.data(), line.buffer.size());
+}
+
+// === RateLimiter ===
+
+bool Logger::RateLimiter::allow(std::uint32_t& suppressedOut) {
+    const std::int64_t now = nowNs();
+    std::int64_t last = lastNs.load(std::memory_order_relaxed);
+    if (last != INT64_MIN && now - last < intervalNs) {
+        suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // 多个线程同时到达时只有一个输出
+    if (!lastNs.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+        suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    suppressedOut = suppressed.exchange(0, std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,127 @@
+//
+// 异步日志
+// 调用线程只在线程局部缓冲区中格式化并写入无锁队列，由后台线程负责输出，
+// 队列满时丢弃消息而不是等待，因此日志调用不会阻塞绘制或更新路径
+//
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include "GanttConfig.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+
+enum class LogLevel {
+    Trace,
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Off
+};
+
+class Logger {
+public:
+    static Logger& instance();
+
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    void setLevel(LogLevel value) { level.store(static_cast<int>(value), std::memory_order_relaxed); }
+    LogLevel getLevel() const { return static_cast<LogLevel>(level.load(std::memory_order_relaxed)); }
+    bool shouldLog(LogLevel value) const {
+        return static_cast<int>(value) >= level.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 提交一条已格式化的消息（不阻塞，队列满时丢弃并计数）
+     */
+    void submit(LogLevel messageLevel, const char* text, size_t length);
+
+    /**
+     * @brief 等待队列中的消息全部写出（仅用于退出或测试，会阻塞）
+     */
+    void flush();
+
+    std::uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 线程局部的格式化流，写入固定大小的缓冲区，不分配内存
+     */
+    class LineBuilder {
+    public:
+        explicit LineBuilder(LogLevel messageLevel);
+        ~LineBuilder();
+        std::ostream& stream() { return out; }
+    private:
+        LogLevel messageLevel;
+        std::ostream& out;
+    };
+
+    /**
+     * @brief 每个调用点一个限频器：间隔内的消息被计数并在下一次输出时报告
+     */
+    class RateLimiter {
+    public:
+        explicit RateLimiter(int intervalMs) : intervalNs(static_cast<std::int64_t>(intervalMs) * 1000000) {}
+        bool allow(std::uint32_t& suppressedOut);
+    private:
+        std::int64_t intervalNs;
+        std::atomic<std::int64_t> lastNs{ INT64_MIN };
+        std::atomic<std::uint32_t> suppressed{ 0 };
+    };
+
+private:
+    static const size_t CAPACITY = GanttConfig::DebugConfig::LOG_QUEUE_CAPACITY;
+    static const size_t MAX_LENGTH = GanttConfig::DebugConfig::LOG_MESSAGE_MAX_LENGTH;
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "LOG_QUEUE_CAPACITY must be a power of two");
+
+    // 有界多生产者队列的槽（Vyukov），sequence 指示槽的状态
+    struct Slot {
+        std::atomic<size_t> sequence;
+        LogLevel level;
+        unsigned short length;
+        char text[MAX_LENGTH];
+    };
+
+    Logger();
+
+    bool tryPop(LogLevel& messageLevel, char* text, size_t& length);
+    void writerLoop();
+    void drain();
+
+    std::unique_ptr<Slot[]> slots;
+    alignas(64) std::atomic<size_t> enqueuePos{ 0 };
+    alignas(64) size_t dequeuePos = 0;
+    alignas(64) std::atomic<std::uint64_t> dropped{ 0 };
+    std::uint64_t reportedDropped = 0;
+    std::atomic<size_t> written{ 0 };
+    std::atomic<int> level;
+    std::atomic<bool> running{ true };
+    std::thread writer;
+};
+
+// 日志宏：先检查级别，未启用时不进行任何格式化
+#define GANTT_LOG(level, x) do { \
+    if (Logger::instance().shouldLog(level)) { \
+        Logger::LineBuilder ganttLogLine_(level); ganttLogLine_.stream() << x; \
+    } } while(0)
+
+// 限频日志：同一调用点在 LOG_RATE_LIMIT_MS 内只输出一次
+#define GANTT_LOG_RATE_LIMITED(level, x) do { \
+    if (Logger::instance().shouldLog(level)) { \
+        static Logger::RateLimiter ganttLogLimiter_(GanttConfig::DebugConfig::LOG_RATE_LIMIT_MS); \
+        std::uint32_t ganttLogSuppressed_ = 0; \
+        if (ganttLogLimiter_.allow(ganttLogSuppressed_)) { \
+            Logger::LineBuilder ganttLogLine_(level); ganttLogLine_.stream() << x; \
+            if (ganttLogSuppressed_) ganttLogLine_.stream() << " (" << ganttLogSuppressed_ << " similar suppressed)"; \
+        } \
+    } } while(0)
+
+#endif // LOGGER_H
@@ -0,0 +1,123 @@
+#include "MachineGroups.h"
+#include "Logger.h"
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+
+namespace {
+    std::string trim(const std::string& text) {
+        size_t begin = 0;
+        size_t end = text.size();
+        while (begin < end && std::isspace(static_cast<unsigned char>(text[begin]))) ++begin;
+        while (end > begin && std::isspace(static_cast<unsigned char>(text[end - 1]))) --end;
+        return text.substr(begin, end - begin);
+    }
+
+    // 去掉各级名称两侧的空白与空的层级
+    std::string normalizePath(const std::string& path) {
+        std::string result;
+        size_t begin = 0;
+        while (begin <= path.size()) {
+            size_t end = path.find('/', begin);
+            if (end == std::string::npos) end = path.size();
+            const std::string name = trim(path.substr(begin, end - begin));
+            if (!name.empty()) {
+                if (!result.empty()) result += '/';
+                result += name;
+            }
+            begin = end + 1;
+        }
+        return result;
+    }
+}
+
+bool MachineGroups::loadFromFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        GANTT_LOG(LogLevel::Error, "Cannot open machine group file: " << filename);
+        return false;
+    }
+
+    clear();
+    std::string line;
+    size_t lineNumber = 0;
+    size_t skipped = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        const std::string text = trim(line);
+        if (text.empty() || text[0] == '#') continue;
+
+        const size_t comma = text.find(',');
+        if (comma == std::string::npos) {
+            ++skipped;
+            continue;
+        }
+        const std::string id = trim(text.substr(0, comma));
+        char* end = nullptr;
+        const long machineId = std::strtol(id.c_str(), &end, 10);
+        if (id.empty() || *end != '\0') {
+            // 第一行可以是表头
+            if (lineNumber > 1) ++skipped;
+            continue;
+        }
+        assign(static_cast<int>(machineId), text.substr(comma + 1));
+    }
+
+    if (skipped > 0) {
+        GANTT_LOG(LogLevel::Warning, "Skipped " << skipped << " malformed lines in machine group file: " << filename);
+    }
+    GANTT_LOG(LogLevel::Info, "Loaded " << machineGroups.size() << " machines in " << groups.size() << " groups from " << filename);
+    return true;
+}
+
+void MachineGroups::assign(int machineId, const std::string& path) {
+    const std::string normalized = normalizePath(path);
+    if (normalized.empty()) {
+        machineGroups.erase(machineId);
+        return;
+    }
+    machineGroups[machineId] = obtainGroup(normalized);
+}
+
+// 依次创建路径上缺少的各级分组
+int MachineGroups::obtainGroup(const std::string& path) {
+    auto found = pathIndex.find(path);
+    if (found != pathIndex.end()) return found->second;
+
+    const size_t slash = path.rfind('/');
+    const int parent = slash == std::string::npos ? -1 : obtainGroup(path.substr(0, slash));
+
+    Group group;
+    group.name = slash == std::string::npos ? path : path.substr(slash + 1);
+    group.path = path;
+    group.parent = parent;
+    group.depth = parent >= 0 ? groups[parent].depth + 1 : 0;
+
+    const int index = static_cast<int>(groups.size());
+    groups.push_back(group);
+    if (parent >= 0) {
+        groups[parent].children.push_back(index);
+    }
+    else {
+        roots.push_back(index);
+    }
+    pathIndex.emplace(path, index);
+    return index;
+}
+
+void MachineGroups::clear() {
+    groups.clear();
+    roots.clear();
+    pathIndex.clear();
+    machineGroups.clear();
+}
+
+int MachineGroups::getGroupOf(int machineId) const {
+    const auto it = machineGroups.find(machineId);
+    return it != machineGroups.end() ? it->second : -1;
+}
+
+int MachineGroups::findGroup(const std::string& path) const {
+    const auto it = pathIndex.find(normalizePath(path));
+    return it != pathIndex.end() ? it->second : -1;
+}
@@ -0,0 +1,60 @@
+//
+// 机器分组：机器ID -> 分组路径（例如 "Line A/WC 2"），路径中的每一级是一个分组，构成一棵树
+// 由旁路文件加载，每行 "machine_id,分组路径"，层级用 / 分隔；# 开头的行与无法解析的行被忽略。
+// 图表把每个分组显示为可折叠的汇总行，只有展开的分组才显示各台机器的操作。
+//
+#ifndef MACHINE_GROUPS_H
+#define MACHINE_GROUPS_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class MachineGroups {
+public:
+    struct Group {
+        std::string name;         // 本级名称
+        std::string path;         // 完整路径
+        int parent = -1;          // 上级分组，-1 表示顶层
+        int depth = 0;
+        std::vector<int> children;
+    };
+
+    /**
+     * @brief 从文件加载，替换现有内容
+     * @return 文件无法打开时返回false
+     */
+    bool loadFromFile(const std::string& filename);
+
+    /**
+     * @brief 把机器归入分组（不存在的各级分组按出现顺序创建），重复指定时以最后一次为准
+     */
+    void assign(int machineId, const std::string& path);
+
+    void clear();
+    bool empty() const { return groups.empty(); }
+
+    /**
+     * @brief 机器直接所属的分组，未分组时返回-1
+     */
+    int getGroupOf(int machineId) const;
+
+    /**
+     * @brief 按完整路径查找分组，不存在时返回-1
+     */
+    int findGroup(const std::string& path) const;
+
+    const std::vector<Group>& getGroups() const { return groups; }
+    const std::vector<int>& getRoots() const { return roots; }
+    size_t getMachineCount() const { return machineGroups.size(); }
+
+private:
+    int obtainGroup(const std::string& path);
+
+    std::vector<Group> groups;
+    std::vector<int> roots;                            // 顶层分组，按出现顺序
+    std::unordered_map<std::string, int> pathIndex;
+    std::unordered_map<int, int> machineGroups;        // 机器ID -> 分组
+};
+
+#endif // MACHINE_GROUPS_H
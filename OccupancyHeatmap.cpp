@@ -0,0 +1,245 @@
+#include "OccupancyHeatmap.h"
+#include "GanttConfig.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GANTT_HAS_SSE2 1
+#else
+#define GANTT_HAS_SSE2 0
+#endif
+
+namespace {
+    // 在 threads 个线程上执行 fn(0..count-1)，任务动态分配
+    template<typename Fn>
+    void parallelFor(size_t count, int threads, Fn fn) {
+        threads = static_cast<int>(std::min<size_t>(static_cast<size_t>(std::max(1, threads)), count));
+        if (threads <= 1) {
+            for (size_t i = 0; i < count; ++i) fn(i);
+            return;
+        }
+
+        std::atomic<size_t> nextIndex{ 0 };
+        auto worker = [&]() {
+            for (size_t i = nextIndex.fetch_add(1); i < count; i = nextIndex.fetch_add(1)) {
+                fn(i);
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (int t = 1; t < threads; ++t) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    }
+
+    // into[i] += from[i]，随后清零 from
+    void addAndClear(std::int32_t* into, std::int32_t* from, size_t count) {
+        size_t i = 0;
+#if GANTT_HAS_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 4 <= count; i += 4) {
+            __m128i sum = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(into + i)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(from + i)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(into + i), sum);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(from + i), zero);
+        }
+#endif
+        for (; i < count; ++i) {
+            into[i] += from[i];
+            from[i] = 0;
+        }
+    }
+}
+
+template<typename TimeT>
+void BasicOccupancyHeatmap<TimeT>::configure(TimeT start, TimeT end, int buckets, const std::vector<int>& machineIds,
+    size_t slotCount) {
+    startTime = start;
+    endTime = end;
+    bucketCount = std::max(1, buckets);
+    const double span = static_cast<double>(end) - static_cast<double>(start);
+    bucketsPerTime = span > 0.0 ? bucketCount / span : 0.0;
+
+    machines = machineIds;
+    std::sort(machines.begin(), machines.end());
+    machines.erase(std::unique(machines.begin(), machines.end()), machines.end());
+
+    slots.assign(slotCount, Slot());
+    filledCount = 0;
+    counts.assign(machines.size() * bucketCount, 0);
+    prepareScratch(scratch);
+}
+
+template<typename TimeT>
+void BasicOccupancyHeatmap<TimeT>::prepareScratch(Scratch& buffers) const {
+    buffers.direct.assign(machines.size() * bucketCount, 0);
+    buffers.diff.assign(machines.size() * (bucketCount + 1), 0);
+    buffers.touched.assign(machines.size(), 0);
+}
+
+// 把调度转换为 (行, 定点起止) 并截断到时间范围内；保存下来用于之后减去其贡献
+template<typename TimeT>
+void BasicOccupancyHeatmap<TimeT>::convert(const View& schedule, Slot& slot) const {
+    slot.spans.clear();
+    slot.filled = true;
+    const double limit = static_cast<double>(bucketCount) * COVERAGE_SCALE;
+    const double scale = bucketsPerTime * COVERAGE_SCALE;
+    const double origin = static_cast<double>(startTime);
+
+    for (size_t i = 0; i < schedule.size(); ++i) {
+        const auto it = std::lower_bound(machines.begin(), machines.end(), schedule.machineId[i]);
+        if (it == machines.end() || *it != schedule.machineId[i]) continue;
+
+        const double first = std::max(0.0, (static_cast<double>(schedule.startTime[i]) - origin) * scale);
+        const double last = std::min(limit, (static_cast<double>(schedule.endTime[i]) - origin) * scale);
+        const std::int32_t a = static_cast<std::int32_t>(std::llround(first));
+        const std::int32_t b = static_cast<std::int32_t>(std::llround(last));
+        if (b <= a) continue;
+        slot.spans.push_back({ static_cast<std::int32_t>(it - machines.begin()), a, b });
+    }
+}
+
+// 首尾不完整的桶直接累加，中间的整桶写入差分数组
+template<typename TimeT>
+void BasicOccupancyHeatmap<TimeT>::rasterize(const Slot& slot, int sign, Scratch& buffers) const {
+    const std::int32_t full = sign * COVERAGE_SCALE;
+    for (const Span& span : slot.spans) {
+        std::int32_t* direct = buffers.direct.data() + static_cast<size_t>(span.row) * bucketCount;
+        std::int32_t* diff = buffers.diff.data() + static_cast<size_t>(span.row) * (bucketCount + 1);
+        buffers.touched[span.row] = 1;
+
+        const std::int32_t b0 = span.first / COVERAGE_SCALE;
+        const std::int32_t b1 = span.last / COVERAGE_SCALE;
+        if (b0 == b1) {
+            direct[b0] += sign * (span.last - span.first);
+            continue;
+        }
+        direct[b0] += sign * ((b0 + 1) * COVERAGE_SCALE - span.first);
+        if (b1 > b0 + 1) {
+            diff[b0 + 1] += full;
+            diff[b1] -= full;
+        }
+        if (b1 < bucketCount) {
+            direct[b1] += sign * (span.last - b1 * COVERAGE_SCALE);
+        }
+    }
+}
+
+template<typename TimeT>
+void BasicOccupancyHeatmap<TimeT>::resolveRow(Scratch& buffers, size_t row) const {
+    std::int32_t* direct = buffers.direct.data() + row * bucketCount;
+    std::int32_t* diff = buffers.diff.data() + row * (bucketCount + 1);
+    std::int32_t running = 0;
+    for (int b = 0; b < bucketCount; ++b) {
+        running += diff[b];
+        direct[b] += running;
+        diff[b] = 0;
+    }
+    diff[bucketCount] = 0;
+}
+
+template<typename TimeT>
+void BasicOccupancyHeatmap<TimeT>::build(const std::vector<View>& schedules, int threadCount) {
+    const size_t count = std::min(schedules.size(), slots.size());
+    size_t totalOperations = 0;
+    for (size_t i = 0; i < count; ++i) totalOperations += schedules[i].size();
+
+    int threads = threadCount > 0 ? threadCount : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    if (totalOperations < static_cast<size_t>(GanttConfig::HeatmapConfig::PARALLEL_MIN_OPERATIONS)) {
+        threads = 1;
+    }
+    threads = static_cast<int>(std::max<size_t>(1, std::min<size_t>(threads, std::max<size_t>(1, count))));
+
+    // 每个线程负责一段连续的槽位，写入自己的缓冲区
+    std::vector<Scratch> partials(threads);
+    parallelFor(static_cast<size_t>(threads), threads, [&](size_t t) {
+        Scratch& buffers = t == 0 ? scratch : partials[t];
+        if (t != 0) prepareScratch(buffers);
+        const size_t begin = count * t / threads;
+        const size_t end = count * (t + 1) / threads;
+        for (size_t i = begin; i < end; ++i) {
+            convert(schedules[i], slots[i]);
+            rasterize(slots[i], 1, buffers);
+        }
+    });
+    for (size_t i = count; i < slots.size(); ++i) {
+        slots[i] = Slot();
+    }
+    filledCount = count;
+
+    // 按行分块求前缀和，再把各线程的结果加到计数上
+    std::fill(counts.begin(), counts.end(), 0);
+    const size_t rows = machines.size();
+    parallelFor(static_cast<size_t>(threads), threads, [&](size_t block) {
+        const size_t begin = rows * block / threads;
+        const size_t end = rows * (block + 1) / threads;
+        for (int t = 0; t < threads; ++t) {
+            Scratch& buffers = t == 0 ? scratch : partials[t];
+            for (size_t row = begin; row < end; ++row) {
+                if (!buffers.touched[row]) continue;
+                resolveRow(buffers, row);
+                addAndClear(counts.data() + row * bucketCount, buffers.direct.data() + row * bucketCount, bucketCount);
+                buffers.touched[row] = 0;
+            }
+        }
+    });
+}
+
+// 把增量替换累加的结果并入计数，只处理涉及的行
+template<typename TimeT>
+void BasicOccupancyHeatmap<TimeT>::commitScratch() {
+    for (size_t row = 0; row < machines.size(); ++row) {
+        if (!scratch.touched[row]) continue;
+        resolveRow(scratch, row);
+        addAndClear(counts.data() + row * bucketCount, scratch.direct.data() + row * bucketCount, bucketCount);
+        scratch.touched[row] = 0;
+    }
+}
+
+template<typename TimeT>
+bool BasicOccupancyHeatmap<TimeT>::setSchedule(size_t slot, const View& schedule) {
+    if (slot >= slots.size()) return false;
+    Slot& target = slots[slot];
+    if (target.filled) {
+        rasterize(target, -1, scratch);
+    }
+    else {
+        ++filledCount;
+    }
+    convert(schedule, target);
+    rasterize(target, 1, scratch);
+
+    commitScratch();
+    return true;
+}
+
+template<typename TimeT>
+bool BasicOccupancyHeatmap<TimeT>::clearSchedule(size_t slot) {
+    if (slot >= slots.size() || !slots[slot].filled) return false;
+    Slot& target = slots[slot];
+    rasterize(target, -1, scratch);
+    commitScratch();
+    target = Slot();
+    --filledCount;
+    return true;
+}
+
+template<typename TimeT>
+float BasicOccupancyHeatmap<TimeT>::getOccupancy(size_t row, int bucket) const {
+    if (filledCount == 0) return 0.0f;
+    const float value = static_cast<float>(counts[row * bucketCount + bucket]) /
+        (static_cast<float>(COVERAGE_SCALE) * static_cast<float>(filledCount));
+    return std::min(1.0f, value);
+}
+
+template class BasicOccupancyHeatmap<int>;
+template class BasicOccupancyHeatmap<long long>;
+template class BasicOccupancyHeatmap<double>;
@@ -0,0 +1,103 @@
+//
+// 种群占用热力图：统计 N 个候选调度中，每台机器在每个时间桶内处于忙碌状态的比例
+// 每个操作按定点覆盖率（桶宽的 1/COVERAGE_SCALE）光栅化到时间桶：首尾两个桶直接累加，
+// 中间的整桶写入差分数组，每行一次前缀和后再整行加到计数上（SSE2 可用时每次 4 个计数）。
+// 替换单个调度时减去旧调度、加上新调度的贡献，只处理涉及的机器行。
+//
+#ifndef OCCUPANCY_HEATMAP_H
+#define OCCUPANCY_HEATMAP_H
+
+#include "OperationView.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+template<typename TimeT>
+class BasicOccupancyHeatmap {
+public:
+    using View = qm::OperationView<TimeT>;
+
+    BasicOccupancyHeatmap() = default;
+
+    /**
+     * @brief 设置时间范围、桶数、机器行与调度槽位数，并清空所有调度
+     * @param machines 机器ID（会排序去重），不在其中的机器上的操作被忽略
+     */
+    void configure(TimeT startTime, TimeT endTime, int bucketCount, const std::vector<int>& machines, size_t slotCount);
+
+    /**
+     * @brief 一次替换所有槽位（schedules.size() 不超过槽位数，其余槽位清空），按槽位分块并行光栅化
+     * @param threadCount 0 表示使用硬件线程数
+     */
+    void build(const std::vector<View>& schedules, int threadCount = 0);
+
+    /**
+     * @brief 替换一个槽位中的调度：减去旧调度的贡献，加上新调度的贡献
+     */
+    bool setSchedule(size_t slot, const View& schedule);
+    bool clearSchedule(size_t slot);
+
+    size_t getSlotCount() const { return slots.size(); }
+    size_t getFilledCount() const { return filledCount; }
+    int getBucketCount() const { return bucketCount; }
+    const std::vector<int>& getMachines() const { return machines; }
+    TimeT getStartTime() const { return startTime; }
+    TimeT getEndTime() const { return endTime; }
+
+    /**
+     * @brief 第 row 台机器在第 bucket 个桶内忙碌的调度比例（0-1，按忙碌时间加权）
+     */
+    float getOccupancy(size_t row, int bucket) const;
+
+    /**
+     * @brief 第 row 台机器的原始计数（单位为桶宽的 1/COVERAGE_SCALE，对所有调度求和）
+     */
+    const std::int32_t* getRow(size_t row) const { return counts.data() + row * bucketCount; }
+
+    static const int COVERAGE_SCALE = 1024;
+
+private:
+    struct Span {
+        std::int32_t row;
+        std::int32_t first;   // 覆盖的起止位置（定点，单位为桶宽的 1/COVERAGE_SCALE）
+        std::int32_t last;
+    };
+
+    struct Slot {
+        std::vector<Span> spans;
+        bool filled = false;
+    };
+
+    // 每个线程一份的累加缓冲区
+    struct Scratch {
+        std::vector<std::int32_t> direct;   // 行数 * 桶数
+        std::vector<std::int32_t> diff;     // 行数 * (桶数 + 1)
+        std::vector<char> touched;          // 本轮涉及的行
+    };
+
+    void convert(const View& schedule, Slot& slot) const;
+    void rasterize(const Slot& slot, int sign, Scratch& scratch) const;
+    void resolveRow(Scratch& scratch, size_t row) const;   // 差分求前缀和并入 direct
+    void prepareScratch(Scratch& scratch) const;
+    void commitScratch();
+
+    TimeT startTime = TimeT();
+    TimeT endTime = TimeT();
+    int bucketCount = 0;
+    double bucketsPerTime = 0.0;
+    std::vector<int> machines;
+    std::vector<Slot> slots;
+    size_t filledCount = 0;
+    std::vector<std::int32_t> counts;   // 行数 * 桶数
+    Scratch scratch;                    // 增量替换使用
+};
+
+using OccupancyHeatmap = BasicOccupancyHeatmap<int>;
+using OccupancyHeatmap64 = BasicOccupancyHeatmap<long long>;
+using OccupancyHeatmapF = BasicOccupancyHeatmap<double>;
+
+extern template class BasicOccupancyHeatmap<int>;
+extern template class BasicOccupancyHeatmap<long long>;
+extern template class BasicOccupancyHeatmap<double>;
+
+#endif // OCCUPANCY_HEATMAP_H
@@ -0,0 +1,222 @@
+//
+// 操作数据视图：以跨步字段描述调用方自有的内存布局，读取时不转换、不拷贝
+// 支持结构体数组（成员指针 / OperationLayout 特化）与数组结构体（每个字段一个数组）
+//
+#ifndef OPERATION_VIEW_H
+#define OPERATION_VIEW_H
+
+#include "data.h"
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace qm {
+    // 单个字段的跨步访问：第 i 个元素位于 base + i * stride
+    template<typename T>
+    struct StridedField {
+        const char* base = nullptr;
+        std::size_t stride = 0;
+
+        const T& operator[](std::size_t i) const {
+            return *reinterpret_cast<const T*>(base + i * stride);
+        }
+    };
+
+    /**
+     * @brief 记录类型的字段映射，默认使用与 BasicOperation 相同的字段名
+     *
+     * 字段名不同时特化即可，例如：
+     *   template<> struct qm::OperationLayout<SolverTask> {
+     *       static constexpr auto job_id = &SolverTask::job;
+     *       static constexpr auto stage = &SolverTask::step;
+     *       static constexpr auto machine_id = &SolverTask::resource;
+     *       static constexpr auto start_time = &SolverTask::begin;
+     *       static constexpr auto end_time = &SolverTask::finish;
+     *       static constexpr auto is_critical = &SolverTask::critical;
+     *   };
+     */
+    template<typename Record>
+    struct OperationLayout {
+        static constexpr auto job_id = &Record::job_id;
+        static constexpr auto stage = &Record::stage;
+        static constexpr auto machine_id = &Record::machine_id;
+        static constexpr auto start_time = &Record::start_time;
+        static constexpr auto end_time = &Record::end_time;
+        static constexpr auto is_critical = &Record::is_critical;
+    };
+
+    /**
+     * @brief 只读操作视图
+     *
+     * 字段类型必须与图表一致（ID为int、时间为TimeT、关键标记为bool），
+     * 时间类型不同时请选择对应的 BasicGanttChart<TimeT> 实例，或使用会拷贝的 BasicData。
+     * 视图不拥有内存，调用方负责保证其在使用期间有效。
+     */
+    template<typename TimeT>
+    class OperationView {
+    public:
+        using Operation = BasicOperation<TimeT>;
+
+        StridedField<int> jobId;
+        StridedField<int> stage;
+        StridedField<int> machineId;
+        StridedField<TimeT> startTime;
+        StridedField<TimeT> endTime;
+        StridedField<bool> critical;
+
+        class const_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Operation;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = Operation;
+
+            const_iterator(const OperationView* owner, std::size_t position) : view(owner), index(position) {}
+            Operation operator*() const { return (*view)[index]; }
+            const_iterator& operator++() { ++index; return *this; }
+            bool operator==(const const_iterator& other) const { return index == other.index; }
+            bool operator!=(const const_iterator& other) const { return index != other.index; }
+        private:
+            const OperationView* view;
+            std::size_t index;
+        };
+
+        OperationView() = default;
+
+        /**
+         * @brief 结构体数组：通过成员指针描述字段，跨步为 sizeof(Record)
+         * @param stage, isCritical 为空成员指针时读取为 0 / false；直接传 nullptr 使用下面的重载
+         */
+        template<typename Record, typename J, typename S, typename M, typename T0, typename T1, typename C>
+        static OperationView fromMembers(const Record* records, std::size_t count,
+            J Record::* jobId, S Record::* stage, M Record::* machineId,
+            T0 Record::* startTime, T1 Record::* endTime, C Record::* isCritical) {
+            static_assert(std::is_same<J, int>::value && std::is_same<S, int>::value && std::is_same<M, int>::value,
+                "job_id, stage and machine_id must be int");
+            static_assert(std::is_same<T0, TimeT>::value && std::is_same<T1, TimeT>::value,
+                "start_time/end_time must match the chart's time type");
+            static_assert(std::is_same<C, bool>::value, "is_critical must be bool");
+
+            OperationView view;
+            if (!records || count == 0) return view;
+
+            view.count = count;
+            view.jobId = memberField<int>(records, jobId);
+            view.stage = stage ? memberField<int>(records, stage) : zeroField<int>();
+            view.machineId = memberField<int>(records, machineId);
+            view.startTime = memberField<TimeT>(records, startTime);
+            view.endTime = memberField<TimeT>(records, endTime);
+            view.critical = isCritical ? memberField<bool>(records, isCritical) : zeroField<bool>();
+            return view;
+        }
+
+        /**
+         * @brief 记录中没有工序号和/或关键标记时，对应参数直接传 nullptr（字面量无法推导成员指针类型）
+         */
+        template<typename Record, typename J, typename M, typename T0, typename T1, typename C>
+        static OperationView fromMembers(const Record* records, std::size_t count,
+            J Record::* jobId, std::nullptr_t, M Record::* machineId,
+            T0 Record::* startTime, T1 Record::* endTime, C Record::* isCritical) {
+            return fromMembers(records, count, jobId, static_cast<int Record::*>(nullptr), machineId,
+                startTime, endTime, isCritical);
+        }
+
+        template<typename Record, typename J, typename S, typename M, typename T0, typename T1>
+        static OperationView fromMembers(const Record* records, std::size_t count,
+            J Record::* jobId, S Record::* stage, M Record::* machineId,
+            T0 Record::* startTime, T1 Record::* endTime, std::nullptr_t) {
+            return fromMembers(records, count, jobId, stage, machineId,
+                startTime, endTime, static_cast<bool Record::*>(nullptr));
+        }
+
+        template<typename Record, typename J, typename M, typename T0, typename T1>
+        static OperationView fromMembers(const Record* records, std::size_t count,
+            J Record::* jobId, std::nullptr_t, M Record::* machineId,
+            T0 Record::* startTime, T1 Record::* endTime, std::nullptr_t) {
+            return fromMembers(records, count, jobId, static_cast<int Record::*>(nullptr), machineId,
+                startTime, endTime, static_cast<bool Record::*>(nullptr));
+        }
+
+        /**
+         * @brief 连续容器（std::vector 等），字段由 OperationLayout<Record> 描述
+         */
+        template<typename Container>
+        static OperationView fromRecords(const Container& records) {
+            using Record = typename std::decay<decltype(*records.data())>::type;
+            using Layout = OperationLayout<Record>;
+            return fromMembers(records.data(), records.size(), Layout::job_id, Layout::stage, Layout::machine_id,
+                Layout::start_time, Layout::end_time, Layout::is_critical);
+        }
+
+        /**
+         * @brief 数组结构体：每个字段一个连续数组
+         * @param stage, isCritical 可以为 nullptr
+         */
+        static OperationView fromArrays(std::size_t count, const int* jobIds, const int* stages, const int* machineIds,
+            const TimeT* startTimes, const TimeT* endTimes, const bool* isCritical) {
+            OperationView view;
+            if (count == 0) return view;
+
+            view.count = count;
+            view.jobId = arrayField(jobIds);
+            view.stage = stages ? arrayField(stages) : zeroField<int>();
+            view.machineId = arrayField(machineIds);
+            view.startTime = arrayField(startTimes);
+            view.endTime = arrayField(endTimes);
+            view.critical = isCritical ? arrayField(isCritical) : zeroField<bool>();
+            return view;
+        }
+
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        void clear() { *this = OperationView(); }
+
+        // 按需组装单个操作；只用到部分字段时，多余的读取会被编译器消除
+        Operation operator[](std::size_t i) const {
+            Operation op;
+            op.job_id = jobId[i];
+            op.stage = stage[i];
+            op.machine_id = machineId[i];
+            op.start_time = startTime[i];
+            op.end_time = endTime[i];
+            op.is_critical = critical[i];
+            return op;
+        }
+
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, count); }
+
+    private:
+        std::size_t count = 0;
+
+        template<typename T, typename Record, typename Member>
+        static StridedField<T> memberField(const Record* records, Member Record::* member) {
+            StridedField<T> field;
+            field.base = reinterpret_cast<const char*>(&(records->*member));
+            field.stride = sizeof(Record);
+            return field;
+        }
+
+        template<typename T>
+        static StridedField<T> arrayField(const T* values) {
+            StridedField<T> field;
+            field.base = reinterpret_cast<const char*>(values);
+            field.stride = sizeof(T);
+            return field;
+        }
+
+        // 跨步为0的常量字段，用于缺省的可选字段
+        template<typename T>
+        static StridedField<T> zeroField() {
+            alignas(16) static const char zeros[16] = {};
+            static_assert(sizeof(T) <= sizeof(zeros), "field type too large");
+            StridedField<T> field;
+            field.base = zeros;
+            field.stride = 0;
+            return field;
+        }
+    };
+}
+
+#endif // OPERATION_VIEW_H
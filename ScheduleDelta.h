@@ -0,0 +1,247 @@
+//
+// 以 (job_id, stage) 为键的调度增量
+// 增量由新增/修改的操作与被删除的键组成，可以合并，也可以应用到完整的操作向量上
+//
+#ifndef SCHEDULE_DELTA_H
+#define SCHEDULE_DELTA_H
+
+#include "data.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace qm {
+    // 操作的唯一键
+    struct OperationKey {
+        int job_id;
+        int stage;
+
+        bool operator==(const OperationKey& other) const { return job_id == other.job_id && stage == other.stage; }
+        bool operator!=(const OperationKey& other) const { return !(*this == other); }
+    };
+
+    inline std::uint64_t packKey(int jobId, int stage) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(jobId)) << 32) | static_cast<std::uint32_t>(stage);
+    }
+
+    inline std::uint64_t packKey(const OperationKey& key) { return packKey(key.job_id, key.stage); }
+
+    template<typename TimeT>
+    inline std::uint64_t packKey(const BasicOperation<TimeT>& op) { return packKey(op.job_id, op.stage); }
+
+    // 64位键的哈希（splitmix 终结函数），避免连续作业号集中在少数桶
+    struct KeyHash {
+        std::size_t operator()(std::uint64_t key) const {
+            key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+            return static_cast<std::size_t>(key ^ (key >> 31));
+        }
+    };
+
+    template<typename TimeT>
+    struct BasicScheduleDelta {
+        std::vector<BasicOperation<TimeT>> upserts;  // 新增或修改（按键覆盖）
+        std::vector<OperationKey> removals;          // 删除
+
+        bool empty() const { return upserts.empty() && removals.empty(); }
+        std::size_t size() const { return upserts.size() + removals.size(); }
+        void clear() {
+            upserts.clear();
+            removals.clear();
+        }
+    };
+
+    /**
+     * @brief 把较晚的增量合并到 into 中，结果等价于先后应用两者
+     */
+    template<typename TimeT>
+    void mergeScheduleDelta(BasicScheduleDelta<TimeT>& into, const BasicScheduleDelta<TimeT>& later) {
+        if (later.empty()) return;
+
+        std::unordered_map<std::uint64_t, std::size_t, KeyHash> upsertIndex;
+        upsertIndex.reserve(into.upserts.size() + later.upserts.size());
+        for (std::size_t i = 0; i < into.upserts.size(); ++i) {
+            upsertIndex[packKey(into.upserts[i])] = i;
+        }
+        std::unordered_map<std::uint64_t, std::size_t, KeyHash> removalIndex;
+        removalIndex.reserve(into.removals.size() + later.removals.size());
+        for (std::size_t i = 0; i < into.removals.size(); ++i) {
+            removalIndex[packKey(into.removals[i])] = i;
+        }
+
+        const std::size_t erased = static_cast<std::size_t>(-1);
+        // 较晚的删除：撤销较早的修改并记录删除
+        for (const OperationKey& key : later.removals) {
+            const std::uint64_t packed = packKey(key);
+            auto it = upsertIndex.find(packed);
+            if (it != upsertIndex.end()) {
+                it->second = erased;
+            }
+            if (removalIndex.emplace(packed, into.removals.size()).second) {
+                into.removals.push_back(key);
+            }
+        }
+        // 较晚的修改：覆盖较早的修改；同键的删除可以保留，因为应用时先删除后修改
+        for (const BasicOperation<TimeT>& op : later.upserts) {
+            const std::uint64_t packed = packKey(op);
+            auto it = upsertIndex.find(packed);
+            if (it != upsertIndex.end() && it->second != erased) {
+                into.upserts[it->second] = op;
+            }
+            else {
+                upsertIndex[packed] = into.upserts.size();
+                into.upserts.push_back(op);
+            }
+        }
+
+        // 压缩被撤销的修改
+        if (!later.removals.empty()) {
+            std::size_t write = 0;
+            for (std::size_t i = 0; i < into.upserts.size(); ++i) {
+                auto it = upsertIndex.find(packKey(into.upserts[i]));
+                if (it != upsertIndex.end() && it->second == i) {
+                    into.upserts[write++] = into.upserts[i];
+                }
+            }
+            into.upserts.resize(write);
+        }
+    }
+
+    /**
+     * @brief 把增量应用到完整的操作向量：先删除，再按键覆盖或追加；保留其余操作的相对顺序
+     *
+     * 只为增量的键建索引，扫描一遍操作向量完成删除与覆盖，增量远小于调度时不必为整个调度建索引。
+     * @return 实际被修改、追加或删除的操作数
+     */
+    template<typename TimeT>
+    std::size_t applyScheduleDelta(std::vector<BasicOperation<TimeT>>& operations, const BasicScheduleDelta<TimeT>& delta) {
+        if (delta.empty()) return 0;
+        std::size_t changed = 0;
+
+        std::unordered_map<std::uint64_t, bool, KeyHash> removed;
+        removed.reserve(delta.removals.size());
+        for (const OperationKey& key : delta.removals) {
+            removed.emplace(packKey(key), true);
+        }
+        // 键 -> 该键最后一个修改的下标（同键多次修改时最后一个生效）
+        std::unordered_map<std::uint64_t, std::size_t, KeyHash> upserted;
+        upserted.reserve(delta.upserts.size());
+        for (std::size_t i = 0; i < delta.upserts.size(); ++i) {
+            upserted[packKey(delta.upserts[i])] = i;
+        }
+        std::vector<char> placed(delta.upserts.size(), 0);
+
+        std::size_t write = 0;
+        for (std::size_t i = 0; i < operations.size(); ++i) {
+            const std::uint64_t key = packKey(operations[i]);
+            if (!removed.empty() && removed.count(key)) {
+                ++changed;
+                continue;
+            }
+            auto it = upserted.find(key);
+            if (it != upserted.end()) {
+                operations[write++] = delta.upserts[it->second];
+                placed[it->second] = 1;
+            }
+            else {
+                operations[write++] = operations[i];
+            }
+        }
+        operations.resize(write);
+
+        // 未覆盖任何操作的修改按出现顺序追加
+        for (std::size_t i = 0; i < delta.upserts.size(); ++i) {
+            auto it = upserted.find(packKey(delta.upserts[i]));
+            if (it->second == i && !placed[i]) {
+                operations.push_back(delta.upserts[i]);
+                placed[i] = 1;
+            }
+        }
+        return changed + delta.upserts.size();
+    }
+
+    /**
+     * @brief 带键索引的操作存储，增量应用的代价只与增量大小有关
+     *
+     * 删除时用最后一个元素填补空位，因此不保持插入顺序（绘制按机器行和开始时间重新排序）。
+     */
+    template<typename TimeT>
+    class BasicOperationStore {
+    public:
+        using Operation = BasicOperation<TimeT>;
+
+        /**
+         * @brief 替换全部内容；键重复时保留最后一个
+         */
+        void assign(std::vector<Operation>&& newOperations) {
+            operations.swap(newOperations);
+            std::vector<Operation>().swap(newOperations);
+            index.clear();
+            index.reserve(operations.size());
+            std::size_t write = 0;
+            for (std::size_t i = 0; i < operations.size(); ++i) {
+                auto inserted = index.emplace(packKey(operations[i]), write);
+                if (inserted.second) {
+                    operations[write++] = operations[i];
+                }
+                else {
+                    operations[inserted.first->second] = operations[i];
+                }
+            }
+            operations.resize(write);
+        }
+
+        /**
+         * @brief 应用增量（先删除后修改），O(增量大小)
+         * @return 实际被修改、追加或删除的操作数
+         */
+        std::size_t apply(const BasicScheduleDelta<TimeT>& delta) {
+            std::size_t changed = 0;
+            for (const OperationKey& key : delta.removals) {
+                auto it = index.find(packKey(key));
+                if (it == index.end()) continue;
+                const std::size_t position = it->second;
+                index.erase(it);
+                if (position + 1 != operations.size()) {
+                    operations[position] = operations.back();
+                    index[packKey(operations[position])] = position;
+                }
+                operations.pop_back();
+                ++changed;
+            }
+            for (const Operation& op : delta.upserts) {
+                auto inserted = index.emplace(packKey(op), operations.size());
+                if (inserted.second) {
+                    operations.push_back(op);
+                }
+                else {
+                    operations[inserted.first->second] = op;
+                }
+                ++changed;
+            }
+            return changed;
+        }
+
+        const std::vector<Operation>& data() const { return operations; }
+        std::size_t size() const { return operations.size(); }
+        bool empty() const { return operations.empty(); }
+        void clear() {
+            operations.clear();
+            index.clear();
+        }
+
+    private:
+        std::vector<Operation> operations;
+        std::unordered_map<std::uint64_t, std::size_t, KeyHash> index;  // 键 -> operations 下标
+    };
+
+    using ScheduleDelta = BasicScheduleDelta<int>;
+    using ScheduleDelta64 = BasicScheduleDelta<long long>;
+    using ScheduleDeltaF = BasicScheduleDelta<double>;
+    using OperationStore = BasicOperationStore<int>;
+    using OperationStore64 = BasicOperationStore<long long>;
+    using OperationStoreF = BasicOperationStore<double>;
+}
+
+#endif // SCHEDULE_DELTA_H
@@ -0,0 +1,249 @@
+#include "ScheduleDiff.h"
+#include "GanttConfig.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace {
+    const std::uint32_t NO_INDEX = qm::OperationChange::NO_INDEX;
+
+    // 在 threads 个线程上执行 fn(0..count-1)，任务动态分配
+    template<typename Fn>
+    void parallelFor(size_t count, int threads, Fn fn) {
+        threads = static_cast<int>(std::min<size_t>(static_cast<size_t>(std::max(1, threads)), count));
+        if (threads <= 1) {
+            for (size_t i = 0; i < count; ++i) fn(i);
+            return;
+        }
+
+        std::atomic<size_t> nextIndex{ 0 };
+        auto worker = [&]() {
+            for (size_t i = nextIndex.fetch_add(1); i < count; i = nextIndex.fetch_add(1)) {
+                fn(i);
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (int t = 1; t < threads; ++t) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    }
+
+    template<typename TimeT>
+    std::uint64_t keyAt(const qm::OperationView<TimeT>& view, size_t i) {
+        return qm::packKey(view.jobId[i], view.stage[i]);
+    }
+
+    template<typename TimeT>
+    std::uint8_t compareOperations(const qm::OperationView<TimeT>& before, size_t b,
+        const qm::OperationView<TimeT>& after, size_t a) {
+        std::uint8_t flags = 0;
+        if (before.machineId[b] != after.machineId[a]) flags |= qm::DiffMachine;
+        if (before.startTime[b] != after.startTime[a]) flags |= qm::DiffStart;
+        if (before.endTime[b] - before.startTime[b] != after.endTime[a] - after.startTime[a]) flags |= qm::DiffDuration;
+        if (before.critical[b] != after.critical[a]) flags |= qm::DiffCritical;
+        return flags;
+    }
+
+    void countChange(qm::ScheduleDiffCounts& counts, std::uint8_t flags) {
+        if (flags & qm::DiffAdded) { ++counts.added; return; }
+        if (flags & qm::DiffRemoved) { ++counts.removed; return; }
+        ++counts.changed;
+        if (flags & qm::DiffMachine) ++counts.moved;
+        if (flags & qm::DiffStart) ++counts.shifted;
+        if (flags & qm::DiffDuration) ++counts.resized;
+        if (flags & qm::DiffCritical) ++counts.criticalChanged;
+    }
+
+    // 一个分区的连接结果
+    struct PartitionResult {
+        std::vector<qm::OperationChange> changes;
+        qm::ScheduleDiffCounts counts;
+    };
+
+    /**
+     * @brief 对一个分区做哈希连接：用基准侧的下标建开放寻址表，再用新调度侧探测
+     *
+     * 分区号取哈希值对分区数的余数，表内槽位取商，避免同一分区的键集中在少数槽位。
+     * beforeLists/afterLists 为各扫描块落入本分区的下标，按块顺序拼接后即为下标升序。
+     */
+    template<typename TimeT>
+    void joinPartition(const qm::OperationView<TimeT>& before, const qm::OperationView<TimeT>& after,
+        const std::vector<const std::vector<std::uint32_t>*>& beforeLists,
+        const std::vector<const std::vector<std::uint32_t>*>& afterLists,
+        size_t partitionCount, std::vector<char>& matched, PartitionResult& result) {
+        const qm::KeyHash hash;
+
+        size_t beforeCount = 0;
+        for (const std::vector<std::uint32_t>* list : beforeLists) beforeCount += list->size();
+        size_t capacity = 16;
+        while (capacity < beforeCount * 2) capacity <<= 1;
+        const size_t mask = capacity - 1;
+        std::vector<std::uint64_t> slotKeys(capacity);
+        std::vector<std::uint32_t> slotIndex(capacity, NO_INDEX);
+
+        for (const std::vector<std::uint32_t>* list : beforeLists) {
+            for (std::uint32_t i : *list) {
+                const std::uint64_t key = keyAt(before, i);
+                size_t slot = (hash(key) / partitionCount) & mask;
+                while (slotIndex[slot] != NO_INDEX && slotKeys[slot] != key) {
+                    slot = (slot + 1) & mask;
+                }
+                if (slotIndex[slot] == NO_INDEX) {
+                    slotKeys[slot] = key;
+                    slotIndex[slot] = i;
+                }
+                else {
+                    matched[i] = 1;  // 键重复：只比较第一个，其余忽略
+                }
+            }
+        }
+
+        for (const std::vector<std::uint32_t>* list : afterLists) {
+            for (std::uint32_t a : *list) {
+                const std::uint64_t key = keyAt(after, a);
+                size_t slot = (hash(key) / partitionCount) & mask;
+                while (slotIndex[slot] != NO_INDEX && slotKeys[slot] != key) {
+                    slot = (slot + 1) & mask;
+                }
+                const std::uint32_t b = slotIndex[slot];
+                if (b == NO_INDEX) {
+                    result.changes.push_back({ NO_INDEX, a, qm::DiffAdded });
+                    ++result.counts.added;
+                    continue;
+                }
+                if (matched[b]) continue;  // 新调度中的重复键
+                matched[b] = 1;
+                const std::uint8_t flags = compareOperations(before, b, after, a);
+                if (flags == 0) {
+                    ++result.counts.unchanged;
+                }
+                else {
+                    result.changes.push_back({ b, a, flags });
+                    countChange(result.counts, flags);
+                }
+            }
+        }
+
+        for (const std::vector<std::uint32_t>* list : beforeLists) {
+            for (std::uint32_t i : *list) {
+                if (!matched[i]) {
+                    result.changes.push_back({ i, NO_INDEX, qm::DiffRemoved });
+                    ++result.counts.removed;
+                }
+            }
+        }
+    }
+
+    void addCounts(qm::ScheduleDiffCounts& into, const qm::ScheduleDiffCounts& counts) {
+        into.unchanged += counts.unchanged;
+        into.changed += counts.changed;
+        into.moved += counts.moved;
+        into.shifted += counts.shifted;
+        into.resized += counts.resized;
+        into.criticalChanged += counts.criticalChanged;
+        into.added += counts.added;
+        into.removed += counts.removed;
+    }
+}
+
+namespace qm {
+    template<typename TimeT>
+    void diffSchedules(const OperationView<TimeT>& before, const OperationView<TimeT>& after, ScheduleDiff& out,
+        int threadCount) {
+        out.clear();
+        out.beforeSize = before.size();
+        out.afterSize = after.size();
+
+        int threads = threadCount > 0 ? threadCount : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        if (before.size() + after.size() < static_cast<size_t>(GanttConfig::DiffConfig::PARALLEL_MIN_OPERATIONS)) {
+            threads = 1;
+        }
+        const size_t partitions = static_cast<size_t>(threads);
+        const KeyHash hash;
+
+        // 第一遍：各块把下标按键的哈希分散到分区
+        std::vector<std::vector<std::vector<std::uint32_t>>> beforeParts(partitions,
+            std::vector<std::vector<std::uint32_t>>(partitions));
+        std::vector<std::vector<std::vector<std::uint32_t>>> afterParts(partitions,
+            std::vector<std::vector<std::uint32_t>>(partitions));
+        parallelFor(partitions, threads, [&](size_t chunk) {
+            const size_t beforeBegin = before.size() * chunk / partitions;
+            const size_t beforeEnd = before.size() * (chunk + 1) / partitions;
+            const size_t afterBegin = after.size() * chunk / partitions;
+            const size_t afterEnd = after.size() * (chunk + 1) / partitions;
+            std::vector<std::vector<std::uint32_t>>& beforeOut = beforeParts[chunk];
+            std::vector<std::vector<std::uint32_t>>& afterOut = afterParts[chunk];
+            for (size_t p = 0; p < partitions; ++p) {
+                beforeOut[p].reserve((beforeEnd - beforeBegin) / partitions + 16);
+                afterOut[p].reserve((afterEnd - afterBegin) / partitions + 16);
+            }
+            for (size_t i = beforeBegin; i < beforeEnd; ++i) {
+                beforeOut[partitions == 1 ? 0 : hash(keyAt(before, i)) % partitions].push_back(static_cast<std::uint32_t>(i));
+            }
+            for (size_t i = afterBegin; i < afterEnd; ++i) {
+                afterOut[partitions == 1 ? 0 : hash(keyAt(after, i)) % partitions].push_back(static_cast<std::uint32_t>(i));
+            }
+        });
+
+        // 第二遍：各分区独立连接；matched 按基准下标写入，不同分区的下标互不相交
+        std::vector<char> matched(before.size(), 0);
+        std::vector<PartitionResult> results(partitions);
+        parallelFor(partitions, threads, [&](size_t p) {
+            std::vector<const std::vector<std::uint32_t>*> beforeLists, afterLists;
+            for (size_t chunk = 0; chunk < partitions; ++chunk) {
+                beforeLists.push_back(&beforeParts[chunk][p]);
+                afterLists.push_back(&afterParts[chunk][p]);
+            }
+            joinPartition(before, after, beforeLists, afterLists, partitions, matched, results[p]);
+        });
+
+        size_t total = 0;
+        for (const PartitionResult& result : results) total += result.changes.size();
+        out.changes.reserve(total);
+        for (const PartitionResult& result : results) {
+            out.changes.insert(out.changes.end(), result.changes.begin(), result.changes.end());
+            addCounts(out.counts, result.counts);
+        }
+
+        // 结果与线程数无关：按新调度下标排序，删除的按基准下标排在最后
+        const std::uint64_t afterCount = after.size();
+        auto order = [afterCount](const OperationChange& c) {
+            return c.after != NO_INDEX ? static_cast<std::uint64_t>(c.after) : afterCount + c.before;
+        };
+        std::sort(out.changes.begin(), out.changes.end(),
+            [&order](const OperationChange& a, const OperationChange& b) { return order(a) < order(b); });
+    }
+
+    template<typename TimeT>
+    void scheduleDiffToDelta(const ScheduleDiff& diff, const OperationView<TimeT>& before,
+        const OperationView<TimeT>& after, BasicScheduleDelta<TimeT>& delta) {
+        delta.clear();
+        delta.upserts.reserve(diff.counts.changed + diff.counts.added);
+        delta.removals.reserve(diff.counts.removed);
+        for (const OperationChange& change : diff.changes) {
+            if (change.flags & DiffRemoved) {
+                delta.removals.push_back({ before.jobId[change.before], before.stage[change.before] });
+            }
+            else {
+                delta.upserts.push_back(after[change.after]);
+            }
+        }
+    }
+
+    template void diffSchedules<int>(const OperationView<int>&, const OperationView<int>&, ScheduleDiff&, int);
+    template void diffSchedules<long long>(const OperationView<long long>&, const OperationView<long long>&,
+        ScheduleDiff&, int);
+    template void diffSchedules<double>(const OperationView<double>&, const OperationView<double>&, ScheduleDiff&, int);
+    template void scheduleDiffToDelta<int>(const ScheduleDiff&, const OperationView<int>&, const OperationView<int>&,
+        BasicScheduleDelta<int>&);
+    template void scheduleDiffToDelta<long long>(const ScheduleDiff&, const OperationView<long long>&,
+        const OperationView<long long>&, BasicScheduleDelta<long long>&);
+    template void scheduleDiffToDelta<double>(const ScheduleDiff&, const OperationView<double>&,
+        const OperationView<double>&, BasicScheduleDelta<double>&);
+}
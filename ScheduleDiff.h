@@ -0,0 +1,89 @@
+//
+// 两个调度的差异：按 (job_id, stage) 哈希连接，记录换机器、时间平移、时长与关键标记的变化
+// 结果只保存有变化的操作下标，可以转换为增量送入以键为基础的更新路径
+//
+#ifndef SCHEDULE_DIFF_H
+#define SCHEDULE_DIFF_H
+
+#include "OperationView.h"
+#include "ScheduleDelta.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace qm {
+    enum ScheduleDiffFlags : std::uint8_t {
+        DiffMachine = 1 << 0,    // 换了机器
+        DiffStart = 1 << 1,      // 开始时间平移
+        DiffDuration = 1 << 2,   // 时长变化
+        DiffCritical = 1 << 3,   // 关键标记变化
+        DiffAdded = 1 << 4,      // 只在新调度中
+        DiffRemoved = 1 << 5     // 只在基准调度中
+    };
+
+    // 一个有变化的操作（12字节）；before/after 为两侧视图中的下标，不存在时为 NO_INDEX
+    struct OperationChange {
+        static const std::uint32_t NO_INDEX = 0xFFFFFFFFu;
+
+        std::uint32_t before;
+        std::uint32_t after;
+        std::uint8_t flags;
+    };
+
+    // 各类变化的计数（一个操作可能同时计入多类）
+    struct ScheduleDiffCounts {
+        size_t unchanged = 0;
+        size_t changed = 0;          // 两侧都存在且有变化
+        size_t moved = 0;
+        size_t shifted = 0;
+        size_t resized = 0;
+        size_t criticalChanged = 0;
+        size_t added = 0;
+        size_t removed = 0;
+    };
+
+    struct ScheduleDiff {
+        std::vector<OperationChange> changes;  // 按新调度下标排序，删除的操作按基准下标排在最后
+        ScheduleDiffCounts counts;
+        size_t beforeSize = 0;
+        size_t afterSize = 0;
+
+        bool empty() const { return changes.empty(); }
+        void clear() {
+            changes.clear();
+            counts = ScheduleDiffCounts();
+            beforeSize = afterSize = 0;
+        }
+    };
+
+    /**
+     * @brief 比较两个调度，线性时间
+     *
+     * 操作数较多时按键的哈希分区，各线程独立建表并探测自己的分区。
+     * 同一侧键重复时只比较第一个，其余忽略（与以键为基础的增量一致）。
+     * @param threadCount 线程数，0 表示使用硬件线程数；操作数低于 PARALLEL_MIN_OPERATIONS 时单线程
+     */
+    template<typename TimeT>
+    void diffSchedules(const OperationView<TimeT>& before, const OperationView<TimeT>& after, ScheduleDiff& out,
+        int threadCount = 0);
+
+    /**
+     * @brief 由差异生成把基准变为新调度的增量（新增与有变化的操作为 upserts，删除的为 removals）
+     */
+    template<typename TimeT>
+    void scheduleDiffToDelta(const ScheduleDiff& diff, const OperationView<TimeT>& before,
+        const OperationView<TimeT>& after, BasicScheduleDelta<TimeT>& delta);
+
+    extern template void diffSchedules<int>(const OperationView<int>&, const OperationView<int>&, ScheduleDiff&, int);
+    extern template void diffSchedules<long long>(const OperationView<long long>&, const OperationView<long long>&,
+        ScheduleDiff&, int);
+    extern template void diffSchedules<double>(const OperationView<double>&, const OperationView<double>&, ScheduleDiff&, int);
+    extern template void scheduleDiffToDelta<int>(const ScheduleDiff&, const OperationView<int>&, const OperationView<int>&,
+        BasicScheduleDelta<int>&);
+    extern template void scheduleDiffToDelta<long long>(const ScheduleDiff&, const OperationView<long long>&,
+        const OperationView<long long>&, BasicScheduleDelta<long long>&);
+    extern template void scheduleDiffToDelta<double>(const ScheduleDiff&, const OperationView<double>&,
+        const OperationView<double>&, BasicScheduleDelta<double>&);
+}
+
+#endif // SCHEDULE_DIFF_H
@@ -0,0 +1,268 @@
+//
+// 本机套接字上的调度帧格式与发送端（仅头文件，不依赖 SFML）
+// 每帧是固定的帧头加列式负载：完整调度或以 (job_id, stage) 为键的增量。
+// 发送端与查看器位于同一台主机，因此数值按本机字节序写入，由帧头中的魔数检查。
+//
+#ifndef SCHEDULE_FRAMES_H
+#define SCHEDULE_FRAMES_H
+
+#include "ScheduleDelta.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#define GANTT_HAS_UNIX_SOCKETS 1
+#else
+#define GANTT_HAS_UNIX_SOCKETS 0
+#endif
+
+namespace qm {
+namespace frames {
+    const std::uint32_t MAGIC = 0x47534652;  // "GSFR"
+    const std::uint8_t VERSION = 1;
+
+    enum FrameType : std::uint8_t {
+        FullFrame = 1,   // 完整调度，替换该客户端之前的所有数据
+        DeltaFrame = 2   // 增量：先删除 removals，再按键覆盖或追加 upserts
+    };
+
+    // 帧头（24字节），其后依次为：
+    //   upserts 列：job_id[n] stage[n] machine_id[n] start_time[n] end_time[n] is_critical[n]（int32 / TimeT / uint8）
+    //   removals 列：job_id[m] stage[m]（int32）
+    struct FrameHeader {
+        std::uint32_t magic;
+        std::uint8_t version;
+        std::uint8_t type;
+        std::uint8_t timeSize;       // sizeof(TimeT)
+        std::uint8_t timeIsFloat;
+        std::uint32_t upsertCount;
+        std::uint32_t removalCount;
+        std::uint64_t payloadBytes;
+    };
+    static_assert(sizeof(FrameHeader) == 24, "frame header must be packed");
+
+    inline std::uint64_t payloadSize(std::uint64_t upserts, std::uint64_t removals, std::size_t timeSize) {
+        return upserts * (3 * sizeof(std::int32_t) + 2 * timeSize + 1) + removals * 2 * sizeof(std::int32_t);
+    }
+
+    /**
+     * @brief 检查帧头是否合法并与 TimeT 一致
+     */
+    template<typename TimeT>
+    bool headerMatches(const FrameHeader& header) {
+        return header.magic == MAGIC && header.version == VERSION &&
+            (header.type == FullFrame || header.type == DeltaFrame) &&
+            header.timeSize == sizeof(TimeT) && (header.timeIsFloat != 0) == std::is_floating_point<TimeT>::value &&
+            (header.type == DeltaFrame || header.removalCount == 0) &&
+            header.payloadBytes == payloadSize(header.upsertCount, header.removalCount, sizeof(TimeT));
+    }
+
+    namespace detail {
+        template<typename T, typename Getter>
+        char* writeColumn(char* out, std::size_t count, Getter get) {
+            for (std::size_t i = 0; i < count; ++i) {
+                const T value = get(i);
+                std::memcpy(out, &value, sizeof(T));
+                out += sizeof(T);
+            }
+            return out;
+        }
+
+        template<typename T>
+        const char* readColumn(const char* in, std::size_t count, T* first, std::size_t stride) {
+            char* out = reinterpret_cast<char*>(first);
+            for (std::size_t i = 0; i < count; ++i) {
+                std::memcpy(out + i * stride, in + i * sizeof(T), sizeof(T));
+            }
+            return in + count * sizeof(T);
+        }
+    }
+
+    /**
+     * @brief 把操作与删除键编码为一帧，写入 out（覆盖原内容）
+     */
+    template<typename TimeT>
+    void encodeFrame(FrameType type, const BasicOperation<TimeT>* upserts, std::size_t upsertCount,
+        const OperationKey* removals, std::size_t removalCount, std::vector<char>& out) {
+        FrameHeader header;
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.type = type;
+        header.timeSize = static_cast<std::uint8_t>(sizeof(TimeT));
+        header.timeIsFloat = std::is_floating_point<TimeT>::value ? 1 : 0;
+        header.upsertCount = static_cast<std::uint32_t>(upsertCount);
+        header.removalCount = static_cast<std::uint32_t>(removalCount);
+        header.payloadBytes = payloadSize(upsertCount, removalCount, sizeof(TimeT));
+
+        out.resize(sizeof(FrameHeader) + static_cast<std::size_t>(header.payloadBytes));
+        std::memcpy(out.data(), &header, sizeof(header));
+        char* p = out.data() + sizeof(header);
+        p = detail::writeColumn<std::int32_t>(p, upsertCount, [&](std::size_t i) { return upserts[i].job_id; });
+        p = detail::writeColumn<std::int32_t>(p, upsertCount, [&](std::size_t i) { return upserts[i].stage; });
+        p = detail::writeColumn<std::int32_t>(p, upsertCount, [&](std::size_t i) { return upserts[i].machine_id; });
+        p = detail::writeColumn<TimeT>(p, upsertCount, [&](std::size_t i) { return upserts[i].start_time; });
+        p = detail::writeColumn<TimeT>(p, upsertCount, [&](std::size_t i) { return upserts[i].end_time; });
+        p = detail::writeColumn<std::uint8_t>(p, upsertCount, [&](std::size_t i) {
+            return static_cast<std::uint8_t>(upserts[i].is_critical ? 1 : 0); });
+        p = detail::writeColumn<std::int32_t>(p, removalCount, [&](std::size_t i) { return removals[i].job_id; });
+        detail::writeColumn<std::int32_t>(p, removalCount, [&](std::size_t i) { return removals[i].stage; });
+    }
+
+    template<typename TimeT>
+    void encodeFullFrame(const std::vector<BasicOperation<TimeT>>& operations, std::vector<char>& out) {
+        encodeFrame<TimeT>(FullFrame, operations.data(), operations.size(), nullptr, 0, out);
+    }
+
+    template<typename TimeT>
+    void encodeDeltaFrame(const BasicScheduleDelta<TimeT>& delta, std::vector<char>& out) {
+        encodeFrame<TimeT>(DeltaFrame, delta.upserts.data(), delta.upserts.size(),
+            delta.removals.data(), delta.removals.size(), out);
+    }
+
+    /**
+     * @brief 解码负载（帧头已由 headerMatches 检查）；完整帧只填充 upserts
+     */
+    template<typename TimeT>
+    void decodePayload(const FrameHeader& header, const char* payload, BasicScheduleDelta<TimeT>& out) {
+        using Operation = BasicOperation<TimeT>;
+        const std::size_t n = header.upsertCount;
+        const std::size_t m = header.removalCount;
+        out.upserts.resize(n);
+        out.removals.resize(m);
+
+        const char* p = payload;
+        Operation* ops = out.upserts.data();
+        p = detail::readColumn(p, n, &ops->job_id, sizeof(Operation));
+        p = detail::readColumn(p, n, &ops->stage, sizeof(Operation));
+        p = detail::readColumn(p, n, &ops->machine_id, sizeof(Operation));
+        p = detail::readColumn(p, n, &ops->start_time, sizeof(Operation));
+        p = detail::readColumn(p, n, &ops->end_time, sizeof(Operation));
+        for (std::size_t i = 0; i < n; ++i) {
+            ops[i].is_critical = p[i] != 0;
+        }
+        p += n;
+        OperationKey* keys = out.removals.data();
+        p = detail::readColumn(p, m, &keys->job_id, sizeof(OperationKey));
+        detail::readColumn(p, m, &keys->stage, sizeof(OperationKey));
+    }
+}
+
+/**
+ * @brief 帧发送端（求解器或替身生产者使用）
+ *
+ * 使用阻塞写：查看器暂停读取时内核缓冲区写满，发送调用随之阻塞，这就是反压。
+ */
+template<typename TimeT>
+class BasicScheduleFrameClient {
+public:
+    using Operation = BasicOperation<TimeT>;
+    using Delta = BasicScheduleDelta<TimeT>;
+
+    BasicScheduleFrameClient() = default;
+    ~BasicScheduleFrameClient() { close(); }
+    BasicScheduleFrameClient(const BasicScheduleFrameClient&) = delete;
+    BasicScheduleFrameClient& operator=(const BasicScheduleFrameClient&) = delete;
+
+    /**
+     * @brief 连接查看器监听的套接字路径
+     */
+    bool connect(const std::string& path) {
+        close();
+#if GANTT_HAS_UNIX_SOCKETS
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        if (path.size() >= sizeof(address.sun_path)) return false;
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, path.c_str(), path.size());
+
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return false;
+#ifdef SO_NOSIGPIPE
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+        if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            close();
+            return false;
+        }
+        return true;
+#else
+        (void)path;
+        return false;
+#endif
+    }
+
+    void close() {
+#if GANTT_HAS_UNIX_SOCKETS
+        if (fd >= 0) {
+            ::close(fd);
+        }
+#endif
+        fd = -1;
+    }
+
+    bool isConnected() const { return fd >= 0; }
+
+    bool sendFull(const std::vector<Operation>& operations) {
+        frames::encodeFullFrame(operations, buffer);
+        return sendBuffer();
+    }
+
+    bool sendDelta(const Delta& delta) {
+        frames::encodeDeltaFrame(delta, buffer);
+        return sendBuffer();
+    }
+
+    // 已发送的帧与字节数
+    std::uint64_t getFramesSent() const { return framesSent; }
+    std::uint64_t getBytesSent() const { return bytesSent; }
+
+private:
+    bool sendBuffer() {
+#if GANTT_HAS_UNIX_SOCKETS
+        if (fd < 0) return false;
+#ifdef MSG_NOSIGNAL
+        const int flags = MSG_NOSIGNAL;
+#else
+        const int flags = 0;
+#endif
+        const char* p = buffer.data();
+        std::size_t remaining = buffer.size();
+        while (remaining > 0) {
+            const ssize_t written = ::send(fd, p, remaining, flags);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                close();
+                return false;
+            }
+            p += written;
+            remaining -= static_cast<std::size_t>(written);
+        }
+        ++framesSent;
+        bytesSent += buffer.size();
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    int fd = -1;
+    std::vector<char> buffer;  // 编码缓冲区，跨帧复用
+    std::uint64_t framesSent = 0;
+    std::uint64_t bytesSent = 0;
+};
+
+using ScheduleFrameClient = BasicScheduleFrameClient<int>;
+using ScheduleFrameClient64 = BasicScheduleFrameClient<long long>;
+using ScheduleFrameClientF = BasicScheduleFrameClient<double>;
+}
+
+#endif // SCHEDULE_FRAMES_H
@@ -0,0 +1,296 @@
+#include "ScheduleGenerator.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <thread>
+
+namespace {
+    // 每个块的作业数固定，块的随机流只由种子和块号决定，因此结果与线程数无关
+    const int JOBS_PER_CHUNK = 4096;
+
+    // 随机流编号
+    const std::uint64_t STREAM_MACHINES = 0;
+    const std::uint64_t STREAM_STAGE_COUNTS = 1;
+    const std::uint64_t STREAM_OPERATIONS = 2;
+
+    std::uint64_t splitMix64(std::uint64_t& state) {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // xoshiro256**
+    class Rng {
+    public:
+        Rng(std::uint64_t seed, std::uint64_t chunk, std::uint64_t stream) {
+            std::uint64_t state = seed ^ (chunk * 0xD1B54A32D192ED03ULL) ^ (stream * 0xABC98388FB8FAC03ULL);
+            for (auto& word : s) {
+                word = splitMix64(state);
+            }
+        }
+
+        std::uint64_t next() {
+            const std::uint64_t result = rotl(s[1] * 5, 7) * 9;
+            const std::uint64_t t = s[1] << 17;
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = rotl(s[3], 45);
+            return result;
+        }
+
+        // [0, range)，乘法取高位，避免取模
+        std::uint32_t bounded(std::uint32_t range) {
+            return static_cast<std::uint32_t>(((next() >> 32) * range) >> 32);
+        }
+
+        // [lo, hi]
+        int between(int lo, int hi) {
+            return hi <= lo ? lo : lo + static_cast<int>(bounded(static_cast<std::uint32_t>(hi - lo) + 1));
+        }
+
+        bool chance(double probability) {
+            return (next() >> 11) * (1.0 / 9007199254740992.0) < probability;
+        }
+
+    private:
+        std::uint64_t s[4];
+
+        static std::uint64_t rotl(std::uint64_t x, int k) {
+            return (x << k) | (x >> (64 - k));
+        }
+    };
+
+    // Vose 别名表，O(1) 按权重抽取机器
+    class AliasTable {
+    public:
+        explicit AliasTable(const std::vector<double>& weights) {
+            const size_t n = weights.size();
+            threshold.assign(n, UINT32_MAX);
+            alias.resize(n);
+            for (size_t i = 0; i < n; ++i) alias[i] = static_cast<std::uint32_t>(i);
+
+            double total = 0.0;
+            for (double w : weights) total += w;
+
+            std::vector<double> scaled(n);
+            std::vector<std::uint32_t> small, large;
+            for (size_t i = 0; i < n; ++i) {
+                scaled[i] = weights[i] * n / total;
+                (scaled[i] < 1.0 ? small : large).push_back(static_cast<std::uint32_t>(i));
+            }
+
+            while (!small.empty() && !large.empty()) {
+                std::uint32_t s = small.back(); small.pop_back();
+                std::uint32_t l = large.back(); large.pop_back();
+                threshold[s] = static_cast<std::uint32_t>(scaled[s] * 4294967295.0);
+                alias[s] = l;
+                scaled[l] -= 1.0 - scaled[s];
+                (scaled[l] < 1.0 ? small : large).push_back(l);
+            }
+        }
+
+        std::uint32_t sample(Rng& rng) const {
+            std::uint64_t r = rng.next();
+            std::uint32_t column = static_cast<std::uint32_t>(((r >> 32) * alias.size()) >> 32);
+            return static_cast<std::uint32_t>(r) < threshold[column] ? column : alias[column];
+        }
+
+    private:
+        std::vector<std::uint32_t> threshold;
+        std::vector<std::uint32_t> alias;
+    };
+
+    // 在 threads 个线程上执行 fn(0..count-1)，任务动态分配
+    template<typename Fn>
+    void parallelFor(size_t count, int threads, Fn fn) {
+        threads = static_cast<int>(std::min<size_t>(static_cast<size_t>(std::max(1, threads)), count));
+        if (threads <= 1) {
+            for (size_t i = 0; i < count; ++i) fn(i);
+            return;
+        }
+
+        std::atomic<size_t> nextIndex{ 0 };
+        auto worker = [&]() {
+            for (size_t i = nextIndex.fetch_add(1); i < count; i = nextIndex.fetch_add(1)) {
+                fn(i);
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (int t = 1; t < threads; ++t) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    }
+
+    int clampTime(long long value) {
+        return static_cast<int>(std::min<long long>(std::max<long long>(value, 0), INT_MAX));
+    }
+}
+
+void generateSchedule(const ScheduleGenConfig& config, std::vector<qm::Operation>& operations) {
+    operations.clear();
+
+    const int jobCount = std::max(0, config.jobCount);
+    const int machineCount = std::max(1, config.machineCount);
+    const int minStages = std::max(1, config.minStages);
+    const int maxStages = std::max(minStages, config.maxStages);
+    const int threads = config.threadCount > 0 ? config.threadCount
+        : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    if (jobCount == 0) return;
+
+    // === 机器：稀疏ID与倾斜的负载权重 ===
+    Rng machineRng(config.seed, 0, STREAM_MACHINES);
+    std::vector<int> machineIds(machineCount);
+    const int gap = std::max(1, config.machineIdGap);
+    int id = gap > 1 ? static_cast<int>(machineRng.bounded(gap)) : 0;
+    for (int m = 0; m < machineCount; ++m) {
+        machineIds[m] = id;
+        id += gap > 1 ? 1 + static_cast<int>(machineRng.bounded(gap)) : 1;
+    }
+
+    // 热度排名随机打乱，使热门机器不总是前几行
+    std::vector<int> rank(machineCount);
+    for (int m = 0; m < machineCount; ++m) rank[m] = m;
+    for (int m = machineCount - 1; m > 0; --m) {
+        std::swap(rank[m], rank[machineRng.bounded(static_cast<std::uint32_t>(m) + 1)]);
+    }
+    std::vector<double> weights(machineCount);
+    double weightSum = 0.0, maxWeight = 0.0;
+    for (int m = 0; m < machineCount; ++m) {
+        weights[m] = 1.0 / std::pow(rank[m] + 1.0, std::max(0.0, config.machineSkew));
+        weightSum += weights[m];
+        maxWeight = std::max(maxWeight, weights[m]);
+    }
+    const AliasTable machinePicker(weights);
+
+    // 作业到达间隔：使最繁忙的机器达到目标利用率
+    const double meanShort = (config.shortMinDuration + config.shortMaxDuration) / 2.0;
+    const double meanLong = (config.longMinDuration + config.longMaxDuration) / 2.0;
+    const double meanDuration = (1.0 - config.longRatio) * meanShort + config.longRatio * meanLong;
+    const double meanStages = (minStages + maxStages) / 2.0;
+    const double load = config.loadFactor > 0.0 ? config.loadFactor : 1.0;
+    const double interarrival = std::max(1e-3, meanDuration * meanStages * (maxWeight / weightSum) / load);
+
+    // === 第一阶段：各块的工序数 ===
+    const size_t chunkCount = (static_cast<size_t>(jobCount) + JOBS_PER_CHUNK - 1) / JOBS_PER_CHUNK;
+    std::vector<size_t> chunkOffsets(chunkCount + 1, 0);
+    parallelFor(chunkCount, threads, [&](size_t chunk) {
+        Rng countRng(config.seed, chunk, STREAM_STAGE_COUNTS);
+        const int firstJob = static_cast<int>(chunk * JOBS_PER_CHUNK);
+        const int lastJob = std::min(jobCount, firstJob + JOBS_PER_CHUNK);
+        size_t total = 0;
+        for (int job = firstJob; job < lastJob; ++job) {
+            total += countRng.between(minStages, maxStages);
+        }
+        chunkOffsets[chunk + 1] = total;
+    });
+    for (size_t c = 0; c < chunkCount; ++c) {
+        chunkOffsets[c + 1] += chunkOffsets[c];
+    }
+
+    const size_t total = chunkOffsets[chunkCount];
+    operations.resize(total);
+    std::vector<std::uint32_t> machineOf(total);
+    std::vector<unsigned char> forceOverlap(total);
+
+    // === 第二阶段：生成工序，start_time 暂存期望开始时间 ===
+    parallelFor(chunkCount, threads, [&](size_t chunk) {
+        Rng countRng(config.seed, chunk, STREAM_STAGE_COUNTS);
+        Rng rng(config.seed, chunk, STREAM_OPERATIONS);
+        const int firstJob = static_cast<int>(chunk * JOBS_PER_CHUNK);
+        const int lastJob = std::min(jobCount, firstJob + JOBS_PER_CHUNK);
+        size_t index = chunkOffsets[chunk];
+
+        for (int job = firstJob; job < lastJob; ++job) {
+            const int stages = countRng.between(minStages, maxStages);
+            long long t = static_cast<long long>(job * interarrival)
+                + rng.bounded(static_cast<std::uint32_t>(interarrival) + 1);
+
+            for (int stage = 0; stage < stages; ++stage, ++index) {
+                const bool isLong = rng.chance(config.longRatio);
+                const int duration = std::max(1, isLong
+                    ? rng.between(config.longMinDuration, config.longMaxDuration)
+                    : rng.between(config.shortMinDuration, config.shortMaxDuration));
+                const std::uint32_t machine = machinePicker.sample(rng);
+
+                qm::Operation& op = operations[index];
+                op.job_id = job;
+                op.stage = stage;
+                op.machine_id = machineIds[machine];
+                op.start_time = clampTime(t);
+                op.end_time = clampTime(t + duration);
+                op.is_critical = rng.chance(config.criticalRatio);
+                machineOf[index] = machine;
+                forceOverlap[index] = rng.chance(config.overlapRatio) ? 1 : 0;
+
+                t += duration + rng.bounded(5);
+            }
+        }
+    });
+
+    // === 第三阶段：按机器排队，消除重叠 ===
+    std::vector<size_t> machineOffsets(machineCount + 1, 0);
+    for (size_t i = 0; i < total; ++i) {
+        machineOffsets[machineOf[i] + 1]++;
+    }
+    for (int m = 0; m < machineCount; ++m) {
+        machineOffsets[m + 1] += machineOffsets[m];
+    }
+
+    // 键 = (期望开始时间 << 32) | 工序下标，排序后同时间按生成顺序排列
+    std::vector<std::uint64_t> keys(total);
+    {
+        std::vector<size_t> cursor(machineOffsets.begin(), machineOffsets.end() - 1);
+        for (size_t i = 0; i < total; ++i) {
+            keys[cursor[machineOf[i]]++] = (static_cast<std::uint64_t>(operations[i].start_time) << 32) | i;
+        }
+    }
+    machineOf.clear();
+    machineOf.shrink_to_fit();
+
+    parallelFor(static_cast<size_t>(machineCount), threads, [&](size_t m) {
+        std::uint64_t* begin = keys.data() + machineOffsets[m];
+        std::uint64_t* end = keys.data() + machineOffsets[m + 1];
+        std::sort(begin, end);
+
+        long long machineFree = 0;
+        long long prevStart = 0, prevEnd = 0;
+        bool hasPrev = false;
+        for (std::uint64_t* key = begin; key != end; ++key) {
+            qm::Operation& op = operations[static_cast<std::uint32_t>(*key)];
+            const long long duration = static_cast<long long>(op.end_time) - op.start_time;
+            long long start = op.start_time;
+
+            if (hasPrev && forceOverlap[static_cast<std::uint32_t>(*key)]) {
+                // 落在前一工序内部
+                start = std::max(prevStart, prevEnd - std::max<long long>(1, duration / 2));
+            }
+            else {
+                start = std::max(start, machineFree);
+            }
+
+            op.start_time = clampTime(start);
+            op.end_time = clampTime(start + duration);
+            machineFree = std::max(machineFree, start + duration);
+            prevStart = start;
+            prevEnd = start + duration;
+            hasPrev = true;
+        }
+    });
+}
+
+std::vector<qm::Operation> generateSchedule(const ScheduleGenConfig& config) {
+    std::vector<qm::Operation> operations;
+    generateSchedule(config, operations);
+    return operations;
+}
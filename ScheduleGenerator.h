@@ -0,0 +1,53 @@
+//
+// 可复现的并行合成调度数据生成器
+// 相同的配置与种子在任意线程数下生成完全相同的数据，用于基准测试和长时间压力测试
+//
+#ifndef SCHEDULE_GENERATOR_H
+#define SCHEDULE_GENERATOR_H
+
+#include "data.h"
+#include <cstdint>
+#include <vector>
+
+// 生成参数
+struct ScheduleGenConfig {
+    int jobCount = 1000;
+    int minStages = 3;               // 每个作业的阶段数范围（均匀分布）
+    int maxStages = 8;
+    int machineCount = 20;
+
+    // 机器负载倾斜：第 k 热的机器权重为 1/(k+1)^machineSkew，0 表示均匀
+    double machineSkew = 0.8;
+    // 机器ID之间的最大间隔，1 表示连续ID，大于1时产生稀疏ID
+    int machineIdGap = 1;
+
+    // 工序时长：以 longRatio 的概率为长工序
+    int shortMinDuration = 5;
+    int shortMaxDuration = 50;
+    int longMinDuration = 200;
+    int longMaxDuration = 2000;
+    double longRatio = 0.05;
+
+    double overlapRatio = 0.0;       // 故意与同机器前一工序重叠的比例（用于测试重叠检测）
+    double criticalRatio = 0.25;     // 关键工序比例
+    double loadFactor = 0.85;        // 目标平均机器利用率，决定作业到达间隔
+
+    std::uint64_t seed = 12345;
+    int threadCount = 0;             // 0 表示使用硬件线程数，不影响生成结果
+};
+
+/**
+ * @brief 生成合成调度数据
+ *
+ * 第一阶段按固定大小的作业块并行生成（每块独立的随机流），
+ * 第二阶段按机器并行排布时间，保证同一机器上不重叠（overlapRatio 指定的工序除外）。
+ * 作业内阶段按期望开始时间排列，排队延迟可能使后续阶段早于前一阶段结束。
+ *
+ * @param config 生成参数
+ * @param operations 输出，按作业、阶段顺序排列（复用已有容量）
+ */
+void generateSchedule(const ScheduleGenConfig& config, std::vector<qm::Operation>& operations);
+
+std::vector<qm::Operation> generateSchedule(const ScheduleGenConfig& config);
+
+#endif // SCHEDULE_GENERATOR_H
@@ -0,0 +1,912 @@
+#include "ScheduleHistory.h"
+#include "GanttConfig.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace {
+    const std::uint32_t FILE_MAGIC = 0x4C485347;     // "GSHL"
+    const std::uint8_t FILE_VERSION = 1;
+    const std::uint32_t TRAILER_MAGIC = 0x58485347;  // "GSHX"
+
+    enum RecordType : std::uint8_t {
+        KeyframeRecord = 1,
+        DeltaRecord = 2,
+        IndexRecord = 3
+    };
+
+    // 文件头（8字节），其后是记录序列：[u32 记录体长度][记录体]
+    struct FileHeader {
+        std::uint32_t magic;
+        std::uint8_t version;
+        std::uint8_t timeSize;
+        std::uint8_t timeIsFloat;
+        std::uint8_t reserved;
+    };
+
+    // 正常关闭时写在文件末尾，指向索引记录
+    struct FileTrailer {
+        std::uint64_t indexOffset;
+        std::uint32_t magic;
+        std::uint32_t entryCount;
+    };
+
+    static_assert(sizeof(FileHeader) == 8 && sizeof(FileTrailer) == 16, "history file structs must be packed");
+
+    // 记录体开头最多占用的字节数：类型 + 迭代号 + 时间戳
+    const size_t RECORD_PREFIX_MAX = 1 + 10 + 10;
+
+    void putVarint(std::vector<char>& out, std::uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    // zigzag 编码，小的负数同样占用少量字节
+    void putSigned(std::vector<char>& out, std::int64_t value) {
+        putVarint(out, (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+    }
+
+    // 带边界检查的读取，越界后所有读取返回0并置失败标志
+    class ByteReader {
+    public:
+        ByteReader(const char* data, size_t size) : p(reinterpret_cast<const unsigned char*>(data)), end(p + size) {}
+
+        std::uint64_t varint() {
+            std::uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                if (p == end) { ok = false; return 0; }
+                const unsigned char byte = *p++;
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return value;
+            }
+            ok = false;
+            return 0;
+        }
+
+        std::int64_t signedVarint() {
+            const std::uint64_t value = varint();
+            return static_cast<std::int64_t>((value >> 1) ^ (~(value & 1) + 1));
+        }
+
+        std::uint8_t byte() {
+            if (p == end) { ok = false; return 0; }
+            return *p++;
+        }
+
+        void raw(void* out, size_t size) {
+            if (static_cast<size_t>(end - p) < size) { ok = false; std::memset(out, 0, size); return; }
+            std::memcpy(out, p, size);
+            p += size;
+        }
+
+        const unsigned char* take(size_t size) {
+            if (static_cast<size_t>(end - p) < size) { ok = false; return nullptr; }
+            const unsigned char* start = p;
+            p += size;
+            return start;
+        }
+
+        size_t remaining() const { return static_cast<size_t>(end - p); }
+        bool good() const { return ok; }
+
+    private:
+        const unsigned char* p;
+        const unsigned char* end;
+        bool ok = true;
+    };
+
+    // 时间值：整数类型写与前值之差（按无符号回绕计算，long long 不会溢出），浮点类型原样写入
+    template<typename TimeT>
+    void putTime(std::vector<char>& out, TimeT value, TimeT previous, std::false_type) {
+        putSigned(out, static_cast<std::int64_t>(static_cast<std::uint64_t>(static_cast<std::int64_t>(value)) -
+            static_cast<std::uint64_t>(static_cast<std::int64_t>(previous))));
+    }
+
+    template<typename TimeT>
+    void putTime(std::vector<char>& out, TimeT value, TimeT, std::true_type) {
+        char bytes[sizeof(TimeT)];
+        std::memcpy(bytes, &value, sizeof(TimeT));
+        out.insert(out.end(), bytes, bytes + sizeof(TimeT));
+    }
+
+    template<typename TimeT>
+    TimeT getTime(ByteReader& in, TimeT previous, std::false_type) {
+        return static_cast<TimeT>(static_cast<std::int64_t>(static_cast<std::uint64_t>(static_cast<std::int64_t>(previous)) +
+            static_cast<std::uint64_t>(in.signedVarint())));
+    }
+
+    template<typename TimeT>
+    TimeT getTime(ByteReader& in, TimeT, std::true_type) {
+        TimeT value;
+        in.raw(&value, sizeof(TimeT));
+        return value;
+    }
+
+    template<typename TimeT>
+    bool keyLess(const qm::BasicOperation<TimeT>& a, const qm::BasicOperation<TimeT>& b) {
+        return a.job_id != b.job_id ? a.job_id < b.job_id : a.stage < b.stage;
+    }
+
+    template<typename TimeT>
+    bool sameOperation(const qm::BasicOperation<TimeT>& a, const qm::BasicOperation<TimeT>& b) {
+        return a.machine_id == b.machine_id && a.start_time == b.start_time && a.end_time == b.end_time &&
+            a.is_critical == b.is_critical;
+    }
+
+    // 按键排序的操作列表：作业号、机器号、开始时间写与前一项之差；同一作业内阶段号写与前一阶段之差；
+    // 结束时间写为时长；关键标志单独打包为位图
+    template<typename TimeT>
+    void encodeOperations(std::vector<char>& out, const qm::BasicOperation<TimeT>* ops, size_t count) {
+        using IsFloat = typename std::is_floating_point<TimeT>::type;
+        putVarint(out, count);
+        long long prevJob = 0, prevStage = 0, prevMachine = 0;
+        TimeT prevStart = TimeT();
+        for (size_t i = 0; i < count; ++i) {
+            const qm::BasicOperation<TimeT>& op = ops[i];
+            putSigned(out, op.job_id - prevJob);
+            putSigned(out, op.stage - (op.job_id == prevJob ? prevStage : 0));
+            putSigned(out, op.machine_id - prevMachine);
+            putTime(out, op.start_time, prevStart, IsFloat());
+            putTime(out, op.end_time, op.start_time, IsFloat());
+            prevJob = op.job_id;
+            prevStage = op.stage;
+            prevMachine = op.machine_id;
+            prevStart = op.start_time;
+        }
+        for (size_t i = 0; i < count; i += 8) {
+            unsigned char bits = 0;
+            for (size_t b = 0; b < 8 && i + b < count; ++b) {
+                if (ops[i + b].is_critical) bits |= static_cast<unsigned char>(1u << b);
+            }
+            out.push_back(static_cast<char>(bits));
+        }
+    }
+
+    template<typename TimeT>
+    bool decodeOperations(ByteReader& in, std::vector<qm::BasicOperation<TimeT>>& out) {
+        using IsFloat = typename std::is_floating_point<TimeT>::type;
+        const std::uint64_t count = in.varint();
+        // 每个操作至少占用5字节，超出剩余长度说明数据损坏
+        if (!in.good() || count > in.remaining() / 5 + 1) return false;
+        out.resize(static_cast<size_t>(count));
+        long long prevJob = 0, prevStage = 0, prevMachine = 0;
+        TimeT prevStart = TimeT();
+        for (size_t i = 0; i < out.size(); ++i) {
+            qm::BasicOperation<TimeT>& op = out[i];
+            const long long job = prevJob + in.signedVarint();
+            const long long stage = in.signedVarint() + (job == prevJob ? prevStage : 0);
+            const long long machine = prevMachine + in.signedVarint();
+            op.job_id = static_cast<int>(job);
+            op.stage = static_cast<int>(stage);
+            op.machine_id = static_cast<int>(machine);
+            op.start_time = getTime(in, prevStart, IsFloat());
+            op.end_time = getTime(in, op.start_time, IsFloat());
+            prevJob = job;
+            prevStage = stage;
+            prevMachine = machine;
+            prevStart = op.start_time;
+        }
+        const unsigned char* bits = in.take((out.size() + 7) / 8);
+        if (!bits) return false;
+        for (size_t i = 0; i < out.size(); ++i) {
+            out[i].is_critical = (bits[i / 8] >> (i % 8)) & 1;
+        }
+        return in.good();
+    }
+
+    void encodeKeys(std::vector<char>& out, const std::vector<qm::OperationKey>& keys) {
+        putVarint(out, keys.size());
+        long long prevJob = 0, prevStage = 0;
+        for (const qm::OperationKey& key : keys) {
+            putSigned(out, key.job_id - prevJob);
+            putSigned(out, key.stage - (key.job_id == prevJob ? prevStage : 0));
+            prevJob = key.job_id;
+            prevStage = key.stage;
+        }
+    }
+
+    bool decodeKeys(ByteReader& in, std::vector<qm::OperationKey>& out) {
+        const std::uint64_t count = in.varint();
+        if (!in.good() || count > in.remaining() / 2 + 1) return false;
+        out.resize(static_cast<size_t>(count));
+        long long prevJob = 0, prevStage = 0;
+        for (qm::OperationKey& key : out) {
+            const long long job = prevJob + in.signedVarint();
+            const long long stage = in.signedVarint() + (job == prevJob ? prevStage : 0);
+            key.job_id = static_cast<int>(job);
+            key.stage = static_cast<int>(stage);
+            prevJob = job;
+            prevStage = stage;
+        }
+        return in.good();
+    }
+
+    template<typename TimeT>
+    bool sameKey(const qm::BasicOperation<TimeT>& a, const qm::BasicOperation<TimeT>& b) {
+        return a.job_id == b.job_id && a.stage == b.stage;
+    }
+
+    // 按键排序并去除重复键；求解器输出通常已经有序，此时只做一次检查
+    template<typename TimeT>
+    void sortByKey(std::vector<qm::BasicOperation<TimeT>>& ops) {
+        if (!std::is_sorted(ops.begin(), ops.end(), keyLess<TimeT>)) {
+            std::sort(ops.begin(), ops.end(), keyLess<TimeT>);
+        }
+        ops.erase(std::unique(ops.begin(), ops.end(), sameKey<TimeT>), ops.end());
+    }
+
+    // 归并两个按键排序的调度求增量，结果同样按键排序；backward 非空时同时求反向增量
+    template<typename TimeT>
+    void diffSorted(const std::vector<qm::BasicOperation<TimeT>>& previous, const std::vector<qm::BasicOperation<TimeT>>& current,
+        qm::BasicScheduleDelta<TimeT>& forward, qm::BasicScheduleDelta<TimeT>* backward) {
+        forward.clear();
+        if (backward) backward->clear();
+        size_t i = 0, j = 0;
+        while (i < previous.size() || j < current.size()) {
+            if (j == current.size() || (i < previous.size() && keyLess(previous[i], current[j]))) {
+                forward.removals.push_back({ previous[i].job_id, previous[i].stage });
+                if (backward) backward->upserts.push_back(previous[i]);
+                ++i;
+            }
+            else if (i == previous.size() || keyLess(current[j], previous[i])) {
+                forward.upserts.push_back(current[j]);
+                if (backward) backward->removals.push_back({ current[j].job_id, current[j].stage });
+                ++j;
+            }
+            else {
+                if (!sameOperation(previous[i], current[j])) {
+                    forward.upserts.push_back(current[j]);
+                    if (backward) backward->upserts.push_back(previous[i]);
+                }
+                ++i;
+                ++j;
+            }
+        }
+    }
+
+    // 把按键排序的增量应用到按键排序的调度上，结果保持有序
+    template<typename TimeT>
+    void mergeSorted(const std::vector<qm::BasicOperation<TimeT>>& base, const qm::BasicScheduleDelta<TimeT>& delta,
+        std::vector<qm::BasicOperation<TimeT>>& out) {
+        out.clear();
+        out.reserve(base.size() + delta.upserts.size());
+        size_t r = 0, u = 0;
+        for (const qm::BasicOperation<TimeT>& op : base) {
+            while (u < delta.upserts.size() && keyLess(delta.upserts[u], op)) {
+                out.push_back(delta.upserts[u++]);
+            }
+            if (u < delta.upserts.size() && sameKey(delta.upserts[u], op)) {
+                out.push_back(delta.upserts[u++]);
+                continue;
+            }
+            while (r < delta.removals.size() && (delta.removals[r].job_id < op.job_id ||
+                (delta.removals[r].job_id == op.job_id && delta.removals[r].stage < op.stage))) {
+                ++r;
+            }
+            if (r < delta.removals.size() && delta.removals[r].job_id == op.job_id && delta.removals[r].stage == op.stage) {
+                ++r;
+                continue;
+            }
+            out.push_back(op);
+        }
+        out.insert(out.end(), delta.upserts.begin() + u, delta.upserts.end());
+    }
+
+    template<typename TimeT>
+    void encodeDelta(std::vector<char>& out, const qm::BasicScheduleDelta<TimeT>& delta) {
+        encodeOperations(out, delta.upserts.data(), delta.upserts.size());
+        encodeKeys(out, delta.removals);
+    }
+
+    template<typename TimeT>
+    bool decodeDelta(const std::vector<char>& bytes, qm::BasicScheduleDelta<TimeT>& out) {
+        ByteReader in(bytes.data(), bytes.size());
+        return decodeOperations(in, out.upserts) && decodeKeys(in, out.removals);
+    }
+
+    template<typename TimeT>
+    FileHeader makeFileHeader() {
+        FileHeader header;
+        header.magic = FILE_MAGIC;
+        header.version = FILE_VERSION;
+        header.timeSize = static_cast<std::uint8_t>(sizeof(TimeT));
+        header.timeIsFloat = std::is_floating_point<TimeT>::value ? 1 : 0;
+        header.reserved = 0;
+        return header;
+    }
+}
+
+// === BasicScheduleRecorder ===
+
+template<typename TimeT>
+BasicScheduleRecorder<TimeT>::BasicScheduleRecorder() {
+}
+
+template<typename TimeT>
+BasicScheduleRecorder<TimeT>::~BasicScheduleRecorder() {
+    close();
+}
+
+template<typename TimeT>
+bool BasicScheduleRecorder<TimeT>::open(const std::string& path) {
+    close();
+
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        GANTT_LOG(LogLevel::Error, "Could not create history file " << path);
+        return false;
+    }
+    const FileHeader header = makeFileHeader<TimeT>();
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    filePath = path;
+    fileOffset = sizeof(header);
+    buffer.clear();
+    buffer.reserve(GanttConfig::HistoryConfig::WRITE_BUFFER_SIZE);
+    previous.clear();
+    index.clear();
+    sinceKeyframe = 0;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = false;
+    nextIteration = 0;
+    stats = ScheduleRecorderStats();
+    startTime = std::chrono::steady_clock::now();
+    writerThread = std::thread(&BasicScheduleRecorder::run, this);
+    GANTT_LOG(LogLevel::Info, "Recording schedule history to " << path);
+    return true;
+}
+
+template<typename TimeT>
+void BasicScheduleRecorder<TimeT>::close() {
+    if (!writerThread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    queueReady.notify_one();
+    writerThread.join();
+
+    writeIndex();
+    flushBuffer();
+    file.close();
+
+    const ScheduleRecorderStats finalStats = getStats();
+    GANTT_LOG(LogLevel::Info, "History " << filePath << ": " << index.size() << " records ("
+        << finalStats.keyframes << " keyframes), " << finalStats.bytesWritten << " bytes, "
+        << (finalStats.bytesWritten > 0 ? static_cast<double>(finalStats.rawBytes) / finalStats.bytesWritten : 0.0)
+        << "x compression, " << finalStats.dropped << " dropped");
+    std::vector<Operation>().swap(previous);
+}
+
+template<typename TimeT>
+void BasicScheduleRecorder<TimeT>::record(const View& view, long long iteration) {
+    // 取一个复用的缓冲区，在锁外拷贝
+    std::unique_ptr<Snapshot> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!writerThread.joinable() || stopping) return;
+        if (!freeSnapshots.empty()) {
+            snapshot = std::move(freeSnapshots.back());
+            freeSnapshots.pop_back();
+        }
+    }
+    if (!snapshot) {
+        snapshot.reset(new Snapshot());
+    }
+
+    const size_t count = view.size();
+    snapshot->operations.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        snapshot->operations[i] = view[i];
+    }
+    snapshot->timestampUs = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startTime).count());
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        snapshot->iteration = iteration >= 0 ? iteration : nextIteration;
+        nextIteration = snapshot->iteration + 1;
+        ++stats.recorded;
+        if (queue.size() >= static_cast<size_t>(GanttConfig::HistoryConfig::RECORD_QUEUE_DEPTH)) {
+            // 写入落后：最新的快照替换队尾，被替换的缓冲区回收
+            queue.back().swap(snapshot);
+            freeSnapshots.push_back(std::move(snapshot));
+            ++stats.dropped;
+        }
+        else {
+            queue.push_back(std::move(snapshot));
+        }
+    }
+    queueReady.notify_one();
+}
+
+template<typename TimeT>
+ScheduleRecorderStats BasicScheduleRecorder<TimeT>::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+template<typename TimeT>
+void BasicScheduleRecorder<TimeT>::run() {
+    for (;;) {
+        std::unique_ptr<Snapshot> snapshot;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            queueReady.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                return;  // 停止且队列已写完
+            }
+            snapshot = std::move(queue.front());
+            queue.pop_front();
+        }
+
+        writeSnapshot(*snapshot);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        freeSnapshots.push_back(std::move(snapshot));
+    }
+}
+
+// 排序、与上一条记录做归并求增量，按需改写关键帧
+template<typename TimeT>
+void BasicScheduleRecorder<TimeT>::writeSnapshot(Snapshot& snapshot) {
+    std::vector<Operation>& current = snapshot.operations;
+    sortByKey(current);
+
+    bool keyframe = index.empty() || sinceKeyframe >= GanttConfig::HistoryConfig::KEYFRAME_INTERVAL;
+    if (!keyframe) {
+        diffSorted(previous, current, delta, static_cast<qm::BasicScheduleDelta<TimeT>*>(nullptr));
+        keyframe = delta.size() * GanttConfig::HistoryConfig::KEYFRAME_DELTA_DIVISOR > current.size();
+    }
+
+    body.clear();
+    body.push_back(static_cast<char>(keyframe ? KeyframeRecord : DeltaRecord));
+    putSigned(body, snapshot.iteration);
+    putVarint(body, snapshot.timestampUs);
+    if (keyframe) {
+        encodeOperations(body, current.data(), current.size());
+        sinceKeyframe = 0;
+    }
+    else {
+        encodeDelta(body, delta);
+        ++sinceKeyframe;
+    }
+
+    ScheduleHistoryEntry entry;
+    entry.iteration = snapshot.iteration;
+    entry.timestampUs = snapshot.timestampUs;
+    entry.keyframe = keyframe;
+    appendRecord(body, entry);
+    index.push_back(entry);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++(keyframe ? stats.keyframes : stats.deltas);
+        stats.bytesWritten = fileOffset;
+        stats.rawBytes += current.size() * sizeof(Operation);
+    }
+
+    // 当前快照成为下一条记录的基准，旧基准的存储随快照缓冲区回收
+    previous.swap(current);
+}
+
+template<typename TimeT>
+void BasicScheduleRecorder<TimeT>::appendRecord(const std::vector<char>& recordBody, ScheduleHistoryEntry& entry) {
+    entry.offset = fileOffset;
+    entry.length = static_cast<std::uint32_t>(recordBody.size());
+
+    const std::uint32_t length = entry.length;
+    const char* lengthBytes = reinterpret_cast<const char*>(&length);
+    buffer.insert(buffer.end(), lengthBytes, lengthBytes + sizeof(length));
+    buffer.insert(buffer.end(), recordBody.begin(), recordBody.end());
+    fileOffset += sizeof(length) + recordBody.size();
+
+    if (buffer.size() >= static_cast<size_t>(GanttConfig::HistoryConfig::WRITE_BUFFER_SIZE)) {
+        flushBuffer();
+    }
+}
+
+template<typename TimeT>
+void BasicScheduleRecorder<TimeT>::flushBuffer() {
+    if (!buffer.empty()) {
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+    file.flush();
+}
+
+// 索引记录：各项与前一项的差值，随后是指向它的文件尾
+template<typename TimeT>
+void BasicScheduleRecorder<TimeT>::writeIndex() {
+    body.clear();
+    body.push_back(static_cast<char>(IndexRecord));
+    putVarint(body, index.size());
+    ScheduleHistoryEntry previousEntry = { 0, 0, 0, 0, false };
+    for (const ScheduleHistoryEntry& entry : index) {
+        putSigned(body, entry.iteration - previousEntry.iteration);
+        putVarint(body, entry.timestampUs - previousEntry.timestampUs);
+        putVarint(body, entry.offset - previousEntry.offset);
+        putVarint(body, entry.length);
+        body.push_back(entry.keyframe ? 1 : 0);
+        previousEntry = entry;
+    }
+
+    ScheduleHistoryEntry indexEntry = { 0, 0, 0, 0, false };
+    appendRecord(body, indexEntry);
+
+    FileTrailer trailer;
+    trailer.indexOffset = indexEntry.offset;
+    trailer.magic = TRAILER_MAGIC;
+    trailer.entryCount = static_cast<std::uint32_t>(index.size());
+    const char* trailerBytes = reinterpret_cast<const char*>(&trailer);
+    buffer.insert(buffer.end(), trailerBytes, trailerBytes + sizeof(trailer));
+    fileOffset += sizeof(trailer);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.bytesWritten = fileOffset;
+}
+
+// === BasicScheduleHistoryReader ===
+
+template<typename TimeT>
+bool BasicScheduleHistoryReader<TimeT>::open(const std::string& path) {
+    close();
+
+    file.open(path, std::ios::binary);
+    if (!file.is_open()) {
+        GANTT_LOG(LogLevel::Error, "Could not open history file " << path);
+        return false;
+    }
+    file.seekg(0, std::ios::end);
+    const std::uint64_t fileSize = static_cast<std::uint64_t>(file.tellg());
+    file.seekg(0);
+
+    FileHeader header;
+    const FileHeader expected = makeFileHeader<TimeT>();
+    if (fileSize < sizeof(header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic != FILE_MAGIC || header.version != FILE_VERSION) {
+        GANTT_LOG(LogLevel::Error, "Not a schedule history file: " << path);
+        close();
+        return false;
+    }
+    if (header.timeSize != expected.timeSize || header.timeIsFloat != expected.timeIsFloat) {
+        GANTT_LOG(LogLevel::Error, "History file " << path << " uses a different time type ("
+            << static_cast<int>(header.timeSize) << " bytes" << (header.timeIsFloat ? ", floating point" : "") << ")");
+        close();
+        return false;
+    }
+
+    if (!loadIndex(fileSize)) {
+        GANTT_LOG(LogLevel::Warning, "History file " << path << " has no index (not closed cleanly), scanning records");
+        if (!scanRecords(fileSize)) {
+            close();
+            return false;
+        }
+    }
+    if (index.empty() || !index.front().keyframe) {
+        GANTT_LOG(LogLevel::Error, "History file " << path << " contains no records");
+        close();
+        return false;
+    }
+
+    GANTT_LOG(LogLevel::Info, "Opened history " << path << ": " << index.size() << " records, iterations "
+        << index.front().iteration << " - " << index.back().iteration);
+    return true;
+}
+
+template<typename TimeT>
+void BasicScheduleHistoryReader<TimeT>::close() {
+    if (file.is_open()) {
+        file.close();
+    }
+    file.clear();
+    index.clear();
+    state.clear();
+    currentRecord = npos;
+}
+
+template<typename TimeT>
+bool BasicScheduleHistoryReader<TimeT>::loadIndex(std::uint64_t fileSize) {
+    FileTrailer trailer;
+    if (fileSize < sizeof(FileHeader) + sizeof(FileTrailer)) return false;
+    file.seekg(static_cast<std::streamoff>(fileSize - sizeof(trailer)));
+    if (!file.read(reinterpret_cast<char*>(&trailer), sizeof(trailer)) || trailer.magic != TRAILER_MAGIC ||
+        trailer.indexOffset < sizeof(FileHeader) || trailer.indexOffset + sizeof(std::uint32_t) > fileSize - sizeof(trailer)) {
+        file.clear();
+        return false;
+    }
+
+    std::uint32_t length = 0;
+    file.seekg(static_cast<std::streamoff>(trailer.indexOffset));
+    if (!file.read(reinterpret_cast<char*>(&length), sizeof(length)) ||
+        trailer.indexOffset + sizeof(length) + length > fileSize - sizeof(trailer)) {
+        file.clear();
+        return false;
+    }
+    recordBuffer.resize(length);
+    if (!file.read(recordBuffer.data(), length)) {
+        file.clear();
+        return false;
+    }
+
+    ByteReader in(recordBuffer.data(), recordBuffer.size());
+    if (in.byte() != IndexRecord) return false;
+    const std::uint64_t count = in.varint();
+    if (!in.good() || count != trailer.entryCount) return false;
+
+    index.clear();
+    index.reserve(static_cast<size_t>(count));
+    ScheduleHistoryEntry entry = { 0, 0, 0, 0, false };
+    for (std::uint64_t i = 0; i < count; ++i) {
+        entry.iteration += in.signedVarint();
+        entry.timestampUs += in.varint();
+        entry.offset += in.varint();
+        entry.length = static_cast<std::uint32_t>(in.varint());
+        entry.keyframe = in.byte() != 0;
+        if (!in.good() || entry.offset + sizeof(std::uint32_t) + entry.length > trailer.indexOffset) {
+            index.clear();
+            return false;
+        }
+        index.push_back(entry);
+    }
+    return true;
+}
+
+template<typename TimeT>
+bool BasicScheduleHistoryReader<TimeT>::scanRecords(std::uint64_t fileSize) {
+    index.clear();
+    std::uint64_t offset = sizeof(FileHeader);
+    char prefix[RECORD_PREFIX_MAX];
+    while (offset + sizeof(std::uint32_t) <= fileSize) {
+        std::uint32_t length = 0;
+        file.seekg(static_cast<std::streamoff>(offset));
+        if (!file.read(reinterpret_cast<char*>(&length), sizeof(length)) ||
+            offset + sizeof(length) + length > fileSize || length == 0) {
+            break;  // 截断的最后一条记录
+        }
+        const size_t prefixLength = std::min<size_t>(length, sizeof(prefix));
+        if (!file.read(prefix, static_cast<std::streamsize>(prefixLength))) break;
+
+        ByteReader in(prefix, prefixLength);
+        const std::uint8_t type = in.byte();
+        if (type == IndexRecord) break;
+        ScheduleHistoryEntry entry;
+        entry.iteration = in.signedVarint();
+        entry.timestampUs = in.varint();
+        entry.offset = offset;
+        entry.length = length;
+        entry.keyframe = type == KeyframeRecord;
+        if (!in.good() || (type != KeyframeRecord && type != DeltaRecord)) break;
+        index.push_back(entry);
+        offset += sizeof(length) + length;
+    }
+    file.clear();
+    return !index.empty();
+}
+
+template<typename TimeT>
+size_t BasicScheduleHistoryReader<TimeT>::findRecord(long long iteration) const {
+    if (index.empty()) return npos;
+    auto it = std::lower_bound(index.begin(), index.end(), iteration,
+        [](const ScheduleHistoryEntry& entry, long long value) { return entry.iteration < value; });
+    return it == index.end() ? index.size() - 1 : static_cast<size_t>(it - index.begin());
+}
+
+template<typename TimeT>
+bool BasicScheduleHistoryReader<TimeT>::readRecord(size_t record) {
+    const ScheduleHistoryEntry& entry = index[record];
+    recordBuffer.resize(entry.length);
+    file.seekg(static_cast<std::streamoff>(entry.offset + sizeof(std::uint32_t)));
+    if (!file.read(recordBuffer.data(), entry.length)) {
+        file.clear();
+        return false;
+    }
+
+    ByteReader in(recordBuffer.data(), recordBuffer.size());
+    const std::uint8_t type = in.byte();
+    in.signedVarint();
+    in.varint();
+    if (!decodeOperations(in, decoded.upserts)) return false;
+    if (type == DeltaRecord) {
+        return decodeKeys(in, decoded.removals);
+    }
+    decoded.removals.clear();
+    return type == KeyframeRecord;
+}
+
+template<typename TimeT>
+bool BasicScheduleHistoryReader<TimeT>::seek(size_t record, std::vector<Operation>& out) {
+    if (record >= index.size()) return false;
+
+    size_t keyframe = record;
+    while (!index[keyframe].keyframe) {
+        --keyframe;  // 第一条记录总是关键帧
+    }
+
+    // 目标在当前位置之后且与当前位置属于同一关键帧区间时只应用新增的增量
+    size_t next;
+    if (currentRecord != npos && currentRecord >= keyframe && currentRecord <= record) {
+        next = currentRecord + 1;
+    }
+    else {
+        if (!readRecord(keyframe)) {
+            GANTT_LOG(LogLevel::Error, "History record " << keyframe << " is corrupt");
+            currentRecord = npos;
+            return false;
+        }
+        state.assign(std::move(decoded.upserts));
+        next = keyframe + 1;
+    }
+
+    for (size_t i = next; i <= record; ++i) {
+        if (!readRecord(i)) {
+            GANTT_LOG(LogLevel::Error, "History record " << i << " is corrupt");
+            currentRecord = npos;
+            return false;
+        }
+        state.apply(decoded);
+    }
+
+    currentRecord = record;
+    out = state.data();
+    return true;
+}
+
+// === BasicScheduleHistoryRing ===
+
+template<typename TimeT>
+BasicScheduleHistoryRing<TimeT>::BasicScheduleHistoryRing(size_t memoryBudgetBytes, size_t maxEntries)
+    : memoryBudget(memoryBudgetBytes), maxEntries(std::max<size_t>(1, maxEntries)) {
+}
+
+template<typename TimeT>
+void BasicScheduleHistoryRing<TimeT>::setLimits(size_t memoryBudgetBytes, size_t newMaxEntries) {
+    memoryBudget = memoryBudgetBytes;
+    maxEntries = std::max<size_t>(1, newMaxEntries);
+    evict();
+}
+
+template<typename TimeT>
+void BasicScheduleHistoryRing<TimeT>::clear() {
+    firstSequence += entries.size();
+    entries.clear();
+    encodedBytes = 0;
+    sinceKeyframe = 0;
+    std::vector<Operation>().swap(head);
+    std::vector<Operation>().swap(scratch);
+}
+
+template<typename TimeT>
+size_t BasicScheduleHistoryRing<TimeT>::push(const View& view, long long iteration) {
+    const size_t count = view.size();
+    scratch.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        scratch[i] = view[i];
+    }
+    sortByKey(scratch);
+
+    Entry entry;
+    entry.iteration = iteration >= 0 ? iteration : nextIteration;
+    nextIteration = entry.iteration + 1;
+    entry.keyframe = entries.empty() || sinceKeyframe >= GanttConfig::HistoryConfig::KEYFRAME_INTERVAL;
+    if (!entries.empty()) {
+        // 关键帧同样保存正反向增量，单步跨过关键帧时也不必解码完整调度
+        diffSorted(head, scratch, forwardDelta, &backwardDelta);
+        entry.keyframe = entry.keyframe ||
+            forwardDelta.size() * GanttConfig::HistoryConfig::KEYFRAME_DELTA_DIVISOR > scratch.size();
+        body.clear();
+        encodeDelta(body, forwardDelta);
+        entry.forward.assign(body.begin(), body.end());
+        body.clear();
+        encodeDelta(body, backwardDelta);
+        entry.backward.assign(body.begin(), body.end());
+    }
+    if (entry.keyframe) {
+        body.clear();
+        encodeOperations(body, scratch.data(), scratch.size());
+        entry.snapshot.assign(body.begin(), body.end());
+        sinceKeyframe = 0;
+    }
+    else {
+        ++sinceKeyframe;
+    }
+
+    head.swap(scratch);
+    encodedBytes += entry.bytes();
+    entries.push_back(std::move(entry));
+    evict();
+    return getLast();
+}
+
+template<typename TimeT>
+size_t BasicScheduleHistoryRing<TimeT>::pushDelta(const Delta& delta, long long iteration) {
+    // head 在 push 中会被替换，先拷贝出“最新调度 + 增量”
+    std::vector<Operation> next(head);
+    qm::applyScheduleDelta(next, delta);
+    return push(View::fromRecords(next), iteration);
+}
+
+// 淘汰最旧的记录；其后的记录若是增量，用最旧的关键帧加上它的正向增量（均按键排序）归并出新的关键帧
+template<typename TimeT>
+void BasicScheduleHistoryRing<TimeT>::evict() {
+    while (entries.size() > 1 && (entries.size() > maxEntries || getMemoryUsage() > memoryBudget)) {
+        Entry& oldest = entries.front();
+        Entry& next = entries[1];
+        encodedBytes -= oldest.bytes() + next.bytes();
+
+        if (!next.keyframe) {
+            ByteReader in(oldest.snapshot.data(), oldest.snapshot.size());
+            if (!decodeOperations(in, decodedOperations) || !decodeDelta(next.forward, forwardDelta)) {
+                GANTT_LOG(LogLevel::Error, "Schedule history ring is corrupt, clearing it");
+                clear();
+                return;
+            }
+            mergeSorted(decodedOperations, forwardDelta, scratch);
+            body.clear();
+            encodeOperations(body, scratch.data(), scratch.size());
+            next.snapshot.assign(body.begin(), body.end());
+            next.keyframe = true;
+        }
+        // 上一条记录不再存在，next 的增量不会再被使用
+        std::vector<char>().swap(next.forward);
+        std::vector<char>().swap(next.backward);
+
+        encodedBytes += next.bytes();
+        entries.pop_front();
+        ++firstSequence;
+        ++evicted;
+    }
+}
+
+template<typename TimeT>
+bool BasicScheduleHistoryRing<TimeT>::materialize(size_t sequence, std::vector<Operation>& out) {
+    if (!contains(sequence)) return false;
+    const size_t position = sequence - firstSequence;
+    if (position + 1 == entries.size()) {
+        out = head;
+        return true;
+    }
+
+    size_t keyframe = position;
+    while (!entries[keyframe].keyframe) {
+        --keyframe;  // 最旧的记录总是关键帧
+    }
+    ByteReader in(entries[keyframe].snapshot.data(), entries[keyframe].snapshot.size());
+    if (!decodeOperations(in, decodedOperations)) return false;
+
+    qm::BasicOperationStore<TimeT> store;
+    store.assign(std::move(decodedOperations));
+    for (size_t i = keyframe + 1; i <= position; ++i) {
+        if (!decodeDelta(entries[i].forward, forwardDelta)) return false;
+        store.apply(forwardDelta);
+    }
+    out = store.data();
+    return true;
+}
+
+template<typename TimeT>
+bool BasicScheduleHistoryRing<TimeT>::getStepDelta(size_t from, size_t to, Delta& out) {
+    if (!contains(from) || !contains(to)) return false;
+    if (to == from + 1) {
+        return decodeDelta(entries[to - firstSequence].forward, out);
+    }
+    if (from == to + 1) {
+        return decodeDelta(entries[from - firstSequence].backward, out);
+    }
+    return false;
+}
+
+template class BasicScheduleRecorder<int>;
+template class BasicScheduleRecorder<long long>;
+template class BasicScheduleRecorder<double>;
+template class BasicScheduleHistoryReader<int>;
+template class BasicScheduleHistoryReader<long long>;
+template class BasicScheduleHistoryReader<double>;
+template class BasicScheduleHistoryRing<int>;
+template class BasicScheduleHistoryRing<long long>;
+template class BasicScheduleHistoryRing<double>;
@@ -0,0 +1,269 @@
+//
+// 调度历史记录文件（只追加）与回放读取，以及内存中的历史环
+// 每条记录是完整关键帧或相对上一条记录的增量（以 (job_id, stage) 为键），
+// 操作按键排序后以差分 + zigzag 变长整数压缩；关闭时在文件末尾写入跳转索引，
+// 未正常关闭的文件在打开时顺序扫描重建索引（截断的最后一条记录被忽略）。
+// 跳转到任意记录只需解码最近的关键帧与其后不超过 KEYFRAME_INTERVAL 条增量。
+//
+#ifndef SCHEDULE_HISTORY_H
+#define SCHEDULE_HISTORY_H
+
+#include "OperationView.h"
+#include "ScheduleDelta.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 跳转索引中的一项
+struct ScheduleHistoryEntry {
+    long long iteration;         // 求解器迭代号
+    std::uint64_t timestampUs;   // 相对记录开始的时间（微秒）
+    std::uint64_t offset;        // 记录在文件中的偏移
+    std::uint32_t length;        // 记录体长度（字节）
+    bool keyframe;
+};
+
+// 记录器统计
+struct ScheduleRecorderStats {
+    std::uint64_t recorded = 0;      // record 调用次数
+    std::uint64_t dropped = 0;       // 写入落后时被更新的快照覆盖的次数
+    std::uint64_t keyframes = 0;
+    std::uint64_t deltas = 0;
+    std::uint64_t bytesWritten = 0;
+    std::uint64_t rawBytes = 0;      // 未压缩的完整快照大小之和，用于计算压缩比
+};
+
+/**
+ * @brief 历史记录器（求解器或查看器进程使用）
+ *
+ * record 只把快照拷贝到复用的缓冲区并入队，排序、求增量、压缩与写文件都在后台线程中进行，
+ * 因此调用方的开销约为一次内存拷贝。写入落后且队列已满时，新快照覆盖队尾的快照（计入 dropped）。
+ */
+template<typename TimeT>
+class BasicScheduleRecorder {
+public:
+    using Operation = qm::BasicOperation<TimeT>;
+    using View = qm::OperationView<TimeT>;
+
+    BasicScheduleRecorder();
+    ~BasicScheduleRecorder();
+    BasicScheduleRecorder(const BasicScheduleRecorder&) = delete;
+    BasicScheduleRecorder& operator=(const BasicScheduleRecorder&) = delete;
+
+    /**
+     * @brief 创建（覆盖）记录文件并启动写入线程
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief 写完队列中的快照与跳转索引后关闭文件
+     */
+    void close();
+
+    bool isOpen() const { return writerThread.joinable(); }
+
+    /**
+     * @brief 追加一个快照
+     * @param iteration 求解器迭代号，负数表示使用记录序号
+     */
+    void record(const View& view, long long iteration = -1);
+    void record(const std::vector<Operation>& operations, long long iteration = -1) {
+        record(View::fromRecords(operations), iteration);
+    }
+
+    ScheduleRecorderStats getStats() const;
+
+private:
+    struct Snapshot {
+        std::vector<Operation> operations;
+        long long iteration = 0;
+        std::uint64_t timestampUs = 0;
+    };
+
+    void run();
+    void writeSnapshot(Snapshot& snapshot);
+    void writeIndex();
+    void appendRecord(const std::vector<char>& recordBody, ScheduleHistoryEntry& entry);  // 填写 entry 的偏移与长度
+    void flushBuffer();
+
+    mutable std::mutex mutex;
+    std::condition_variable queueReady;
+    std::deque<std::unique_ptr<Snapshot>> queue;
+    std::vector<std::unique_ptr<Snapshot>> freeSnapshots;  // 复用的快照缓冲区
+    std::thread writerThread;
+    bool stopping = false;
+    long long nextIteration = 0;
+    std::chrono::steady_clock::time_point startTime;
+    ScheduleRecorderStats stats;
+
+    // 以下仅由写入线程访问
+    std::ofstream file;
+    std::string filePath;
+    std::vector<char> buffer;                 // 待写入的字节
+    std::vector<char> body;                   // 当前记录体
+    std::vector<Operation> previous;          // 上一条记录的快照（按键排序）
+    qm::BasicScheduleDelta<TimeT> delta;
+    std::vector<ScheduleHistoryEntry> index;
+    std::uint64_t fileOffset = 0;
+    int sinceKeyframe = 0;
+};
+
+/**
+ * @brief 历史文件读取器：按记录序号跳转，向后相邻跳转时只应用新增的增量
+ */
+template<typename TimeT>
+class BasicScheduleHistoryReader {
+public:
+    using Operation = qm::BasicOperation<TimeT>;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file.is_open(); }
+
+    size_t getRecordCount() const { return index.size(); }
+    const ScheduleHistoryEntry& getEntry(size_t record) const { return index[record]; }
+
+    /**
+     * @brief 查找第一个迭代号不小于 iteration 的记录，没有时返回最后一条
+     */
+    size_t findRecord(long long iteration) const;
+
+    /**
+     * @brief 跳转到指定记录并输出该时刻的完整调度
+     * @return 记录不存在或文件损坏时返回false
+     */
+    bool seek(size_t record, std::vector<Operation>& out);
+
+    // 当前所在的记录，尚未跳转时为 npos
+    size_t getCurrentRecord() const { return currentRecord; }
+
+    static const size_t npos = static_cast<size_t>(-1);
+
+private:
+    bool loadIndex(std::uint64_t fileSize);
+    bool scanRecords(std::uint64_t fileSize);
+    bool readRecord(size_t record);
+
+    std::ifstream file;
+    std::vector<ScheduleHistoryEntry> index;
+    std::vector<char> recordBuffer;
+    qm::BasicScheduleDelta<TimeT> decoded;
+    qm::BasicOperationStore<TimeT> state;    // 当前记录对应的完整调度
+    size_t currentRecord = npos;
+};
+
+/**
+ * @brief 内存中的调度历史环：保存最近的若干个调度，用于不经磁盘的前后对比
+ *
+ * 与历史文件相同，每条记录是关键帧或以 (job_id, stage) 为键的增量，并使用同样的差分变长整数编码。
+ * 增量同时保存正向与反向两份，前后单步只需解码一条增量；跳转到任意记录时从最近的关键帧重放。
+ * 内存用量超过预算或记录数超过上限时淘汰最旧的记录，其后的第一条记录随即改写为关键帧。
+ * 不是线程安全的，由调用方加锁。
+ */
+template<typename TimeT>
+class BasicScheduleHistoryRing {
+public:
+    using Operation = qm::BasicOperation<TimeT>;
+    using View = qm::OperationView<TimeT>;
+    using Delta = qm::BasicScheduleDelta<TimeT>;
+
+    BasicScheduleHistoryRing(size_t memoryBudgetBytes, size_t maxEntries);
+
+    /**
+     * @brief 追加一个调度，必要时淘汰最旧的记录
+     * @param iteration 求解器迭代号，负数表示使用记录序号
+     * @return 新记录的序号
+     */
+    size_t push(const View& view, long long iteration = -1);
+
+    /**
+     * @brief 追加“最新调度 + 增量”
+     */
+    size_t pushDelta(const Delta& delta, long long iteration = -1);
+
+    void clear();
+    void setLimits(size_t memoryBudgetBytes, size_t maxEntries);
+
+    bool empty() const { return entries.empty(); }
+    size_t size() const { return entries.size(); }
+
+    // 序号单调递增，淘汰后最旧记录的序号随之增大
+    size_t getFirst() const { return firstSequence; }
+    size_t getLast() const { return firstSequence + entries.size() - 1; }
+    bool contains(size_t sequence) const { return sequence >= firstSequence && sequence - firstSequence < entries.size(); }
+    long long getIteration(size_t sequence) const { return entries[sequence - firstSequence].iteration; }
+
+    /**
+     * @brief 输出指定记录的完整调度
+     */
+    bool materialize(size_t sequence, std::vector<Operation>& out);
+
+    /**
+     * @brief 输出把记录 from 变为相邻记录 to 的增量（to 为 from ± 1）
+     */
+    bool getStepDelta(size_t from, size_t to, Delta& out);
+
+    size_t getMemoryUsage() const { return encodedBytes + workingBytes(); }
+    size_t getMemoryBudget() const { return memoryBudget; }
+    size_t getEvictedCount() const { return evicted; }
+
+private:
+    struct Entry {
+        long long iteration = 0;
+        bool keyframe = false;
+        std::vector<char> snapshot;   // 关键帧：完整调度
+        std::vector<char> forward;    // 上一条 -> 本条
+        std::vector<char> backward;   // 本条 -> 上一条
+
+        size_t bytes() const { return sizeof(Entry) + snapshot.capacity() + forward.capacity() + backward.capacity(); }
+    };
+
+    void evict();
+    size_t workingBytes() const { return (head.capacity() + scratch.capacity()) * sizeof(Operation); }
+
+    std::deque<Entry> entries;
+    size_t firstSequence = 0;
+    size_t memoryBudget;
+    size_t maxEntries;
+    size_t encodedBytes = 0;
+    size_t evicted = 0;
+    long long nextIteration = 0;
+    int sinceKeyframe = 0;
+
+    std::vector<Operation> head;      // 最新的调度（按键排序），新调度与它求增量
+    std::vector<Operation> scratch;
+    std::vector<Operation> decodedOperations;
+    Delta forwardDelta;
+    Delta backwardDelta;
+    std::vector<char> body;
+};
+
+using ScheduleRecorder = BasicScheduleRecorder<int>;
+using ScheduleRecorder64 = BasicScheduleRecorder<long long>;
+using ScheduleRecorderF = BasicScheduleRecorder<double>;
+using ScheduleHistoryReader = BasicScheduleHistoryReader<int>;
+using ScheduleHistoryReader64 = BasicScheduleHistoryReader<long long>;
+using ScheduleHistoryReaderF = BasicScheduleHistoryReader<double>;
+using ScheduleHistoryRing = BasicScheduleHistoryRing<int>;
+using ScheduleHistoryRing64 = BasicScheduleHistoryRing<long long>;
+using ScheduleHistoryRingF = BasicScheduleHistoryRing<double>;
+
+extern template class BasicScheduleRecorder<int>;
+extern template class BasicScheduleRecorder<long long>;
+extern template class BasicScheduleRecorder<double>;
+extern template class BasicScheduleHistoryReader<int>;
+extern template class BasicScheduleHistoryReader<long long>;
+extern template class BasicScheduleHistoryReader<double>;
+extern template class BasicScheduleHistoryRing<int>;
+extern template class BasicScheduleHistoryRing<long long>;
+extern template class BasicScheduleHistoryRing<double>;
+
+#endif // SCHEDULE_HISTORY_H
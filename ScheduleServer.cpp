@@ -0,0 +1,515 @@
+#include "ScheduleServer.h"
+#include "GanttConfig.h"
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+#if GANTT_HAS_UNIX_SOCKETS
+#include <fcntl.h>
+#include <poll.h>
+#endif
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double millisecondsBetween(Clock::time_point from, Clock::time_point to) {
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    }
+
+#if GANTT_HAS_UNIX_SOCKETS
+    bool setNonBlocking(int fd) {
+        const int flags = fcntl(fd, F_GETFL, 0);
+        return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+    }
+#endif
+}
+
+template<typename TimeT>
+struct BasicScheduleServer<TimeT>::Client {
+    int fd = -1;
+    int id = 0;
+
+    // 帧接收状态（仅 I/O 线程访问）
+    qm::frames::FrameHeader header;
+    std::size_t headerBytes = 0;
+    std::vector<char> payload;   // 负载缓冲区，跨帧复用
+    std::size_t payloadBytes = 0;
+    Delta decoded;               // 解码缓冲区，跨帧复用
+
+    // 以下成员由 mutex 保护
+    qm::BasicOperationStore<TimeT> store;
+    Delta pending;               // 自上次 takeUpdate 以来合并的增量
+    bool pendingFull = true;     // 下一次更新必须是完整快照
+    std::size_t pendingFrames = 0;
+    bool paused = false;
+    Clock::time_point pauseStart;
+    ScheduleClientStats stats;
+    std::uint64_t windowBytes = 0;
+    std::uint64_t windowFrames = 0;
+};
+
+template<typename TimeT>
+BasicScheduleServer<TimeT>::BasicScheduleServer() {
+}
+
+template<typename TimeT>
+BasicScheduleServer<TimeT>::~BasicScheduleServer() {
+    stop();
+}
+
+template<typename TimeT>
+bool BasicScheduleServer<TimeT>::start(const std::string& path) {
+    stop();
+#if GANTT_HAS_UNIX_SOCKETS
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        GANTT_LOG(LogLevel::Error, "Invalid socket path: " << path);
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size());
+
+    // 删除上次异常退出留下的套接字文件
+    ::unlink(path.c_str());
+
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0 ||
+        ::bind(listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listenFd, SOMAXCONN) != 0 ||
+        !setNonBlocking(listenFd) ||
+        ::pipe(wakeFds) != 0) {
+        GANTT_LOG(LogLevel::Error, "Could not listen on " << path << ": " << std::strerror(errno));
+        if (listenFd >= 0) ::close(listenFd);
+        listenFd = -1;
+        ::unlink(path.c_str());
+        return false;
+    }
+    setNonBlocking(wakeFds[0]);
+    setNonBlocking(wakeFds[1]);
+
+    socketPath = path;
+    failed.store(false, std::memory_order_release);
+    running.store(true, std::memory_order_release);
+    ioThread = std::thread(&BasicScheduleServer::run, this);
+    GANTT_LOG(LogLevel::Info, "Schedule server listening on " << path);
+    return true;
+#else
+    GANTT_LOG(LogLevel::Error, "Unix domain sockets are not supported on this platform: " << path);
+    return false;
+#endif
+}
+
+template<typename TimeT>
+void BasicScheduleServer<TimeT>::stop() {
+#if GANTT_HAS_UNIX_SOCKETS
+    if (!running.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    wake();
+    if (ioThread.joinable()) {
+        ioThread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const std::unique_ptr<Client>& client : clients) {
+        ::close(client->fd);
+    }
+    clients.clear();
+    activeClient = pinnedClient = 0;
+    ::close(listenFd);
+    ::close(wakeFds[0]);
+    ::close(wakeFds[1]);
+    listenFd = wakeFds[0] = wakeFds[1] = -1;
+    ::unlink(socketPath.c_str());
+    statsVersion.fetch_add(1, std::memory_order_release);
+#endif
+}
+
+template<typename TimeT>
+void BasicScheduleServer<TimeT>::wake() {
+#if GANTT_HAS_UNIX_SOCKETS
+    const char byte = 1;
+    // 管道已满说明唤醒已在途，忽略失败
+    ssize_t ignored = ::write(wakeFds[1], &byte, 1);
+    (void)ignored;
+#endif
+}
+
+template<typename TimeT>
+void BasicScheduleServer<TimeT>::run() {
+#if GANTT_HAS_UNIX_SOCKETS
+    std::vector<pollfd> fds;
+    std::vector<Client*> polled;
+    Clock::time_point windowStart = Clock::now();
+
+    while (running.load(std::memory_order_acquire)) {
+        // 暂停的客户端不参与轮询（负描述符被忽略），连挂断事件也留到恢复后再处理
+        fds.clear();
+        polled.clear();
+        fds.push_back({ wakeFds[0], POLLIN, 0 });
+        fds.push_back({ listenFd, POLLIN, 0 });
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const std::unique_ptr<Client>& client : clients) {
+                fds.push_back({ client->paused ? -1 : client->fd, POLLIN, 0 });
+                polled.push_back(client.get());
+            }
+        }
+
+        const int ready = ::poll(fds.data(), static_cast<nfds_t>(fds.size()),
+            GanttConfig::InputConfig::SOCKET_POLL_TIMEOUT_MS);
+        if (ready < 0 && errno != EINTR) {
+            GANTT_LOG(LogLevel::Error, "Schedule server poll failed: " << std::strerror(errno));
+            // running 保持为 true，由 stop 回收线程与描述符；调用方通过 isRunning / hasFailed 得知
+            failed.store(true, std::memory_order_release);
+            statsVersion.fetch_add(1, std::memory_order_release);
+            break;
+        }
+
+        if (ready > 0) {
+            if (fds[0].revents & POLLIN) {
+                char drain[64];
+                while (::read(wakeFds[0], drain, sizeof(drain)) > 0) {}
+            }
+            if (fds[1].revents & POLLIN) {
+                acceptClients();
+            }
+
+            std::vector<Client*> closed;
+            for (size_t i = 0; i < polled.size(); ++i) {
+                const short events = fds[i + 2].revents;
+                if (events == 0) continue;
+                if (!readClient(*polled[i])) {
+                    closed.push_back(polled[i]);
+                }
+            }
+
+            if (!closed.empty()) {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (Client* client : closed) {
+                    GANTT_LOG(LogLevel::Info, "Schedule client #" << client->id << " disconnected after "
+                        << (client->stats.fullFrames + client->stats.deltaFrames) << " frames");
+                    ::close(client->fd);
+                    clients.erase(std::find_if(clients.begin(), clients.end(),
+                        [client](const std::unique_ptr<Client>& c) { return c.get() == client; }));
+                }
+                resolveActiveLocked();
+                statsVersion.fetch_add(1, std::memory_order_release);
+            }
+        }
+
+        const Clock::time_point now = Clock::now();
+        if (millisecondsBetween(windowStart, now) >= GanttConfig::InputConfig::SOCKET_STATS_WINDOW_MS) {
+            const double seconds = millisecondsBetween(windowStart, now) / 1000.0;
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const std::unique_ptr<Client>& client : clients) {
+                client->stats.megabytesPerSecond = client->windowBytes / seconds / (1024.0 * 1024.0);
+                client->stats.framesPerSecond = client->windowFrames / seconds;
+                client->windowBytes = client->windowFrames = 0;
+            }
+            windowStart = now;
+            statsVersion.fetch_add(1, std::memory_order_release);
+        }
+    }
+#endif
+}
+
+template<typename TimeT>
+void BasicScheduleServer<TimeT>::acceptClients() {
+#if GANTT_HAS_UNIX_SOCKETS
+    for (;;) {
+        const int fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;  // EAGAIN：没有更多待接受的连接
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (clients.size() >= static_cast<size_t>(GanttConfig::InputConfig::SOCKET_MAX_CLIENTS) || !setNonBlocking(fd)) {
+            GANTT_LOG(LogLevel::Warning, "Schedule server rejected a connection (" << clients.size() << " clients)");
+            ::close(fd);
+            continue;
+        }
+        std::unique_ptr<Client> client(new Client());
+        client->fd = fd;
+        client->id = nextClientId++;
+        client->stats.id = client->id;
+        GANTT_LOG(LogLevel::Info, "Schedule client #" << client->id << " connected");
+        clients.push_back(std::move(client));
+        resolveActiveLocked();
+        statsVersion.fetch_add(1, std::memory_order_release);
+    }
+#endif
+}
+
+// 读取一个客户端：帧头与负载直接读入目标缓冲区，每轮最多读取 SOCKET_READ_CHUNK 字节
+// 返回false表示连接已关闭或协议错误
+template<typename TimeT>
+bool BasicScheduleServer<TimeT>::readClient(Client& client) {
+#if GANTT_HAS_UNIX_SOCKETS
+    size_t budget = static_cast<size_t>(GanttConfig::InputConfig::SOCKET_READ_CHUNK);
+    while (budget > 0) {
+        char* target;
+        size_t wanted;
+        if (client.headerBytes < sizeof(qm::frames::FrameHeader)) {
+            target = reinterpret_cast<char*>(&client.header) + client.headerBytes;
+            wanted = sizeof(qm::frames::FrameHeader) - client.headerBytes;
+        }
+        else {
+            target = client.payload.data() + client.payloadBytes;
+            wanted = client.payload.size() - client.payloadBytes;
+        }
+
+        const ssize_t received = ::recv(client.fd, target, std::min(wanted, budget), 0);
+        if (received == 0) {
+            return false;
+        }
+        if (received < 0) {
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        budget -= static_cast<size_t>(received);
+
+        if (client.headerBytes < sizeof(qm::frames::FrameHeader)) {
+            client.headerBytes += static_cast<size_t>(received);
+            if (client.headerBytes < sizeof(qm::frames::FrameHeader)) continue;
+
+            const qm::frames::FrameHeader& header = client.header;
+            if (!qm::frames::headerMatches<TimeT>(header) ||
+                header.payloadBytes > static_cast<std::uint64_t>(GanttConfig::InputConfig::SOCKET_MAX_FRAME_BYTES)) {
+                GANTT_LOG(LogLevel::Warning, "Schedule client #" << client.id << " sent an invalid frame header (type "
+                    << static_cast<int>(header.type) << ", " << header.payloadBytes << " bytes), disconnecting");
+                return false;
+            }
+            client.payload.resize(static_cast<size_t>(header.payloadBytes));
+            client.payloadBytes = 0;
+        }
+        else {
+            client.payloadBytes += static_cast<size_t>(received);
+        }
+
+        if (client.headerBytes == sizeof(qm::frames::FrameHeader) && client.payloadBytes == client.payload.size()) {
+            handleFrame(client);
+            client.headerBytes = 0;
+            client.payloadBytes = 0;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (client.paused) break;
+        }
+    }
+    return true;
+#else
+    (void)client;
+    return false;
+#endif
+}
+
+// 解码一帧并合并到客户端状态：解码在锁外进行，存储更新与合并持锁
+template<typename TimeT>
+void BasicScheduleServer<TimeT>::handleFrame(Client& client) {
+    const qm::frames::FrameHeader& header = client.header;
+    qm::frames::decodePayload(header, client.payload.data(), client.decoded);
+    const bool full = header.type == qm::frames::FullFrame;
+    const size_t frameBytes = sizeof(header) + client.payload.size();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (full) {
+        client.store.assign(std::move(client.decoded.upserts));
+        client.pending.clear();
+        client.pendingFull = true;
+        ++client.stats.fullFrames;
+    }
+    else {
+        client.store.apply(client.decoded);
+        if (client.id != activeClient) {
+            // 未显示的客户端只维护存储，切换过来时取完整快照
+            client.pending.clear();
+            client.pendingFull = true;
+        }
+        else if (!client.pendingFull) {
+            qm::mergeScheduleDelta(client.pending, client.decoded);
+            // 合并后的增量超过存储的一半时，直接取快照更省
+            if (client.pending.size() > client.store.size() / 2) {
+                client.pending.clear();
+                client.pendingFull = true;
+            }
+        }
+        ++client.stats.deltaFrames;
+    }
+
+    if (client.id == activeClient) {
+        if (client.pendingFrames > 0) {
+            ++client.stats.coalescedFrames;
+        }
+        ++client.pendingFrames;
+        if (client.pendingFrames >= static_cast<size_t>(GanttConfig::InputConfig::SOCKET_MAX_PENDING_FRAMES) &&
+            !client.paused) {
+            client.paused = true;
+            client.pauseStart = Clock::now();
+            ++client.stats.pauseCount;
+        }
+    }
+    client.stats.bytes += frameBytes;
+    client.stats.operationCount = client.store.size();
+    client.windowBytes += frameBytes;
+    ++client.windowFrames;
+}
+
+template<typename TimeT>
+bool BasicScheduleServer<TimeT>::takeUpdate(Update& update) {
+    bool resumed = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Client* client = findClientLocked(activeClient);
+        if (!client || client->pendingFrames == 0) {
+            return false;
+        }
+
+        update.clientId = client->id;
+        update.frames = client->pendingFrames;
+        update.full = client->pendingFull;
+        update.delta.clear();
+        if (client->pendingFull) {
+            update.operations = client->store.data();
+        }
+        else {
+            update.operations.clear();
+            update.delta.upserts.swap(client->pending.upserts);
+            update.delta.removals.swap(client->pending.removals);
+        }
+        client->pending.clear();
+        client->pendingFull = false;
+        client->pendingFrames = 0;
+
+        if (client->paused) {
+            client->paused = false;
+            client->stats.pausedMs += millisecondsBetween(client->pauseStart, Clock::now());
+            resumed = true;
+        }
+    }
+
+    if (resumed) {
+        wake();
+    }
+    return true;
+}
+
+// 在持锁状态下确定显示中的客户端；切换后新客户端的下一次更新为完整快照
+template<typename TimeT>
+void BasicScheduleServer<TimeT>::resolveActiveLocked() {
+    if (pinnedClient != 0 && !findClientLocked(pinnedClient)) {
+        pinnedClient = 0;
+    }
+    int resolved = pinnedClient;
+    if (resolved == 0 && !clients.empty()) {
+        resolved = clients.front()->id;
+    }
+    if (resolved == activeClient) return;
+
+    // 旧客户端若因反压暂停则恢复读取
+    if (Client* previous = findClientLocked(activeClient)) {
+        if (previous->paused) {
+            previous->paused = false;
+            previous->stats.pausedMs += millisecondsBetween(previous->pauseStart, Clock::now());
+        }
+        previous->pendingFrames = 0;
+        previous->pending.clear();
+        previous->pendingFull = true;
+    }
+    activeClient = resolved;
+    if (Client* current = findClientLocked(activeClient)) {
+        current->pending.clear();
+        current->pendingFull = true;
+        current->pendingFrames = current->stats.fullFrames + current->stats.deltaFrames > 0 ? 1 : 0;
+    }
+}
+
+template<typename TimeT>
+typename BasicScheduleServer<TimeT>::Client* BasicScheduleServer<TimeT>::findClientLocked(int clientId) const {
+    if (clientId == 0) return nullptr;
+    for (const std::unique_ptr<Client>& client : clients) {
+        if (client->id == clientId) return client.get();
+    }
+    return nullptr;
+}
+
+template<typename TimeT>
+void BasicScheduleServer<TimeT>::setActiveClient(int clientId) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pinnedClient = clientId;
+        resolveActiveLocked();
+    }
+    statsVersion.fetch_add(1, std::memory_order_release);
+    wake();
+}
+
+template<typename TimeT>
+int BasicScheduleServer<TimeT>::cycleActiveClient() {
+    int next = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (clients.empty()) return 0;
+        size_t index = 0;
+        for (size_t i = 0; i < clients.size(); ++i) {
+            if (clients[i]->id == activeClient) {
+                index = (i + 1) % clients.size();
+                break;
+            }
+        }
+        next = clients[index]->id;
+        pinnedClient = next;
+        resolveActiveLocked();
+    }
+    statsVersion.fetch_add(1, std::memory_order_release);
+    wake();
+    return next;
+}
+
+template<typename TimeT>
+int BasicScheduleServer<TimeT>::getActiveClient() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return activeClient;
+}
+
+template<typename TimeT>
+std::vector<ScheduleClientStats> BasicScheduleServer<TimeT>::getClientStats() const {
+    std::vector<ScheduleClientStats> result;
+    std::lock_guard<std::mutex> lock(mutex);
+    result.reserve(clients.size());
+    const Clock::time_point now = Clock::now();
+    for (const std::unique_ptr<Client>& client : clients) {
+        ScheduleClientStats stats = client->stats;
+        stats.active = client->id == activeClient;
+        stats.paused = client->paused;
+        if (client->paused) {
+            stats.pausedMs += millisecondsBetween(client->pauseStart, now);
+        }
+        result.push_back(stats);
+    }
+    return result;
+}
+
+template<typename TimeT>
+void BasicScheduleServer<TimeT>::formatStats(std::vector<std::string>& lines) const {
+    const std::vector<ScheduleClientStats> stats = getClientStats();
+    lines.clear();
+
+    char line[160];
+    std::snprintf(line, sizeof(line), "socket %s  clients %zu", socketPath.c_str(), stats.size());
+    lines.push_back(line);
+    for (const ScheduleClientStats& s : stats) {
+        std::snprintf(line, sizeof(line), "%c#%d %7.2f MB/s %6.1f f/s  ops %zu  full %llu  delta %llu  merged %llu  paused %llu/%.0fms%s",
+            s.active ? '*' : ' ', s.id, s.megabytesPerSecond, s.framesPerSecond, s.operationCount,
+            static_cast<unsigned long long>(s.fullFrames), static_cast<unsigned long long>(s.deltaFrames),
+            static_cast<unsigned long long>(s.coalescedFrames), static_cast<unsigned long long>(s.pauseCount),
+            s.pausedMs, s.paused ? " [paused]" : "");
+        lines.push_back(line);
+    }
+}
+
+template class BasicScheduleServer<int>;
+template class BasicScheduleServer<long long>;
+template class BasicScheduleServer<double>;
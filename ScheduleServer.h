@@ -0,0 +1,149 @@
+//
+// 查看器内的本机套接字调度服务（Unix 域套接字，不依赖 SFML）
+// 多个求解器进程连接同一路径，发送 ScheduleFrames.h 定义的完整帧或增量帧。
+// 后台 I/O 线程把每帧直接解码进该客户端的操作存储；绘制线程每帧取走显示中客户端的更新：
+// 未取走的帧按“最新优先”合并为一个增量（或在增量过大时改为整体快照），
+// 合并的帧数达到上限时暂停读取该客户端，由内核缓冲区把反压传递给发送端。
+// 非 POSIX 平台上 start 返回失败。
+//
+#ifndef SCHEDULE_SERVER_H
+#define SCHEDULE_SERVER_H
+
+#include "ScheduleFrames.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 单个客户端的统计快照
+struct ScheduleClientStats {
+    int id = 0;
+    bool active = false;               // 当前显示的客户端
+    bool paused = false;               // 因反压暂停读取
+    std::uint64_t fullFrames = 0;
+    std::uint64_t deltaFrames = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t coalescedFrames = 0; // 未被显示即被后续帧合并的帧数
+    std::uint64_t pauseCount = 0;
+    double pausedMs = 0.0;             // 累计暂停时间
+    double megabytesPerSecond = 0.0;   // 最近一个统计窗口的接收速率
+    double framesPerSecond = 0.0;
+    std::size_t operationCount = 0;
+};
+
+/**
+ * @brief 本机套接字调度服务
+ *
+ * 默认显示最早连接的客户端，断开后自动切换到下一个；setActiveClient 可固定显示某个客户端。
+ * 切换客户端时下一次更新为完整快照。
+ */
+template<typename TimeT>
+class BasicScheduleServer {
+public:
+    using Operation = qm::BasicOperation<TimeT>;
+    using Delta = qm::BasicScheduleDelta<TimeT>;
+
+    // takeUpdate 取得的更新
+    struct Update {
+        bool full = false;                 // true：operations 为完整调度；false：delta 为增量
+        std::vector<Operation> operations;
+        Delta delta;
+        int clientId = 0;
+        std::size_t frames = 0;            // 本次更新合并的帧数
+    };
+
+    BasicScheduleServer();
+    ~BasicScheduleServer();
+    BasicScheduleServer(const BasicScheduleServer&) = delete;
+    BasicScheduleServer& operator=(const BasicScheduleServer&) = delete;
+
+    /**
+     * @brief 在指定路径监听并启动 I/O 线程（已存在的同名套接字文件会被删除）
+     */
+    bool start(const std::string& path);
+
+    /**
+     * @brief 停止 I/O 线程，断开所有客户端并删除套接字文件
+     */
+    void stop();
+
+    /**
+     * @brief I/O 线程是否在工作；轮询出错退出后返回false（仍需调用 stop 释放资源）
+     */
+    bool isRunning() const { return running.load(std::memory_order_acquire) && !failed.load(std::memory_order_acquire); }
+
+    /**
+     * @brief I/O 线程是否因错误退出，下次 start 时清除
+     */
+    bool hasFailed() const { return failed.load(std::memory_order_acquire); }
+    const std::string& getPath() const { return socketPath; }
+
+    /**
+     * @brief 取走显示中客户端自上次以来的更新（通常每帧调用一次）
+     * @return 没有新数据时返回false
+     */
+    bool takeUpdate(Update& update);
+
+    /**
+     * @brief 固定显示指定客户端；0 表示自动（最早连接的客户端）
+     */
+    void setActiveClient(int clientId);
+
+    /**
+     * @brief 切换到下一个客户端并固定显示
+     * @return 新的客户端编号，没有客户端时为0
+     */
+    int cycleActiveClient();
+
+    int getActiveClient() const;
+
+    std::vector<ScheduleClientStats> getClientStats() const;
+
+    /**
+     * @brief 统计版本号，每个统计窗口或客户端变化时递增，用于判断是否需要刷新显示
+     */
+    std::uint64_t getStatsVersion() const { return statsVersion.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 格式化各客户端的统计，每个客户端一行
+     */
+    void formatStats(std::vector<std::string>& lines) const;
+
+private:
+    struct Client;
+
+    void run();
+    void acceptClients();
+    bool readClient(Client& client);
+    void handleFrame(Client& client);
+    void resolveActiveLocked();
+    Client* findClientLocked(int clientId) const;
+    void wake();
+
+    mutable std::mutex mutex;                       // 保护客户端的存储、待取更新与统计
+    std::vector<std::unique_ptr<Client>> clients;   // 增删只在 I/O 线程中进行（持锁）
+    std::thread ioThread;
+    std::atomic<bool> running{ false };             // start 与 stop 之间为 true，stop 据此释放资源
+    std::atomic<bool> failed{ false };
+    std::atomic<std::uint64_t> statsVersion{ 0 };
+    std::string socketPath;
+    int listenFd = -1;
+    int wakeFds[2] = { -1, -1 };                    // 自管道，用于唤醒轮询（恢复读取或停止）
+    int nextClientId = 1;
+    int activeClient = 0;
+    int pinnedClient = 0;
+};
+
+using ScheduleServer = BasicScheduleServer<int>;
+using ScheduleServer64 = BasicScheduleServer<long long>;
+using ScheduleServerF = BasicScheduleServer<double>;
+
+extern template class BasicScheduleServer<int>;
+extern template class BasicScheduleServer<long long>;
+extern template class BasicScheduleServer<double>;
+
+#endif // SCHEDULE_SERVER_H
@@ -0,0 +1,436 @@
+//
+// 基于 POSIX 共享内存的调度数据发布（仅头文件，不依赖 SFML）
+// 求解器进程把调度直接写入环形槽中的列式数组，查看器固定最新的完整槽并零拷贝显示。
+// 每个槽有一个序列计数器（奇数表示正在写入）和一个读者固定计数：
+// 写者先把计数器改为奇数再检查固定计数，读者先固定再检查计数器，二者都使用顺序一致的原子操作，
+// 因此读者要么看到写入中而重试，要么写者看到固定而换一个槽，被固定的数据在释放前不会被覆盖。
+// 非 POSIX 平台上所有接口返回失败。
+//
+#ifndef SHM_SCHEDULE_H
+#define SHM_SCHEDULE_H
+
+#include "OperationView.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define GANTT_HAS_POSIX_SHM 1
+#else
+#define GANTT_HAS_POSIX_SHM 0
+#endif
+
+namespace qm {
+namespace shm {
+    const std::uint32_t MAGIC = 0x47534852;  // "GSHR"
+    const std::uint32_t VERSION = 1;
+    const std::uint32_t MAX_SLOTS = 255;     // 槽号占用最新发布字的低8位
+    const std::size_t ALIGNMENT = 64;
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free,
+        "shared memory atomics must be lock-free");
+
+    // 共享内存开头的全局信息
+    struct RingHeader {
+        std::atomic<std::uint32_t> magic;    // 初始化完成后最后写入
+        std::uint32_t version;
+        std::uint32_t slotCount;
+        std::uint32_t timeSize;              // sizeof(TimeT)
+        std::uint32_t timeIsFloat;
+        std::uint32_t reserved;
+        std::uint64_t slotCapacity;          // 每个槽最多容纳的操作数
+        std::uint64_t slotStride;            // 每个槽占用的字节数
+        alignas(ALIGNMENT) std::atomic<std::uint64_t> latest;  // (发布序号 << 8) | 槽号，0 表示尚未发布
+    };
+
+    // 每个槽的头部，其后依次是各列数组
+    struct SlotHeader {
+        std::atomic<std::uint64_t> sequence;  // 2 * 发布序号；奇数表示正在写入
+        std::atomic<std::uint32_t> readers;   // 读者固定计数
+        std::uint32_t reserved;
+        std::uint64_t count;                  // 本槽中的操作数
+    };
+
+    inline std::size_t alignUp(std::size_t value) {
+        return (value + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    // 槽内各列相对槽起始的偏移
+    struct SlotLayout {
+        std::size_t jobIds, stages, machineIds, startTimes, endTimes, critical, stride;
+
+        SlotLayout(std::size_t capacity, std::size_t timeSize) {
+            jobIds = alignUp(sizeof(SlotHeader));
+            stages = alignUp(jobIds + capacity * sizeof(int));
+            machineIds = alignUp(stages + capacity * sizeof(int));
+            startTimes = alignUp(machineIds + capacity * sizeof(int));
+            endTimes = alignUp(startTimes + capacity * timeSize);
+            critical = alignUp(endTimes + capacity * timeSize);
+            stride = alignUp(critical + capacity * sizeof(bool));
+        }
+    };
+
+    // 一段映射的共享内存，析构时解除映射（写者可选择同时删除名字）
+    class Mapping {
+    public:
+        Mapping(void* address, std::size_t size, std::string name, bool unlinkOnClose)
+            : base(static_cast<char*>(address)), length(size), shmName(std::move(name)), unlink(unlinkOnClose) {}
+        ~Mapping() {
+#if GANTT_HAS_POSIX_SHM
+            munmap(base, length);
+            if (unlink) {
+                shm_unlink(shmName.c_str());
+            }
+#endif
+        }
+        Mapping(const Mapping&) = delete;
+        Mapping& operator=(const Mapping&) = delete;
+
+        RingHeader& header() const { return *reinterpret_cast<RingHeader*>(base); }
+        char* slotBase(std::uint32_t slot) const {
+            return base + alignUp(sizeof(RingHeader)) + static_cast<std::size_t>(slot) * header().slotStride;
+        }
+        SlotHeader& slot(std::uint32_t index) const { return *reinterpret_cast<SlotHeader*>(slotBase(index)); }
+        std::size_t size() const { return length; }
+
+    private:
+        char* base;
+        std::size_t length;
+        std::string shmName;
+        bool unlink;
+    };
+
+    template<typename TimeT>
+    bool timeTypeMatches(const RingHeader& header) {
+        return header.timeSize == sizeof(TimeT) && (header.timeIsFloat != 0) == std::is_floating_point<TimeT>::value;
+    }
+
+    // 头部由另一个进程写入，读者使用前检查：按容量计算的槽布局放得进声明的步长，且全部槽位于映射之内。
+    // 先用除法限制步长与容量，避免乘法溢出
+    template<typename TimeT>
+    bool layoutFits(const RingHeader& header, std::size_t mappedSize) {
+        const std::size_t ringStart = alignUp(sizeof(RingHeader));
+        if (header.slotCount == 0 || header.slotCount > MAX_SLOTS || mappedSize < ringStart) return false;
+        const std::uint64_t available = (mappedSize - ringStart) / header.slotCount;
+        if (header.slotStride > available || header.slotStride % ALIGNMENT != 0) return false;
+        const std::size_t perOperation = 3 * sizeof(int) + 2 * sizeof(TimeT) + sizeof(bool);
+        if (header.slotCapacity > header.slotStride / perOperation) return false;
+        return SlotLayout(static_cast<std::size_t>(header.slotCapacity), sizeof(TimeT)).stride <= header.slotStride;
+    }
+}
+
+/**
+ * @brief 写者（求解器进程）
+ *
+ * 用法一：beginWrite 取得一个空闲槽的列指针，直接写入后 commit；
+ * 用法二：publish 从 qm::BasicOperation 向量拷贝。
+ * 同一时刻只允许一个写者。
+ */
+template<typename TimeT>
+class BasicShmSchedulePublisher {
+public:
+    using Operation = BasicOperation<TimeT>;
+
+    // beginWrite 返回的可写列
+    struct SlotColumns {
+        int* jobIds = nullptr;
+        int* stages = nullptr;
+        int* machineIds = nullptr;
+        TimeT* startTimes = nullptr;
+        TimeT* endTimes = nullptr;
+        bool* critical = nullptr;
+        std::size_t capacity = 0;
+    };
+
+    /**
+     * @brief 创建（或重建）共享内存环
+     * @param name POSIX 共享内存名，例如 "/gantt_schedule"
+     * @param slotCount 槽数（2~255）；建议至少3，读者固定一个槽时写者仍能交替使用其余的槽
+     * @param slotCapacity 每个槽最多容纳的操作数
+     * @param unlinkOnClose 析构时是否删除共享内存名
+     */
+    bool create(const std::string& name, std::uint32_t slotCount, std::uint64_t slotCapacity, bool unlinkOnClose = true) {
+        close();
+#if GANTT_HAS_POSIX_SHM
+        if (slotCount < 2 || slotCount > shm::MAX_SLOTS || slotCapacity == 0) return false;
+
+        const shm::SlotLayout layout(static_cast<std::size_t>(slotCapacity), sizeof(TimeT));
+        const std::size_t total = shm::alignUp(sizeof(shm::RingHeader)) + layout.stride * slotCount;
+
+        shm_unlink(name.c_str());  // 丢弃旧的环（已映射它的读者保持旧映射直到重新打开）
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) return false;
+        if (ftruncate(fd, static_cast<off_t>(total)) != 0) {
+            ::close(fd);
+            shm_unlink(name.c_str());
+            return false;
+        }
+        void* address = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (address == MAP_FAILED) {
+            shm_unlink(name.c_str());
+            return false;
+        }
+
+        mapping.reset(new shm::Mapping(address, total, name, unlinkOnClose));
+        shm::RingHeader& header = mapping->header();
+        header.version = shm::VERSION;
+        header.slotCount = slotCount;
+        header.timeSize = sizeof(TimeT);
+        header.timeIsFloat = std::is_floating_point<TimeT>::value ? 1 : 0;
+        header.slotCapacity = slotCapacity;
+        header.slotStride = layout.stride;
+        header.latest.store(0, std::memory_order_relaxed);
+        for (std::uint32_t s = 0; s < slotCount; ++s) {
+            mapping->slot(s).sequence.store(0, std::memory_order_relaxed);
+            mapping->slot(s).readers.store(0, std::memory_order_relaxed);
+            mapping->slot(s).count = 0;
+        }
+        header.magic.store(shm::MAGIC, std::memory_order_release);
+        return true;
+#else
+        (void)name; (void)slotCount; (void)slotCapacity; (void)unlinkOnClose;
+        return false;
+#endif
+    }
+
+    void close() {
+        abortWrite();
+        mapping.reset();
+        nextSequence = 1;
+    }
+
+    bool isOpen() const { return mapping != nullptr; }
+    std::size_t getCapacity() const { return mapping ? static_cast<std::size_t>(mapping->header().slotCapacity) : 0; }
+
+    /**
+     * @brief 取得一个空闲槽用于写入；所有槽都被读者固定时返回false（稍后重试）
+     */
+    bool beginWrite(SlotColumns& columns) {
+        if (!mapping || writingSlot >= 0) return false;
+        shm::RingHeader& header = mapping->header();
+        const std::uint64_t latest = header.latest.load(std::memory_order_relaxed);
+        const std::uint32_t latestSlot = latest ? static_cast<std::uint32_t>(latest & 0xFF) : header.slotCount - 1;
+
+        for (std::uint32_t i = 1; i <= header.slotCount; ++i) {
+            const std::uint32_t index = (latestSlot + i) % header.slotCount;
+            if (latest && index == latestSlot) continue;  // 最新的完整槽保持可读
+
+            shm::SlotHeader& slot = mapping->slot(index);
+            const std::uint64_t stable = slot.sequence.load(std::memory_order_relaxed);
+            slot.sequence.store(stable | 1, std::memory_order_seq_cst);
+            if (slot.readers.load(std::memory_order_seq_cst) != 0) {
+                slot.sequence.store(stable, std::memory_order_seq_cst);  // 被固定：恢复并换下一个槽
+                continue;
+            }
+
+            writingSlot = static_cast<int>(index);
+            char* base = mapping->slotBase(index);
+            const shm::SlotLayout layout(static_cast<std::size_t>(header.slotCapacity), sizeof(TimeT));
+            columns.jobIds = reinterpret_cast<int*>(base + layout.jobIds);
+            columns.stages = reinterpret_cast<int*>(base + layout.stages);
+            columns.machineIds = reinterpret_cast<int*>(base + layout.machineIds);
+            columns.startTimes = reinterpret_cast<TimeT*>(base + layout.startTimes);
+            columns.endTimes = reinterpret_cast<TimeT*>(base + layout.endTimes);
+            columns.critical = reinterpret_cast<bool*>(base + layout.critical);
+            columns.capacity = static_cast<std::size_t>(header.slotCapacity);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief 发布 beginWrite 取得的槽中的前 count 个操作
+     * @return 发布序号（从1开始递增），失败返回0
+     */
+    std::uint64_t commit(std::size_t count) {
+        if (!mapping || writingSlot < 0) return 0;
+        shm::RingHeader& header = mapping->header();
+        shm::SlotHeader& slot = mapping->slot(static_cast<std::uint32_t>(writingSlot));
+        slot.count = count < header.slotCapacity ? count : static_cast<std::size_t>(header.slotCapacity);
+
+        const std::uint64_t sequence = nextSequence++;
+        slot.sequence.store(sequence * 2, std::memory_order_release);
+        header.latest.store((sequence << 8) | static_cast<std::uint64_t>(writingSlot), std::memory_order_release);
+        writingSlot = -1;
+        return sequence;
+    }
+
+    // 放弃 beginWrite 取得的槽
+    void abortWrite() {
+        if (!mapping || writingSlot < 0) return;
+        shm::SlotHeader& slot = mapping->slot(static_cast<std::uint32_t>(writingSlot));
+        slot.sequence.store(slot.sequence.load(std::memory_order_relaxed) & ~static_cast<std::uint64_t>(1),
+            std::memory_order_release);
+        writingSlot = -1;
+    }
+
+    /**
+     * @brief 拷贝发布；超过槽容量或所有槽被固定时返回0
+     */
+    std::uint64_t publish(const std::vector<Operation>& operations) {
+        SlotColumns columns;
+        if (operations.size() > getCapacity() || !beginWrite(columns)) return 0;
+        for (std::size_t i = 0; i < operations.size(); ++i) {
+            const Operation& op = operations[i];
+            columns.jobIds[i] = op.job_id;
+            columns.stages[i] = op.stage;
+            columns.machineIds[i] = op.machine_id;
+            columns.startTimes[i] = op.start_time;
+            columns.endTimes[i] = op.end_time;
+            columns.critical[i] = op.is_critical;
+        }
+        return commit(operations.size());
+    }
+
+    ~BasicShmSchedulePublisher() { close(); }
+
+private:
+    std::shared_ptr<shm::Mapping> mapping;
+    std::uint64_t nextSequence = 1;
+    int writingSlot = -1;
+};
+
+/**
+ * @brief 读者固定的一个槽；存在期间槽中的数据不会被覆盖，析构时释放
+ */
+template<typename TimeT>
+class ShmSlotLease {
+public:
+    ShmSlotLease(std::shared_ptr<shm::Mapping> owner, std::uint32_t slotIndex, std::uint64_t sequence,
+        const OperationView<TimeT>& columns)
+        : mapping(std::move(owner)), slot(slotIndex), publishSequence(sequence), operationView(columns) {}
+    ~ShmSlotLease() {
+        mapping->slot(slot).readers.fetch_sub(1, std::memory_order_release);
+    }
+    ShmSlotLease(const ShmSlotLease&) = delete;
+    ShmSlotLease& operator=(const ShmSlotLease&) = delete;
+
+    const OperationView<TimeT>& view() const { return operationView; }
+    std::uint64_t getSequence() const { return publishSequence; }
+
+private:
+    std::shared_ptr<shm::Mapping> mapping;  // 租约存在期间保持映射
+    std::uint32_t slot;
+    std::uint64_t publishSequence;
+    OperationView<TimeT> operationView;
+};
+
+/**
+ * @brief 读者（查看器进程）
+ */
+template<typename TimeT>
+class BasicShmScheduleReader {
+public:
+    using Lease = ShmSlotLease<TimeT>;
+
+    /**
+     * @brief 打开写者创建的共享内存环；写者尚未完成初始化、时间类型不匹配或槽布局超出映射时返回false
+     */
+    bool open(const std::string& name) {
+        close();
+#if GANTT_HAS_POSIX_SHM
+        int fd = shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < shm::alignUp(sizeof(shm::RingHeader))) {
+            ::close(fd);
+            return false;
+        }
+        const std::size_t total = static_cast<std::size_t>(info.st_size);
+        void* address = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (address == MAP_FAILED) return false;
+
+        std::shared_ptr<shm::Mapping> candidate(new shm::Mapping(address, total, name, false));
+        const shm::RingHeader& header = candidate->header();
+        if (header.magic.load(std::memory_order_acquire) != shm::MAGIC || header.version != shm::VERSION
+            || !shm::timeTypeMatches<TimeT>(header) || !shm::layoutFits<TimeT>(header, total)) {
+            return false;
+        }
+        mapping = std::move(candidate);
+        return true;
+#else
+        (void)name;
+        return false;
+#endif
+    }
+
+    void close() {
+        mapping.reset();
+        lastSequence = 0;
+    }
+
+    bool isOpen() const { return mapping != nullptr; }
+
+    // 写者最近一次发布的序号，0 表示尚未发布
+    std::uint64_t getLatestSequence() const {
+        return mapping ? mapping->header().latest.load(std::memory_order_acquire) >> 8 : 0;
+    }
+
+    /**
+     * @brief 固定比上次取得的更新的最新完整槽
+     * @return 没有新数据时返回空
+     */
+    std::shared_ptr<Lease> acquireNext() {
+        if (!mapping) return nullptr;
+        const shm::RingHeader& header = mapping->header();
+
+        for (int attempt = 0; attempt < 16; ++attempt) {
+            const std::uint64_t latest = header.latest.load(std::memory_order_acquire);
+            if ((latest >> 8) <= lastSequence) return nullptr;
+
+            const std::uint32_t index = static_cast<std::uint32_t>(latest & 0xFF);
+            if (index >= header.slotCount) return nullptr;
+            shm::SlotHeader& slot = mapping->slot(index);
+
+            slot.readers.fetch_add(1, std::memory_order_seq_cst);
+            const std::uint64_t sequence = slot.sequence.load(std::memory_order_seq_cst);
+            if ((sequence & 1) || sequence / 2 <= lastSequence) {
+                // 正在写入或已被更旧的数据替换（写者崩溃等），稍后重试
+                slot.readers.fetch_sub(1, std::memory_order_release);
+                continue;
+            }
+
+            // 已固定且计数器为偶数：数据完整，且在释放前不会被覆盖
+            const std::size_t count = static_cast<std::size_t>(
+                slot.count < header.slotCapacity ? slot.count : header.slotCapacity);
+            const char* base = mapping->slotBase(index);
+            const shm::SlotLayout layout(static_cast<std::size_t>(header.slotCapacity), sizeof(TimeT));
+            const OperationView<TimeT> columns = OperationView<TimeT>::fromArrays(count,
+                reinterpret_cast<const int*>(base + layout.jobIds),
+                reinterpret_cast<const int*>(base + layout.stages),
+                reinterpret_cast<const int*>(base + layout.machineIds),
+                reinterpret_cast<const TimeT*>(base + layout.startTimes),
+                reinterpret_cast<const TimeT*>(base + layout.endTimes),
+                reinterpret_cast<const bool*>(base + layout.critical));
+
+            lastSequence = sequence / 2;
+            return std::make_shared<Lease>(mapping, index, lastSequence, columns);
+        }
+        return nullptr;
+    }
+
+private:
+    std::shared_ptr<shm::Mapping> mapping;
+    std::uint64_t lastSequence = 0;
+};
+
+using ShmSchedulePublisher = BasicShmSchedulePublisher<int>;
+using ShmSchedulePublisher64 = BasicShmSchedulePublisher<long long>;
+using ShmSchedulePublisherF = BasicShmSchedulePublisher<double>;
+using ShmScheduleReader = BasicShmScheduleReader<int>;
+using ShmScheduleReader64 = BasicShmScheduleReader<long long>;
+using ShmScheduleReaderF = BasicShmScheduleReader<double>;
+}
+
+#endif // SHM_SCHEDULE_H
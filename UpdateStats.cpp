@@ -0,0 +1,201 @@
+#include "UpdateStats.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+    // 最高有效位位置（value > 0）
+    int highestBit(std::uint64_t value) {
+        int bit = 0;
+        if (value >> 32) { value >>= 32; bit += 32; }
+        if (value >> 16) { value >>= 16; bit += 16; }
+        if (value >> 8) { value >>= 8; bit += 8; }
+        if (value >> 4) { value >>= 4; bit += 4; }
+        if (value >> 2) { value >>= 2; bit += 2; }
+        if (value >> 1) { bit += 1; }
+        return bit;
+    }
+
+    double toMicros(std::uint64_t ns) {
+        return ns / 1000.0;
+    }
+}
+
+// === LatencyHistogram ===
+
+LatencyHistogram::LatencyHistogram() : counts(BUCKET_COUNT, 0) {
+}
+
+int LatencyHistogram::bucketIndex(std::uint64_t value) {
+    if (value < static_cast<std::uint64_t>(SUB_BUCKET_COUNT)) {
+        return static_cast<int>(value);
+    }
+    // 数量级 m 内以 2^m 为步长线性分为 64 个子桶
+    int magnitude = highestBit(value) - (SUB_BUCKET_BITS - 1);
+    int subBucket = static_cast<int>(value >> magnitude);
+    return SUB_BUCKET_COUNT + (magnitude - 1) * SUB_BUCKET_HALF + (subBucket - SUB_BUCKET_HALF);
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(int index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return static_cast<std::uint64_t>(index);
+    }
+    int magnitude = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_HALF + 1;
+    std::uint64_t subBucket = static_cast<std::uint64_t>((index - SUB_BUCKET_COUNT) % SUB_BUCKET_HALF + SUB_BUCKET_HALF);
+    return (subBucket << magnitude) + ((std::uint64_t(1) << magnitude) - 1);
+}
+
+void LatencyHistogram::record(std::uint64_t valueNs) {
+    counts[bucketIndex(valueNs)]++;
+    minValue = totalCount == 0 ? valueNs : std::min(minValue, valueNs);
+    maxValue = std::max(maxValue, valueNs);
+    sum += static_cast<double>(valueNs);
+    totalCount++;
+}
+
+void LatencyHistogram::reset() {
+    std::fill(counts.begin(), counts.end(), 0);
+    totalCount = 0;
+    minValue = maxValue = 0;
+    sum = 0.0;
+}
+
+double LatencyHistogram::getMean() const {
+    return totalCount ? sum / static_cast<double>(totalCount) : 0.0;
+}
+
+std::uint64_t LatencyHistogram::getValueAtPercentile(double percentile) const {
+    if (totalCount == 0) return 0;
+
+    percentile = std::max(0.0, std::min(100.0, percentile));
+    std::uint64_t target = static_cast<std::uint64_t>(percentile / 100.0 * totalCount + 0.5);
+    target = std::max<std::uint64_t>(1, std::min(target, totalCount));
+
+    std::uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += counts[i];
+        if (seen >= target) {
+            return std::min(bucketUpperBound(i), maxValue);
+        }
+    }
+    return maxValue;
+}
+
+// === UpdateStatsSnapshot ===
+
+bool UpdateStatsSnapshot::dumpToFile(const std::string& path) const {
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) return false;
+
+    std::fprintf(file, "{\n  \"uptime_s\": %.3f,\n", uptimeSeconds);
+    std::fprintf(file, "  \"updates_applied\": %llu,\n", static_cast<unsigned long long>(updatesApplied));
+    std::fprintf(file, "  \"updates_coalesced\": %llu,\n", static_cast<unsigned long long>(updatesCoalesced));
+    std::fprintf(file, "  \"updates_dropped\": %llu,\n", static_cast<unsigned long long>(updatesDropped));
+    std::fprintf(file, "  \"operations_ingested\": %llu,\n", static_cast<unsigned long long>(operationsIngested));
+    std::fprintf(file, "  \"operations_per_second\": %.1f,\n", operationsPerSecond);
+    std::fprintf(file, "  \"stages_us\": {\n");
+
+    const int count = static_cast<int>(UpdateStage::Count);
+    for (int i = 0; i < count; ++i) {
+        const StageLatency& s = stages[i];
+        std::fprintf(file, "    \"%s\": {\"count\": %llu, \"min\": %.3f, \"mean\": %.3f, \"p50\": %.3f, "
+            "\"p90\": %.3f, \"p99\": %.3f, \"p999\": %.3f, \"max\": %.3f}%s\n",
+            UpdatePipelineStats::stageName(static_cast<UpdateStage>(i)),
+            static_cast<unsigned long long>(s.count), s.min, s.mean, s.p50, s.p90, s.p99, s.p999, s.max,
+            i + 1 < count ? "," : "");
+    }
+
+    std::fprintf(file, "  }\n}\n");
+    return std::fclose(file) == 0;
+}
+
+// === UpdatePipelineStats ===
+
+UpdatePipelineStats::UpdatePipelineStats() : created(Clock::now()) {
+    std::fill(std::begin(rateCounts), std::end(rateCounts), 0);
+}
+
+const char* UpdatePipelineStats::stageName(UpdateStage stage) {
+    switch (stage) {
+    case UpdateStage::Ingest: return "ingest";
+    case UpdateStage::Ranges: return "calculate_ranges";
+    case UpdateStage::Colors: return "job_colors";
+    case UpdateStage::Analysis: return "analysis";
+    case UpdateStage::FirstFrame: return "time_to_first_frame";
+    default: return "unknown";
+    }
+}
+
+void UpdatePipelineStats::recordStage(UpdateStage stage, Clock::time_point start, Clock::time_point end) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    histograms[static_cast<int>(stage)].record(static_cast<std::uint64_t>(std::max<long long>(0, ns)));
+}
+
+void UpdatePipelineStats::recordUpdate(std::size_t operationCount, Clock::time_point start) {
+    // 上一次更新还没显示就被覆盖
+    if (awaitingFirstFrame) {
+        ++updatesCoalesced;
+    }
+    awaitingFirstFrame = true;
+    pendingUpdateStart = start;
+
+    ++updatesApplied;
+    operationsIngested += operationCount;
+
+    rateTimes[rateNext] = start;
+    rateCounts[rateNext] = operationCount;
+    rateNext = (rateNext + 1) % RATE_WINDOW;
+    rateSize = std::min(rateSize + 1, RATE_WINDOW);
+}
+
+void UpdatePipelineStats::recordFrameDisplayed(Clock::time_point displayed) {
+    if (!awaitingFirstFrame) return;
+    awaitingFirstFrame = false;
+    recordStage(UpdateStage::FirstFrame, pendingUpdateStart, displayed);
+}
+
+UpdateStatsSnapshot UpdatePipelineStats::snapshot() const {
+    UpdateStatsSnapshot result;
+
+    for (int i = 0; i < static_cast<int>(UpdateStage::Count); ++i) {
+        const LatencyHistogram& h = histograms[i];
+        StageLatency& s = result.stages[i];
+        s.count = h.getCount();
+        s.min = toMicros(h.getMin());
+        s.mean = h.getMean() / 1000.0;
+        s.p50 = toMicros(h.getValueAtPercentile(50.0));
+        s.p90 = toMicros(h.getValueAtPercentile(90.0));
+        s.p99 = toMicros(h.getValueAtPercentile(99.0));
+        s.p999 = toMicros(h.getValueAtPercentile(99.9));
+        s.max = toMicros(h.getMax());
+    }
+
+    result.updatesApplied = updatesApplied;
+    result.updatesCoalesced = updatesCoalesced;
+    result.updatesDropped = updatesDropped;
+    result.operationsIngested = operationsIngested;
+    result.uptimeSeconds = std::chrono::duration<double>(Clock::now() - created).count();
+
+    // 窗口内最早一次更新之后接收的操作数 / 时间跨度
+    if (rateSize >= 2) {
+        int newest = (rateNext + RATE_WINDOW - 1) % RATE_WINDOW;
+        int oldest = (rateNext + RATE_WINDOW - rateSize) % RATE_WINDOW;
+        double span = std::chrono::duration<double>(rateTimes[newest] - rateTimes[oldest]).count();
+        std::uint64_t ops = 0;
+        for (int k = 1; k < rateSize; ++k) {
+            ops += rateCounts[(oldest + k) % RATE_WINDOW];
+        }
+        result.operationsPerSecond = span > 0 ? ops / span : 0.0;
+    }
+
+    return result;
+}
+
+void UpdatePipelineStats::reset() {
+    for (auto& h : histograms) {
+        h.reset();
+    }
+    updatesApplied = updatesCoalesced = updatesDropped = operationsIngested = 0;
+    awaitingFirstFrame = false;
+    rateNext = rateSize = 0;
+    created = Clock::now();
+}
@@ -0,0 +1,132 @@
+//
+// 更新流水线统计：各阶段延迟直方图与吞吐计数器
+// 直方图采用 HDR 风格的对数-线性分桶，固定内存，记录为 O(1)
+//
+#ifndef UPDATE_STATS_H
+#define UPDATE_STATS_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 对数-线性延迟直方图（纳秒），相对误差不超过 1/64
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void record(std::uint64_t valueNs);
+    void reset();
+
+    std::uint64_t getCount() const { return totalCount; }
+    std::uint64_t getMin() const { return totalCount ? minValue : 0; }
+    std::uint64_t getMax() const { return maxValue; }
+    double getMean() const;
+
+    /**
+     * @brief 获取百分位对应的值（该桶可表示的最大值）
+     * @param percentile 0~100
+     */
+    std::uint64_t getValueAtPercentile(double percentile) const;
+
+private:
+    static const int SUB_BUCKET_BITS = 7;                           // 每个数量级128个子桶
+    static const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static const int SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;
+    static const int MAGNITUDES = 64 - SUB_BUCKET_BITS;
+    static const int BUCKET_COUNT = SUB_BUCKET_COUNT + MAGNITUDES * SUB_BUCKET_HALF;
+
+    std::vector<std::uint64_t> counts;
+    std::uint64_t totalCount = 0;
+    std::uint64_t minValue = 0;
+    std::uint64_t maxValue = 0;
+    double sum = 0.0;
+
+    static int bucketIndex(std::uint64_t value);
+    static std::uint64_t bucketUpperBound(int index);
+};
+
+// 被统计的更新阶段
+enum class UpdateStage {
+    Ingest,      // 数据拷贝与行索引建立
+    Ranges,      // calculateRanges
+    Colors,      // generateJobColors
+    Analysis,    // 数据分析/验证输出
+    FirstFrame,  // update() 开始到首次 display() 完成
+    Count
+};
+
+// 单个阶段的延迟摘要（单位：微秒）
+struct StageLatency {
+    std::uint64_t count = 0;
+    double min = 0.0;
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double p999 = 0.0;
+    double max = 0.0;
+};
+
+// getStats() 返回的快照
+struct UpdateStatsSnapshot {
+    StageLatency stages[static_cast<int>(UpdateStage::Count)];
+    std::uint64_t updatesApplied = 0;      // 成功应用的更新次数
+    std::uint64_t updatesCoalesced = 0;    // 尚未显示就被新数据覆盖的更新
+    std::uint64_t updatesDropped = 0;      // 被拒绝的更新（未初始化等）
+    std::uint64_t operationsIngested = 0;  // 累计接收的操作数
+    double operationsPerSecond = 0.0;      // 最近若干次更新的接收速率
+    double uptimeSeconds = 0.0;
+
+    const StageLatency& stage(UpdateStage s) const { return stages[static_cast<int>(s)]; }
+
+    /**
+     * @brief 以JSON格式写入文件
+     */
+    bool dumpToFile(const std::string& path) const;
+};
+
+// 更新流水线统计收集器（由调用方加锁保护）
+class UpdatePipelineStats {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    UpdatePipelineStats();
+
+    void recordStage(UpdateStage stage, Clock::time_point start, Clock::time_point end);
+    void recordUpdate(std::size_t operationCount, Clock::time_point start);
+    void recordDropped() { ++updatesDropped; }
+
+    /**
+     * @brief 帧显示后调用，完成“首帧时间”的记录
+     */
+    void recordFrameDisplayed(Clock::time_point displayed);
+
+    UpdateStatsSnapshot snapshot() const;
+    void reset();
+
+    static const char* stageName(UpdateStage stage);
+
+private:
+    static const int RATE_WINDOW = 64;
+
+    LatencyHistogram histograms[static_cast<int>(UpdateStage::Count)];
+    std::uint64_t updatesApplied = 0;
+    std::uint64_t updatesCoalesced = 0;
+    std::uint64_t updatesDropped = 0;
+    std::uint64_t operationsIngested = 0;
+
+    // 等待首帧的更新
+    bool awaitingFirstFrame = false;
+    Clock::time_point pendingUpdateStart;
+
+    // 最近 RATE_WINDOW 次更新的时间与操作数，用于计算速率
+    Clock::time_point rateTimes[RATE_WINDOW];
+    std::uint64_t rateCounts[RATE_WINDOW];
+    int rateNext = 0;
+    int rateSize = 0;
+
+    Clock::time_point created;
+};
+
+#endif // UPDATE_STATS_H
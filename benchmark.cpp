@@ -0,0 +1,251 @@
+﻿#include "GanttChart.h"
+#include "ScheduleGenerator.h"
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <iomanip>
+#include <algorithm>
+
+/**
+ * 甘特图库基准测试
+ * 按数据规模（1k ~ 10M 操作）、机器数和作业数扫描，测量：
+ *   loadOperationsFromCSV / update / calculateRanges / generateJobColors / hasOverlaps / draw（多个缩放级别）
+ * 结果写入 JSON 文件，便于不同构建之间对比
+ *
+ * 用法：benchmark [--max-ops N] [--csv-max-ops N] [--no-draw] [--output file.json] [--seed S] [--threads T]
+ */
+
+namespace {
+
+    using BenchClock = std::chrono::steady_clock;
+
+    struct BenchOptions {
+        long long maxOperations = 10000000;
+        long long csvMaxOperations = 1000000;  // CSV文件较大，默认只测到1M
+        bool enableDraw = true;
+        std::string outputPath = "benchmark_results.json";
+        unsigned seed = 12345;
+        int threads = 0;                       // 数据生成线程数，0 表示硬件线程数
+        double minSecondsPerCase = 0.5;
+        int minRepetitions = 3;
+    };
+
+    // 一个数据形状：机器数与每个作业的阶段数
+    struct ScheduleShape {
+        int machineCount;
+        int stagesPerJob;
+    };
+
+    struct BenchResult {
+        std::string name;
+        long long operations;
+        int machines;
+        int jobs;
+        float zoom;
+        int repetitions;
+        double minMs;
+        double meanMs;
+        double p50Ms;
+    };
+
+    // 重复执行直到达到最少次数和最短时长，返回每次的耗时
+    template<typename Fn>
+    std::vector<double> measure(const BenchOptions& options, Fn&& fn) {
+        std::vector<double> samples;
+        BenchClock::time_point begin = BenchClock::now();
+        do {
+            BenchClock::time_point start = BenchClock::now();
+            fn();
+            samples.push_back(std::chrono::duration<double, std::milli>(BenchClock::now() - start).count());
+        } while (static_cast<int>(samples.size()) < options.minRepetitions ||
+            std::chrono::duration<double>(BenchClock::now() - begin).count() < options.minSecondsPerCase);
+        return samples;
+    }
+
+    BenchResult summarize(const std::string& name, long long operations, const ScheduleShape& shape,
+        int jobs, float zoom, std::vector<double> samples) {
+        BenchResult result{ name, operations, shape.machineCount, jobs, zoom,
+            static_cast<int>(samples.size()), 0.0, 0.0, 0.0 };
+        std::sort(samples.begin(), samples.end());
+        result.minMs = samples.front();
+        result.p50Ms = samples[samples.size() / 2];
+        double sum = 0.0;
+        for (double s : samples) sum += s;
+        result.meanMs = sum / samples.size();
+
+        std::cout << std::left << std::setw(24) << name
+            << " ops=" << std::setw(9) << operations
+            << " machines=" << std::setw(5) << shape.machineCount
+            << " zoom=" << std::setw(4) << zoom
+            << " p50=" << std::fixed << std::setprecision(3) << result.p50Ms << "ms"
+            << " (" << result.repetitions << " reps)" << std::endl;
+        return result;
+    }
+
+    // 由 getStats() 的阶段直方图得到结果（阶段是私有方法，通过 update 统计获得）
+    BenchResult stageResult(const std::string& name, const UpdateStatsSnapshot& stats, UpdateStage stage,
+        long long operations, const ScheduleShape& shape, int jobs) {
+        const StageLatency& s = stats.stage(stage);
+        BenchResult result{ name, operations, shape.machineCount, jobs, 1.0f,
+            static_cast<int>(s.count), s.min / 1000.0, s.mean / 1000.0, s.p50 / 1000.0 };
+        std::cout << std::left << std::setw(24) << name
+            << " ops=" << std::setw(9) << operations
+            << " machines=" << std::setw(5) << shape.machineCount
+            << " p50=" << std::fixed << std::setprecision(3) << result.p50Ms << "ms" << std::endl;
+        return result;
+    }
+
+    void writeCSV(const std::string& path, const std::vector<qm::Operation>& operations) {
+        std::FILE* file = std::fopen(path.c_str(), "w");
+        if (!file) return;
+        std::fputs("ID,Job,Operation,Machine,StartTime,EndTime,IsCritical\n", file);
+        for (size_t i = 0; i < operations.size(); ++i) {
+            const auto& op = operations[i];
+            std::fprintf(file, "%zu,%d,%d,%d,%d,%d,%d\n", i + 1, op.job_id, op.stage, op.machine_id,
+                op.start_time, op.end_time, op.is_critical ? 1 : 0);
+        }
+        std::fclose(file);
+    }
+
+    bool writeJSON(const std::string& path, const std::vector<BenchResult>& results) {
+        std::FILE* file = std::fopen(path.c_str(), "w");
+        if (!file) return false;
+
+        std::fprintf(file, "{\n  \"compiler\": \"%s\",\n  \"build_date\": \"%s\",\n  \"results\": [\n",
+#if defined(__clang__)
+            "clang " __clang_version__,
+#elif defined(__GNUC__)
+            "gcc " __VERSION__,
+#elif defined(_MSC_VER)
+            "msvc",
+#else
+            "unknown",
+#endif
+            __DATE__ " " __TIME__);
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            const BenchResult& r = results[i];
+            std::fprintf(file, "    {\"name\": \"%s\", \"operations\": %lld, \"machines\": %d, \"jobs\": %d, "
+                "\"zoom\": %.2f, \"repetitions\": %d, \"min_ms\": %.4f, \"mean_ms\": %.4f, \"p50_ms\": %.4f}%s\n",
+                r.name.c_str(), r.operations, r.machines, r.jobs, r.zoom, r.repetitions,
+                r.minMs, r.meanMs, r.p50Ms, i + 1 < results.size() ? "," : "");
+        }
+
+        std::fprintf(file, "  ]\n}\n");
+        return std::fclose(file) == 0;
+    }
+
+    bool parseOptions(int argc, char** argv, BenchOptions& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--max-ops" && hasValue) options.maxOperations = std::atoll(argv[++i]);
+            else if (arg == "--csv-max-ops" && hasValue) options.csvMaxOperations = std::atoll(argv[++i]);
+            else if (arg == "--output" && hasValue) options.outputPath = argv[++i];
+            else if (arg == "--seed" && hasValue) options.seed = static_cast<unsigned>(std::atoll(argv[++i]));
+            else if (arg == "--threads" && hasValue) options.threads = std::atoi(argv[++i]);
+            else if (arg == "--min-seconds" && hasValue) options.minSecondsPerCase = std::atof(argv[++i]);
+            else if (arg == "--no-draw") options.enableDraw = false;
+            else {
+                std::cerr << "Usage: benchmark [--max-ops N] [--csv-max-ops N] [--no-draw] "
+                    "[--output file.json] [--seed S] [--threads T] [--min-seconds T]" << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    sf::err().rdbuf(nullptr);
+
+    // 绘制基准使用隐藏窗口
+    sf::RenderWindow window;
+    window.create(sf::VideoMode(GanttConfig::WindowConfig::DEFAULT_WINDOW_WIDTH,
+        GanttConfig::WindowConfig::DEFAULT_WINDOW_HEIGHT),
+        "Gantt Chart Benchmark", sf::Style::Default, getWindowContextSettings());
+    window.setVisible(false);
+    window.setFramerateLimit(0);
+    window.setVerticalSyncEnabled(false);
+
+    GanttChart gantt(window);
+    if (!gantt.init()) {
+        std::cerr << "Initialization failed" << std::endl;
+        return 1;
+    }
+
+    const ScheduleShape shapes[] = {
+        { 10, 5 },     // 少量机器、短作业
+        { 200, 10 },   // 中等车间
+        { 5000, 20 }   // 大量机器、长作业
+    };
+    // 后两个为深度缩放级别，applyViewConfig 按数据跨度限制在最大深度缩放以内
+    const float zoomLevels[] = { GanttConfig::ViewConfig::MIN_ZOOM_LEVEL, 1.0f, GanttConfig::ViewConfig::MAX_ZOOM_LEVEL,
+        1.0e3f, 1.0e6f };
+    const std::string csvPath = "benchmark_tmp.csv";
+
+    std::vector<BenchResult> results;
+
+    for (long long size = 1000; size <= options.maxOperations; size *= 10) {
+        for (const ScheduleShape& shape : shapes) {
+            const int jobs = static_cast<int>(std::max<long long>(1, size / shape.stagesPerJob));
+
+            // 阶段数在 stagesPerJob 上下浮动，机器负载倾斜
+            ScheduleGenConfig genConfig;
+            genConfig.jobCount = jobs;
+            genConfig.minStages = std::max(1, shape.stagesPerJob / 2);
+            genConfig.maxStages = shape.stagesPerJob + shape.stagesPerJob / 2;
+            genConfig.machineCount = shape.machineCount;
+            genConfig.seed = options.seed;
+            genConfig.threadCount = options.threads;
+            std::vector<qm::Operation> operations = generateSchedule(genConfig);
+            const long long count = static_cast<long long>(operations.size());
+
+            // CSV 读取
+            if (count <= options.csvMaxOperations) {
+                writeCSV(csvPath, operations);
+                results.push_back(summarize("loadOperationsFromCSV", count, shape, jobs, 1.0f,
+                    measure(options, [&]() { loadOperationsFromCSV(csvPath); })));
+                std::remove(csvPath.c_str());
+            }
+
+            // update 全流程，同时由阶段直方图得到 calculateRanges / generateJobColors
+            gantt.resetStats();
+            results.push_back(summarize("update", count, shape, jobs, 1.0f,
+                measure(options, [&]() { gantt.update(operations, false); })));
+
+            UpdateStatsSnapshot stats = gantt.getStats();
+            results.push_back(stageResult("calculateRanges", stats, UpdateStage::Ranges, count, shape, jobs));
+            results.push_back(stageResult("generateJobColors", stats, UpdateStage::Colors, count, shape, jobs));
+            results.push_back(stageResult("ingest", stats, UpdateStage::Ingest, count, shape, jobs));
+
+            results.push_back(summarize("hasOverlaps", count, shape, jobs, 1.0f,
+                measure(options, [&]() { gantt.hasOverlaps(); })));
+
+            // 不同缩放级别下的绘制
+            if (options.enableDraw) {
+                for (float zoom : zoomLevels) {
+                    gantt.resetView();
+                    gantt.applyViewConfig(zoom, GanttConfig::ViewConfig::PAN_SPEED);
+                    gantt.draw(); // 预热
+                    results.push_back(summarize("draw", count, shape, jobs, zoom,
+                        measure(options, [&]() { gantt.draw(); })));
+                }
+                gantt.resetView();
+            }
+        }
+    }
+
+    if (!writeJSON(options.outputPath, results)) {
+        std::cerr << "Could not write " << options.outputPath << std::endl;
+        return 1;
+    }
+    std::cout << "Results written to " << options.outputPath << std::endl;
+    return 0;
+}
@@ -1,4 +1,7 @@
 ﻿#include "GanttChart.h"
+#include "GanttGrid.h"
+#include "ScheduleGenerator.h"
+#include <cstdlib>
 #include <iostream>
 #include <thread>
 #include <chrono>
@@ -102,6 +105,25 @@ std::vector<qm::Operation> createSampleSchedule3() {
     return operations;
 }
 
+// 求解器自有的记录结构：没有工序号和关键标记，通过成员指针直接读取
+struct SolverTask {
+    int job;
+    int machine;
+    int start;
+    int end;
+};
+
+std::vector<qm::Operation> createSampleSchedule4() {
+    // 示例调度方案4：stage / is_critical 传 nullptr，读取为 0 / false
+    const SolverTask tasks[] = {
+        { 0, 0, 0, 40 }, { 1, 1, 10, 55 }, { 2, 2, 20, 60 },
+        { 0, 1, 60, 90 }, { 1, 2, 65, 100 }, { 2, 0, 70, 120 }
+    };
+    const auto view = GanttChart::View::fromMembers(tasks, sizeof(tasks) / sizeof(tasks[0]),
+        &SolverTask::job, nullptr, &SolverTask::machine, &SolverTask::start, &SolverTask::end, nullptr);
+    return std::vector<qm::Operation>(view.begin(), view.end());
+}
+
 // 创建示例CSV文件
 void createSampleCSV() {
     std::ofstream file("output.csv");
@@ -124,10 +146,185 @@ void createSampleCSV() {
     }
 }
 
-int main() {
+// 小图网格示例：模拟遗传算法种群，每0.5秒替换八分之一的个体，只有被替换的单元格重绘
+int runGridDemo(sf::RenderWindow& window, int cellCount) {
+    GanttGrid grid(window);
+    if (!grid.init()) {
+        std::cerr << "初始化失败!" << std::endl;
+        return -1;
+    }
+    grid.setCellCount(cellCount);
+
+    ScheduleGenConfig config;
+    config.jobCount = 200;
+    config.machineCount = 12;
+    std::vector<qm::Operation> individual;
+    for (int i = 0; i < cellCount; ++i) {
+        config.seed = 1000 + i;
+        generateSchedule(config, individual);
+        grid.updateCell(i, individual);
+    }
+    std::cout << "显示 " << cellCount << " 个调度，点击单元格输出其序号，ESC 退出" << std::endl;
+
+    sf::Clock generationClock;
+    std::uint64_t nextSeed = 1000 + cellCount;
+    int nextCell = 0;
+    while (window.isOpen()) {
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed ||
+                (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape)) {
+                window.close();
+            }
+            else if (event.type == sf::Event::MouseButtonPressed) {
+                int cell = grid.getCellAt(static_cast<float>(event.mouseButton.x), static_cast<float>(event.mouseButton.y));
+                if (cell >= 0) {
+                    std::cout << "单元格 #" << cell << std::endl;
+                }
+            }
+            grid.handleEvent(event);
+        }
+        if (!window.isOpen()) break;
+
+        if (generationClock.getElapsedTime().asSeconds() >= 0.5f) {
+            for (int k = 0; k < std::max(1, cellCount / 8); ++k) {
+                config.seed = nextSeed++;
+                generateSchedule(config, individual);
+                grid.updateCell(nextCell, individual);
+                nextCell = (nextCell + 1) % cellCount;
+            }
+            generationClock.restart();
+        }
+
+        // 没有变化时不提交新帧
+        if (!grid.draw()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+    return 0;
+}
+
+// 占用热力图示例：N 个候选调度的机器占用比例画在第一个调度之下，每0.5秒替换一个个体
+int runHeatmapDemo(sf::RenderWindow& window, int scheduleCount) {
+    GanttChart gantt(window);
+    if (!gantt.init()) {
+        std::cerr << "初始化失败!" << std::endl;
+        return -1;
+    }
+
+    ScheduleGenConfig config;
+    config.jobCount = 300;
+    config.machineCount = 15;
+    std::vector<std::vector<qm::Operation>> population(scheduleCount);
+    std::vector<GanttChart::View> views;
+    std::vector<int> machines;
+    int horizon = 0;
+    for (int i = 0; i < scheduleCount; ++i) {
+        config.seed = 2000 + i;
+        generateSchedule(config, population[i]);
+        views.push_back(GanttChart::View::fromRecords(population[i]));
+        for (const auto& op : population[i]) {
+            machines.push_back(op.machine_id);
+            horizon = std::max(horizon, op.end_time);
+        }
+    }
+
+    OccupancyHeatmap heatmap;
+    heatmap.configure(0, horizon, GanttConfig::HeatmapConfig::DEFAULT_BUCKETS, machines, scheduleCount);
+    heatmap.build(views);
+    gantt.update(population[0], false);
+    gantt.setOccupancyHeatmap(heatmap);
+    std::cout << "热力图显示 " << scheduleCount << " 个调度中各机器忙碌的比例，H 显示/隐藏，ESC 退出" << std::endl;
+
+    sf::Clock replaceClock;
+    std::uint64_t nextSeed = 2000 + scheduleCount;
+    int nextSlot = 0;
+    while (window.isOpen()) {
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed ||
+                (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape)) {
+                window.close();
+            }
+            gantt.handleEvent(event);
+        }
+        if (!window.isOpen()) break;
+
+        if (replaceClock.getElapsedTime().asSeconds() >= 0.5f) {
+            // 只减去被替换个体的旧贡献、加上新贡献
+            config.seed = nextSeed++;
+            generateSchedule(config, population[nextSlot]);
+            heatmap.setSchedule(nextSlot, GanttChart::View::fromRecords(population[nextSlot]));
+            if (nextSlot == 0) {
+                gantt.update(population[0], false);
+            }
+            gantt.setOccupancyHeatmap(heatmap);
+            nextSlot = (nextSlot + 1) % scheduleCount;
+            replaceClock.restart();
+        }
+
+        gantt.handleKeyboard();
+        gantt.draw();
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
     std::cout << "=== 甘特图库简单使用示例 ===" << std::endl;
     std::cout << "演示两个核心接口的使用方法" << std::endl;
 
+    // --listen <path>：改为显示本机套接字上求解器发送的调度（见 schedule_producer.cpp）
+    // --record <file>：把每次显示的调度追加到历史文件
+    // --replay <file>：回放历史文件
+    // --diff：切换调度方案时叠加与上一个方案的差异
+    // --grid <N>：以小图网格同时显示 N 个调度
+    // --heatmap <N>：显示 N 个调度的机器占用热力图
+    // --load：在时间轴下方显示全厂负载曲线
+    // --gaps：维护空闲区间索引并显示底纹，每次切换方案时查询一次首次适应
+    // --groups <file>：按旁路文件把机器分组，分组显示为可折叠的汇总行
+    std::string listenPath;
+    std::string groupsPath;
+    std::string recordPath;
+    std::string replayPath;
+    bool showDiff = false;
+    bool showLoad = false;
+    bool showGaps = false;
+    int gridCells = 0;
+    int heatmapSchedules = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--diff") {
+            showDiff = true;
+        }
+        else if (option == "--load") {
+            showLoad = true;
+        }
+        else if (option == "--gaps") {
+            showGaps = true;
+        }
+        else if (i + 1 >= argc) {
+            break;
+        }
+        else if (option == "--listen") {
+            listenPath = argv[++i];
+        }
+        else if (option == "--record") {
+            recordPath = argv[++i];
+        }
+        else if (option == "--replay") {
+            replayPath = argv[++i];
+        }
+        else if (option == "--grid") {
+            gridCells = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (option == "--heatmap") {
+            heatmapSchedules = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (option == "--groups") {
+            groupsPath = argv[++i];
+        }
+    }
+
     // 创建示例CSV文件（如果不存在）
     std::ifstream csvCheck("output.csv");
     if (!csvCheck.good()) {
@@ -171,6 +368,13 @@ int main() {
         return -1;
     }
 
+    if (gridCells > 0) {
+        return runGridDemo(window, gridCells);
+    }
+    if (heatmapSchedules > 0) {
+        return runHeatmapDemo(window, heatmapSchedules);
+    }
+
     // 创建甘特图对象
     GanttChart gantt(window);
 
@@ -181,12 +385,22 @@ int main() {
         return -1;
     }
     std::cout << "✓ 甘特图初始化成功" << std::endl;
+    if (showLoad) {
+        gantt.setLoadCurveVisible(true);
+    }
+    if (showGaps) {
+        gantt.setIdleGapsVisible(true);
+    }
+    if (!groupsPath.empty() && !gantt.loadMachineGroups(groupsPath)) {
+        std::cerr << "无法加载机器分组: " << groupsPath << std::endl;
+    }
 
     // 准备示例数据
     std::vector<std::vector<qm::Operation>> schedules = {
         createSampleSchedule1(),
         createSampleSchedule2(),
-        createSampleSchedule3()
+        createSampleSchedule3(),
+        createSampleSchedule4()
     };
 
     // 如果有CSV文件，也加入到示例中
@@ -201,8 +415,55 @@ int main() {
     std::cout << "  鼠标滚轮 - 缩放" << std::endl;
     std::cout << "  方向键/WASD - 平移" << std::endl;
     std::cout << "  空格键 - 重置视图" << std::endl;
+    std::cout << "  T - 显示/隐藏时间游标（在图表内按住左键拖动）" << std::endl;
     std::cout << "  ESC - 退出" << std::endl;
-    std::cout << "\n程序将自动切换显示不同的调度方案..." << std::endl;
+
+    ScheduleServer server;
+    if (!listenPath.empty()) {
+        if (!server.start(listenPath)) {
+            std::cerr << "无法监听 " << listenPath << std::endl;
+            return -1;
+        }
+        std::cout << "  Tab - 切换显示的客户端" << std::endl;
+        std::cout << "\n等待求解器连接 " << listenPath << " ..." << std::endl;
+    }
+    else if (replayPath.empty()) {
+        std::cout << "\n程序将自动切换显示不同的调度方案..." << std::endl;
+    }
+
+    ScheduleRecorder recorder;
+    if (!recordPath.empty()) {
+        if (!recorder.open(recordPath)) {
+            std::cerr << "无法创建历史文件 " << recordPath << std::endl;
+            return -1;
+        }
+        gantt.setRecorder(&recorder);
+        std::cout << "记录调度历史到 " << recordPath << std::endl;
+    }
+    if (!replayPath.empty()) {
+        if (!gantt.openReplay(replayPath)) {
+            std::cerr << "无法打开历史文件 " << replayPath << std::endl;
+            return -1;
+        }
+        std::cout << "  P - 播放/暂停，[ ] - 减速/加速，, . - 单步，点击或拖动底部进度条跳转" << std::endl;
+    }
+    else {
+        // 在内存中保留最近的调度，用于前后对比
+        gantt.enableHistory();
+        std::cout << "  , . - 在最近的调度间后退/前进，L - 回到最新" << std::endl;
+    }
+    if (showDiff) {
+        std::cout << "  V - 显示/隐藏差异叠加层" << std::endl;
+    }
+    if (showLoad) {
+        std::cout << "  U - 显示/隐藏负载曲线" << std::endl;
+    }
+    if (showGaps) {
+        std::cout << "  G - 显示/隐藏空闲区间底纹" << std::endl;
+    }
+    if (!groupsPath.empty()) {
+        std::cout << "  点击分组行 - 展开/折叠，= / - 全部展开/折叠" << std::endl;
+    }
 
     // 主循环 - 演示update接口的使用
     sf::Clock frameClock;
@@ -218,14 +479,32 @@ int main() {
         }
         frameClock.restart();
 
+        // 监听线程出错退出：释放服务器并回到演示模式
+        if (server.hasFailed() && !listenPath.empty()) {
+            std::cerr << "调度服务器出错，已停止监听: " << listenPath << std::endl;
+            server.stop();
+            listenPath.clear();
+        }
+
+        // 监听模式：取走显示客户端合并后的更新（完整快照或增量）
+        if (server.isRunning()) {
+            gantt.updateFromServer(server, false);
+        }
+        // 回放模式：按播放速度推进，或执行进度条/单步请求的跳转
+        else if (gantt.isReplaying()) {
+            gantt.updateReplay(false);
+        }
         // 每3秒切换一次调度方案，演示update接口
-        if (switchClock.getElapsedTime().asSeconds() >= 3.0f) {
+        else if (switchClock.getElapsedTime().asSeconds() >= 3.0f) {
             if (!schedules.empty()) {
                 // === 接口2：清空前一个显示，绘制当前显示 ===
                 std::cout << "\n调用 update() 接口，显示调度方案 " << (currentSchedule + 1)
                     << " (共" << schedules[currentSchedule].size() << "个操作)" << std::endl;
 
-                bool success = gantt.update(schedules[currentSchedule]);
+                // --diff：只把变化的操作作为增量应用，并标出与上一个方案的差异
+                bool success = showDiff && hasUpdated
+                    ? gantt.updateWithDiff(GanttChart::View::fromRecords(schedules[currentSchedule]))
+                    : gantt.update(schedules[currentSchedule]);
                 if (success) {
                     std::cout << "✓ 更新成功，甘特图已刷新" << std::endl;
 
@@ -238,6 +517,12 @@ int main() {
                     gantt.getMachineRange(minMachine, maxMachine);
                     std::cout << "  时间范围: " << minTime << " - " << maxTime << std::endl;
                     std::cout << "  机器范围: " << minMachine << " - " << maxMachine << std::endl;
+                    std::cout << "  时间中点正在进行的操作: " << gantt.operationsAt((minTime + maxTime) / 2).size() << std::endl;
+
+                    GanttChart::GapFit fit;
+                    if (showGaps && gantt.findFirstFit(10, minTime, maxTime, fit)) {
+                        std::cout << "  最早可插入长度 10 的空闲: M" << fit.machineId << " @" << fit.start << std::endl;
+                    }
                 }
                 else {
                     std::cout << "✗ 更新失败" << std::endl;
@@ -263,6 +548,9 @@ int main() {
                     window.close();
                     break;
                 }
+                if (event.key.code == sf::Keyboard::Tab && server.isRunning()) {
+                    std::cout << "切换到客户端 #" << server.cycleActiveClient() << std::endl;
+                }
             }
 
             // 将事件传递给甘特图处理
@@ -293,6 +581,9 @@ int main() {
         }
     }
 
+    gantt.setRecorder(nullptr);
+    recorder.close();
+
     std::cout << "\n=== 示例程序结束 ===" << std::endl;
     std::cout << "实际使用时，你只需要：" << std::endl;
     std::cout << "1. 调用 gantt.init() 一次进行初始化" << std::endl;
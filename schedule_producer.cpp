@@ -0,0 +1,162 @@
+﻿#include "ScheduleFrames.h"
+#include "ScheduleGenerator.h"
+#include <algorithm>
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+/**
+ * 本机套接字调度服务的替身生产者
+ * 连接查看器的监听路径，先发送一个完整调度，之后按比例发送增量帧或新的完整调度，
+ * 用于在本机测试帧解码、合并与反压（发送阻塞时间即查看器施加的反压）
+ *
+ * 用法：schedule_producer [--socket path] [--frames N] [--rate FPS] [--jobs N] [--machines N]
+ *                         [--delta-ratio R] [--changes N] [--seed S]
+ */
+
+namespace {
+
+    using ProducerClock = std::chrono::steady_clock;
+
+    struct ProducerOptions {
+        std::string socketPath = "/tmp/gantt.sock";
+        long long frames = 1000;        // 发送的帧数（不含第一个完整帧）
+        double rate = 60.0;             // 每秒帧数，0 表示不限速
+        int jobs = 1000;
+        int machines = 20;
+        double deltaRatio = 0.9;        // 增量帧的比例，其余为新的完整调度
+        int changes = 100;              // 每个增量帧修改的操作数
+        unsigned seed = 12345;
+    };
+
+    bool parseOptions(int argc, char** argv, ProducerOptions& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--socket" && hasValue) options.socketPath = argv[++i];
+            else if (arg == "--frames" && hasValue) options.frames = std::atoll(argv[++i]);
+            else if (arg == "--rate" && hasValue) options.rate = std::atof(argv[++i]);
+            else if (arg == "--jobs" && hasValue) options.jobs = std::atoi(argv[++i]);
+            else if (arg == "--machines" && hasValue) options.machines = std::atoi(argv[++i]);
+            else if (arg == "--delta-ratio" && hasValue) options.deltaRatio = std::atof(argv[++i]);
+            else if (arg == "--changes" && hasValue) options.changes = std::atoi(argv[++i]);
+            else if (arg == "--seed" && hasValue) options.seed = static_cast<unsigned>(std::atoll(argv[++i]));
+            else {
+                std::cerr << "Usage: schedule_producer [--socket path] [--frames N] [--rate FPS] [--jobs N] "
+                    << "[--machines N] [--delta-ratio R] [--changes N] [--seed S]" << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 生成一个增量：大部分是平移已有操作，少量删除后重新加入，模拟求解器的局部改进
+    void makeDelta(std::vector<qm::Operation>& schedule, std::vector<qm::Operation>& removed, int changes,
+        std::mt19937& rng, qm::ScheduleDelta& delta) {
+        delta.clear();
+        if (schedule.empty()) return;
+        std::uniform_int_distribution<size_t> pick(0, schedule.size() - 1);
+        std::uniform_int_distribution<int> shift(-20, 20);
+        std::uniform_int_distribution<int> action(0, 99);
+
+        for (int c = 0; c < changes; ++c) {
+            const int kind = action(rng);
+            if (kind < 5 && schedule.size() > 1) {
+                // 删除：与最后一个交换后移除，保存起来以便之后重新加入
+                const size_t index = pick(rng) % schedule.size();
+                const qm::Operation& victim = schedule[index];
+                removed.push_back(victim);
+                delta.removals.push_back({ victim.job_id, victim.stage });
+                // 查看器先应用删除再应用新增，本增量中该键之前的新增必须一并去掉，否则会被加回
+                delta.upserts.erase(std::remove_if(delta.upserts.begin(), delta.upserts.end(),
+                    [&](const qm::Operation& op) { return op.job_id == victim.job_id && op.stage == victim.stage; }),
+                    delta.upserts.end());
+                schedule[index] = schedule.back();
+                schedule.pop_back();
+            }
+            else if (kind < 10 && !removed.empty()) {
+                schedule.push_back(removed.back());
+                removed.pop_back();
+                delta.upserts.push_back(schedule.back());
+            }
+            else {
+                qm::Operation& op = schedule[pick(rng) % schedule.size()];
+                const int offset = shift(rng);
+                op.start_time = std::max(0, op.start_time + offset);
+                op.end_time = std::max(op.start_time + 1, op.end_time + offset);
+                op.is_critical = action(rng) < 25;
+                delta.upserts.push_back(op);
+            }
+        }
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    ProducerOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    qm::ScheduleFrameClient client;
+    // 查看器可能稍后启动，重试几秒
+    for (int attempt = 0; !client.connect(options.socketPath); ++attempt) {
+        if (attempt >= 50) {
+            std::cerr << "Could not connect to " << options.socketPath << std::endl;
+            return 1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    ScheduleGenConfig genConfig;
+    genConfig.jobCount = options.jobs;
+    genConfig.machineCount = options.machines;
+    genConfig.seed = options.seed;
+
+    std::vector<qm::Operation> schedule = generateSchedule(genConfig);
+    std::vector<qm::Operation> removed;
+    qm::ScheduleDelta delta;
+    std::mt19937 rng(options.seed);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+
+    const ProducerClock::time_point begin = ProducerClock::now();
+    double blockedSeconds = 0.0;
+    long long fullFrames = 0;
+    long long deltaFrames = 0;
+
+    for (long long frame = 0; frame <= options.frames; ++frame) {
+        bool isFull = frame == 0 || coin(rng) >= options.deltaRatio;
+        if (isFull && frame > 0) {
+            genConfig.seed += 1;
+            generateSchedule(genConfig, schedule);
+            removed.clear();
+        }
+        else if (!isFull) {
+            makeDelta(schedule, removed, options.changes, rng, delta);
+        }
+
+        const ProducerClock::time_point sendStart = ProducerClock::now();
+        const bool sent = isFull ? client.sendFull(schedule) : client.sendDelta(delta);
+        blockedSeconds += std::chrono::duration<double>(ProducerClock::now() - sendStart).count();
+        if (!sent) {
+            std::cerr << "Viewer closed the connection after " << frame << " frames" << std::endl;
+            break;
+        }
+        (isFull ? fullFrames : deltaFrames)++;
+
+        if (options.rate > 0.0) {
+            std::this_thread::sleep_until(begin + std::chrono::duration_cast<ProducerClock::duration>(
+                std::chrono::duration<double>((frame + 1) / options.rate)));
+        }
+    }
+
+    const double elapsed = std::chrono::duration<double>(ProducerClock::now() - begin).count();
+    const double megabytes = client.getBytesSent() / (1024.0 * 1024.0);
+    std::printf("sent %lld full + %lld delta frames, %.2f MB in %.2f s (%.2f MB/s, %.1f frames/s), blocked %.2f s\n",
+        fullFrames, deltaFrames, megabytes, elapsed, elapsed > 0 ? megabytes / elapsed : 0.0,
+        elapsed > 0 ? client.getFramesSent() / elapsed : 0.0, blockedSeconds);
+    return 0;
+}